@@ -3,11 +3,15 @@
 #include "Global.h"
 
 #include "AnimationSystem.h"
+#include "TransformComponent.h"
 
 using namespace Engine;
 
 AnimationSystem::AnimationSystem()
 {
+    // Animation callbacks drive the transforms of their entities.
+    DeclareWrite<TransformComponent>();
+    DeclareFixedStep();
 }
 
 AnimationSystem::~AnimationSystem()
@@ -24,16 +28,11 @@ void AnimationSystem::Shutdown()
 
 void AnimationSystem::Tick(float elapsedTime)
 {
-    for(auto& pEntity : m_pEntityList)
-    {
-        auto pAnimationComponent = pEntity->GetComponent<AnimationComponent>();
-        assert(pAnimationComponent != nullptr);
-        pAnimationComponent->Apply(elapsedTime);
-    }
+    m_query.ForEach([&](AnimationComponent& animationComponent) {
+        animationComponent.Apply(elapsedTime);
+    });
 }
 
-void AnimationSystem::FlushEntity(IEntity* pEntity)
+void AnimationSystem::FlushEntity(Entity)
 {
-    if (pEntity->HasComponent<AnimationComponent>())
-        m_pEntityList.emplace_back(pEntity);
 }
\ No newline at end of file
@@ -19,11 +19,9 @@ namespace Engine
         void Initialize() override;
         void Shutdown() override;
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "AnimationSystem"; }
 
-        void FlushEntity(IEntity* pEntity) override;
-
-    private:
-        std::vector<IEntity*> m_pEntityList;
+        void FlushEntity(Entity entity) override;
 
     public:
         static std::vector<AnimationFunc> s_cbTables;
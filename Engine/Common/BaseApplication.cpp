@@ -4,6 +4,7 @@
 
 #include "Global.h"
 #include "IECSWorld.h"
+#include "IEventSystem.h"
 
 #include "ECSWorld.h"
 
@@ -16,9 +17,14 @@ bool BaseApplication::m_bQuit = false;
 void BaseApplication::Initialize()
 {
     m_pWorld = gpGlobal->GetECSWorld();
+    m_endOfFramePhase = gpGlobal->GetFrameStats().RegisterPhase("EndOfFrameEvents");
 
     if (m_pWorld)
+    {
+        auto& timeConfig = gpGlobal->GetConfiguration<TimeConfiguration>();
+        m_pWorld->SetFixedStep(timeConfig.GetFixedStep(), timeConfig.GetMaxFixedSteps());
         m_pWorld->Initialize();
+    }
 }
 
 void BaseApplication::Shutdown()
@@ -31,6 +37,13 @@ void BaseApplication::Tick(float elapsedTime)
 {
     if (m_pWorld)
         m_pWorld->Tick(elapsedTime);
+
+    auto pEventSystem = gpGlobal->Get<IEventSystem>();
+    if (pEventSystem)
+    {
+        FrameStats::ScopedPhase phase(&gpGlobal->GetFrameStats(), m_endOfFramePhase);
+        pEventSystem->ProcessEndOfFrame();
+    }
 }
 
 bool BaseApplication::IsQuit() const
@@ -18,7 +18,7 @@ namespace Engine
     class BaseApplication : public IApplication
     {
     public:
-        BaseApplication() {}
+        BaseApplication() : m_endOfFramePhase(0) {}
         virtual ~BaseApplication() {}
 
         void Initialize() override;
@@ -31,5 +31,6 @@ namespace Engine
     protected:
         static bool m_bQuit;
         std::shared_ptr<IECSWorld> m_pWorld;
+        uint32_t m_endOfFramePhase;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FramePacer.h"
+
 namespace Engine
 {
     enum EConfigurationDeviceType
@@ -45,6 +47,8 @@ public:                                                                 \
         GraphicsConfiguration() = default;
         DECLEAR_CONFIGURATION_ITEM(DeviceType, EConfigurationDeviceType, eDevice_D3D11)
         DECLEAR_CONFIGURATION_ITEM(MSAA, EConfigurationMSAAType, eMSAA_Disable)
+        // Draws frame N on its own thread while frame N+1 is simulated.
+        DECLEAR_CONFIGURATION_ITEM(RenderThread, bool, true)
     };
 
     class DebugConfiguration
@@ -55,6 +59,30 @@ public:                                                                 \
         DECLEAR_CONFIGURATION_ITEM(Height, uint32_t, 200)
     };
 
+    // Times in milliseconds. Simulation runs in fixed steps, the loop itself is paced to the
+    // target frame rate, 0 leaves it unlimited.
+    class TimeConfiguration
+    {
+    public:
+        TimeConfiguration() = default;
+        DECLEAR_CONFIGURATION_ITEM(FixedStep, float, 1000.0f / 60.0f)
+        DECLEAR_CONFIGURATION_ITEM(MaxFixedSteps, uint32_t, 5)
+        DECLEAR_CONFIGURATION_ITEM(TargetFrameRate, uint32_t, 0)
+        DECLEAR_CONFIGURATION_ITEM(FramePacing, EFramePacing, ePacing_Sleep)
+    };
+
+    // Runs without a window for load testing. A frame count of 0 runs until quit, a frame
+    // time of 0 ticks on wall-clock time instead of a fixed synthetic one.
+    class HeadlessConfiguration
+    {
+    public:
+        HeadlessConfiguration() = default;
+        DECLEAR_CONFIGURATION_ITEM(FrameCount, uint32_t, 600)
+        DECLEAR_CONFIGURATION_ITEM(FrameTime, float, 1000.0f / 60.0f)
+        DECLEAR_CONFIGURATION_ITEM(InputEventsPerFrame, uint32_t, 4)
+        DECLEAR_CONFIGURATION_ITEM(InputSeed, uint32_t, 1)
+    };
+
     class Configuration
     {
     public:
@@ -67,12 +95,14 @@ public:                                                                 \
         AppConfiguration mAppConfig;
         GraphicsConfiguration mGraphicsConfig;
         DebugConfiguration mDebugConfig;
+        TimeConfiguration mTimeConfig;
+        HeadlessConfiguration mHeadlessConfig;
     };
 
     template<typename T>
     inline T& Configuration::GetConfiguration()
     {
-        static_assert(false);
+        static_assert(sizeof(T) == 0, "Unknown configuration type");
     }
 
     template<>
@@ -92,4 +122,16 @@ public:                                                                 \
     {
         return mDebugConfig;
     }
+
+    template<>
+    inline TimeConfiguration& Configuration::GetConfiguration<TimeConfiguration>()
+    {
+        return mTimeConfig;
+    }
+
+    template<>
+    inline HeadlessConfiguration& Configuration::GetConfiguration<HeadlessConfiguration>()
+    {
+        return mHeadlessConfig;
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <fstream>
 
 #include "Global.h"
+#include "ISceneSystem.h"
 #include "CameraComponent.h"
 #include "LightComponent.h"
 #include "TransformComponent.h"
@@ -23,8 +24,19 @@ DrawingSystem::DrawingSystem() : m_window(nullptr),
     m_pContext(nullptr),
     m_pEffectPool(nullptr),
     m_pResourceFactory(nullptr),
-    m_pResourceTable(nullptr)
-{
+    m_pResourceTable(nullptr),
+    m_renderableVersion(0),
+    m_frame(0),
+    m_bRenderThread(gpGlobal->GetConfiguration<GraphicsConfiguration>().GetRenderThread()),
+    m_bQuitRender(false),
+    m_pRenderSnapshot(nullptr),
+    m_pRenderCamera(nullptr),
+    m_materialVersion(0)
+{
+    DeclareRead<CameraComponent>();
+    DeclareRead<LightComponent>();
+    DeclareWrite<FrameGraphComponent>();
+    DeclareMainThread();
 }
 
 DrawingSystem::~DrawingSystem()
@@ -33,53 +45,67 @@ DrawingSystem::~DrawingSystem()
 
 void DrawingSystem::Initialize()
 {
+    m_cameraQuery = m_pWorld->Query<const FrameGraphComponent, const CameraComponent, const TransformComponent>();
+    m_lightQuery = m_pWorld->Query<const LightComponent, const TransformComponent>();
+    m_meshQuery = m_pWorld->Query<const MeshFilterComponent, const MeshRendererComponent>();
+
     if (!EstablishConfiguration())
         return;
+
+    if (m_bRenderThread)
+        StartRenderThread();
 }
 
 void DrawingSystem::Shutdown()
 {
+    StopRenderThread();
 }
 
-void DrawingSystem::Tick(float elapsedTime)
+void DrawingSystem::Tick(float)
 {
-    for (auto& pCamera : m_pCameraList)
-    {
-        auto pFrameGraphComponent = pCamera->GetComponent<FrameGraphComponent>();
-        if (pFrameGraphComponent == nullptr)
-            continue;
-
-        auto pFrameGraph = pFrameGraphComponent->GetFrameGraph();
-        if (pFrameGraph == nullptr)
-            continue;
+    ExtractSnapshot(m_snapshots.GetBack());
 
-        pFrameGraph->EnqueuePasses();
+    if (!m_bRenderThread)
+    {
+        m_snapshots.Publish();
+        m_snapshots.Acquire();
+        RenderFrame(m_snapshots.GetFront());
+        return;
     }
 
-    m_pDevice->Present(m_pContext->GetSwapChain(), 0);
+    // Never waits for the render thread, a snapshot it has not picked up yet is replaced.
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_snapshots.Publish();
+    }
+    m_snapshotCondition.notify_one();
 }
 
-void DrawingSystem::FlushEntity(IEntity* pEntity)
+void DrawingSystem::FlushEntity(Entity entity)
 {
-    if (pEntity->HasComponent<CameraComponent>() && pEntity->HasComponent<TransformComponent>())
+    // The component is attached here, the passes and textures are created by the render
+    // thread before it draws the next snapshot.
+    if (m_pWorld->HasComponent<CameraComponent>(entity) && m_pWorld->HasComponent<TransformComponent>(entity))
     {
-        m_pCameraList.emplace_back(pEntity);
-        BuildFrameGraph(pEntity);
-    }
+        std::shared_ptr<FrameGraph> pFrameGraph = std::make_shared<FrameGraph>();
 
-    if (pEntity->HasComponent<LightComponent>() && pEntity->HasComponent<TransformComponent>())
-        m_pLightList.emplace_back(pEntity);
+        FrameGraphComponent frameGraphComponent;
+        frameGraphComponent.SetFrameGraph(pFrameGraph);
+        m_pWorld->AttachComponent<FrameGraphComponent>(entity, frameGraphComponent);
 
-    if (pEntity->HasComponent<MeshFilterComponent>() && pEntity->HasComponent<TransformComponent>())
+        auto rendererType = m_pWorld->GetComponent<const CameraComponent>(entity)->GetRendererType();
+
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingFrameGraphs.push_back({ pFrameGraph, rendererType });
+    }
+
+    auto pComponent = m_pWorld->GetComponent<const MeshRendererComponent>(entity);
+    if (pComponent != nullptr)
     {
-        m_pMeshList.emplace_back(pEntity);
-        auto pComponent = pEntity->GetComponent<MeshRendererComponent>();
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
         auto size = pComponent->GetMaterialSize();
         for (uint32_t i = 0; i < size; i++)
-        {
-            auto pMaterial = pComponent->GetMaterial(i);
-            FlushMaterial(pMaterial.get());
-        }
+            m_pendingMaterials.push_back(pComponent->GetMaterial(i));
     }
 }
 
@@ -169,7 +195,7 @@ bool DrawingSystem::RegisterRenderer()
 {
     for (uint32_t type = eRenderer_Start; type != eRenderer_End; type++)
     {
-        auto& pRenderer = gpGlobal->GetRenderer((ERendererType)type);
+        auto pRenderer = gpGlobal->GetRenderer((ERendererType)type);
         if (pRenderer != nullptr)
         {
             pRenderer->AttachDevice(m_pDevice, m_pContext);
@@ -290,26 +316,18 @@ void DrawingSystem::FlushStandardMaterial(StandardMaterial* pMaterial)
     }
 }
 
-void DrawingSystem::BuildFrameGraph(IEntity* pCamera)
+void DrawingSystem::BuildFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, ERendererType rendererType)
 {
-    std::shared_ptr<FrameGraph> pFrameGraph = std::make_shared<FrameGraph>();
-
-    FrameGraphComponent frameGraphComponent;
-    frameGraphComponent.SetFrameGraph(pFrameGraph);
-    pCamera->AttachComponent<FrameGraphComponent>(frameGraphComponent);
+    if (rendererType == eRenderer_Forward)
+        BuildForwardFrameGraph(pFrameGraph);
 
-    auto pCameraComponent = pCamera->GetComponent<CameraComponent>();
-
-    if (pCameraComponent->GetRendererType() == eRenderer_Forward)
-        BuildForwardFrameGraph(pFrameGraph, pCamera);
-
-    else if (pCameraComponent->GetRendererType() == eRenderer_Deferred)
-        BuildDeferredFrameGraph(pFrameGraph, pCamera);
+    else if (rendererType == eRenderer_Deferred)
+        BuildDeferredFrameGraph(pFrameGraph);
 
     pFrameGraph->InitializePasses();
 }
 
-bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, IEntity* pCamera)
+bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph)
 {
     auto& pRenderer = std::dynamic_pointer_cast<ForwardRenderer>(gpGlobal->GetRenderer(eRenderer_Forward));
     if (pRenderer == nullptr)
@@ -317,9 +335,8 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
 
     pRenderer->CreateDataResources(*m_pResourceTable);
 
-    auto pCameraComponent = pCamera->GetComponent<CameraComponent>();
-    auto pTransformComponent = pCamera->GetComponent<TransformComponent>();
-    assert(pCameraComponent != nullptr && pTransformComponent != nullptr);
+    // Passes run on the render thread and read the camera being drawn from the snapshot,
+    // never from the world.
 
     // Depth pass.
     auto pDepthPass = pRenderer->GetPass(ForwardRenderer::DepthPass());
@@ -333,14 +350,11 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
         flag = eClear_Depth;
     });
 
-    depthPassNode.SetExecuteFunc([&, pCameraComponent, pTransformComponent, pRenderer, pDepthPass](void) -> void {
-        float4x4 view;
-        float4x4 proj;
-        GetProjectionMatrix(pCameraComponent, proj);
-        GetViewMatrix(pTransformComponent, view);
+    depthPassNode.SetExecuteFunc([&, pRenderer, pDepthPass](void) -> void {
+        auto pCamera = m_pRenderCamera;
 
         m_pContext->SetViewport(Box2(float2(0, 0), float2((float)gpGlobal->GetConfiguration<AppConfiguration>().GetWidth(), (float)gpGlobal->GetConfiguration<AppConfiguration>().GetHeight())));
-        m_pContext->UpdateCamera(*m_pResourceTable, proj, view);
+        m_pContext->UpdateCamera(*m_pResourceTable, pCamera->proj, pCamera->view);
         m_pContext->UpdateContext(*m_pResourceTable);
 
         RenderQueueItemListType items;
@@ -366,18 +380,13 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
     });
 
     shadowPassNode.SetExecuteFunc([&, pRenderer, pShadowPass](void) -> void {
-        auto pLight = m_pLightList.front();
-        if (pLight == nullptr)
+        if (!m_pRenderSnapshot->bMainLight)
             return;
 
-        auto pLightTransformComponent = pLight->GetComponent<TransformComponent>();
-
-        float4x4 lightView;
-        float4x4 lightProj;
-        GetLightViewProjectionMatrix(pLightTransformComponent, lightView, lightProj);
+        auto& light = m_pRenderSnapshot->mainLight;
 
         m_pContext->SetViewport(Box2(float2(0, 0), float2((float)gpGlobal->GetConfiguration<AppConfiguration>().GetWidth(), (float)gpGlobal->GetConfiguration<AppConfiguration>().GetHeight())));
-        m_pContext->UpdateCamera(*m_pResourceTable, lightProj, lightView);
+        m_pContext->UpdateCamera(*m_pResourceTable, light.proj, light.view);
         m_pContext->UpdateContext(*m_pResourceTable);
 
         RenderQueueItemListType items;
@@ -398,29 +407,20 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
         color = float4(1.0f, 1.0f, 1.0f, 1.0f);
     });
 
-    sssNode.SetExecuteFunc([&, pCameraComponent, pTransformComponent, pRenderer, pSSSPass](void) -> void {
-        auto pLight = m_pLightList.front();
-        if (pLight == nullptr)
+    sssNode.SetExecuteFunc([&, pRenderer, pSSSPass](void) -> void {
+        if (!m_pRenderSnapshot->bMainLight)
             return;
 
-        auto pLightTransformComponent = pLight->GetComponent<TransformComponent>();
-
-        float4x4 view;
-        float4x4 proj;
-        GetProjectionMatrix(pCameraComponent, proj);
-        GetViewMatrix(pTransformComponent, view);
+        auto pCamera = m_pRenderCamera;
+        auto& light = m_pRenderSnapshot->mainLight;
 
         m_pContext->SetViewport(Box2(float2(0, 0), float2((float)gpGlobal->GetConfiguration<AppConfiguration>().GetWidth(), (float)gpGlobal->GetConfiguration<AppConfiguration>().GetHeight())));
-        m_pContext->UpdateCamera(*m_pResourceTable, proj, view);
+        m_pContext->UpdateCamera(*m_pResourceTable, pCamera->proj, pCamera->view);
         m_pContext->UpdateContext(*m_pResourceTable);
 
-        float4x4 lightView;
-        float4x4 lightProj;
-        float3 lightDir;
-        GetLightViewProjectionMatrix(pLightTransformComponent, lightView, lightProj, lightDir);
-        UpdateLightDir(lightDir);
-        UpdateLightViewMatrix(lightView);
-        UpdateLightProjMatrix(lightProj);
+        UpdateLightDir(light.dir);
+        UpdateLightViewMatrix(light.view);
+        UpdateLightProjMatrix(light.proj);
 
         RenderQueueItemListType items;
         GetVisableRenderable(items);
@@ -437,34 +437,22 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
     assert(pForwardShadingPass != nullptr);
     auto& forwardShadingNode = pFrameGraph->AddPass(pForwardShadingPass, GraphicsBit);
 
-    forwardShadingNode.SetClearColorFunc(0, [&, pCameraComponent](float4& color) -> void {
-        color = pCameraComponent->GetBackground();
+    forwardShadingNode.SetClearColorFunc(0, [&](float4& color) -> void {
+        color = m_pRenderCamera->background;
     });
 
-    forwardShadingNode.SetExecuteFunc([&, pCameraComponent, pTransformComponent, pRenderer, pForwardShadingPass](void) -> void {
-        auto pLight = m_pLightList.front();
-        if (pLight == nullptr)
+    forwardShadingNode.SetExecuteFunc([&, pRenderer, pForwardShadingPass](void) -> void {
+        if (!m_pRenderSnapshot->bMainLight)
             return;
 
-        auto pLightTransformComponent = pLight->GetComponent<TransformComponent>();
-
-        float4x4 view;
-        float4x4 proj;
-        float3 dir;
-        GetProjectionMatrix(pCameraComponent, proj);
-        GetViewMatrix(pTransformComponent, view, dir);
+        auto pCamera = m_pRenderCamera;
 
         m_pContext->SetViewport(Box2(float2(0, 0), float2((float)gpGlobal->GetConfiguration<AppConfiguration>().GetWidth(), (float)gpGlobal->GetConfiguration<AppConfiguration>().GetHeight())));
-        m_pContext->UpdateCamera(*m_pResourceTable, proj, view);
+        m_pContext->UpdateCamera(*m_pResourceTable, pCamera->proj, pCamera->view);
         m_pContext->UpdateContext(*m_pResourceTable);
 
-        UpdateCameraDir(dir);
-
-        float4x4 lightView;
-        float4x4 lightProj;
-        float3 lightDir;
-        GetLightViewProjectionMatrix(pLightTransformComponent, lightView, lightProj, lightDir);
-        UpdateLightDir(lightDir);
+        UpdateCameraDir(pCamera->dir);
+        UpdateLightDir(m_pRenderSnapshot->mainLight.dir);
 
         RenderQueueItemListType items;
         GetVisableRenderable(items);
@@ -502,7 +490,7 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
     });
 
     debugLayerNode.SetNeedExecuteFunc([&](void) -> bool {
-        return m_bDebug;
+        return m_pRenderSnapshot->bDebug;
     });
 
     debugLayerNode.SetExecuteFunc([&, pRenderer, pDebugLayerPass](void) -> void {
@@ -535,24 +523,182 @@ bool DrawingSystem::BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGra
     return true;
 }
 
-bool DrawingSystem::BuildDeferredFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, IEntity* pCamera)
+bool DrawingSystem::BuildDeferredFrameGraph(std::shared_ptr<FrameGraph>)
 {
     return true;
 }
 
-void DrawingSystem::GetVisableRenderable(RenderQueueItemListType& items)
+void DrawingSystem::StartRenderThread()
+{
+    m_bQuitRender = false;
+    m_renderThread = std::thread(&DrawingSystem::RenderThreadMain, this);
+}
+
+void DrawingSystem::StopRenderThread()
+{
+    if (!m_renderThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_bQuitRender = true;
+    }
+    m_snapshotCondition.notify_one();
+    m_renderThread.join();
+}
+
+void DrawingSystem::RenderThreadMain()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_snapshotMutex);
+            m_snapshotCondition.wait(lock, [this] { return m_bQuitRender || m_snapshots.HasPublished(); });
+            if (m_bQuitRender)
+                break;
+        }
+
+        m_snapshots.Acquire();
+        RenderFrame(m_snapshots.GetFront());
+    }
+}
+
+void DrawingSystem::ExtractSnapshot(RenderSnapshot& snapshot)
+{
+    auto pSceneSystem = gpGlobal->Get<ISceneSystem>();
+    assert(pSceneSystem != nullptr);
+
+    snapshot.frame = m_frame++;
+    snapshot.bDebug = m_bDebug;
+
+    // Views come from the same blended world matrices as the renderables, parents included.
+    snapshot.cameras.clear();
+    m_cameraQuery.ForEachEntity([&](Entity entity, const FrameGraphComponent& frameGraph, const CameraComponent& camera, const TransformComponent&) {
+        auto pFrameGraph = frameGraph.GetFrameGraph();
+        auto pWorldMatrix = pSceneSystem->GetWorldMatrix(entity);
+        if (pFrameGraph == nullptr || pWorldMatrix == nullptr)
+            return;
+
+        RenderCameraSnapshot cameraSnapshot;
+        cameraSnapshot.pFrameGraph = pFrameGraph;
+        GetProjectionMatrix(&camera, cameraSnapshot.proj);
+        GetViewMatrix(*pWorldMatrix, cameraSnapshot.view, cameraSnapshot.dir);
+        cameraSnapshot.background = camera.GetBackground();
+        snapshot.cameras.push_back(cameraSnapshot);
+    });
+
+    auto pLightWorldMatrix = pSceneSystem->GetWorldMatrix(GetMainLight());
+    snapshot.bMainLight = pLightWorldMatrix != nullptr;
+    if (snapshot.bMainLight)
+        GetLightViewProjectionMatrix(*pLightWorldMatrix, snapshot.mainLight.view, snapshot.mainLight.proj, snapshot.mainLight.dir);
+
+    ExtractRenderables(snapshot);
+}
+
+void DrawingSystem::ExtractRenderables(RenderSnapshot& snapshot)
 {
-    for (auto& pEntity : m_pMeshList)
+    auto pSceneSystem = gpGlobal->Get<ISceneSystem>();
+    assert(pSceneSystem != nullptr);
+
+    // World matrices are read in place from the scene hierarchy, so the gathered pointers
+    // stay valid until the layout changes.
+    auto version = m_renderableVersion;
+    if (m_query.HasStructureChanged(version) || m_meshQuery.HasChanged(version) || pSceneSystem->GetLayoutVersion() >= version)
+    {
+        m_renderableVersion = IECSWorld::AdvanceGlobalVersion();
+        m_pWorldMatrices.clear();
+        m_pMeshes.clear();
+        m_pMaterials.clear();
+
+        m_query.ForEachEntity([&](Entity entity, const TransformComponent&, const MeshFilterComponent& meshFilter, const MeshRendererComponent& meshRenderer) {
+            auto pWorldMatrix = pSceneSystem->GetWorldMatrix(entity);
+            if (pWorldMatrix == nullptr)
+                return;
+
+            m_pWorldMatrices.push_back(pWorldMatrix);
+            m_pMeshes.push_back(meshFilter.GetMesh());
+            m_pMaterials.push_back(meshRenderer.GetMaterial(0));
+        });
+    }
+
+    // Each of the three snapshots catches up with the lists once, after that only the
+    // matrices are copied.
+    auto count = m_pWorldMatrices.size();
+    if (snapshot.renderableVersion != m_renderableVersion)
     {
-        auto pTrans = pEntity->GetComponent<TransformComponent>();
-        auto pMeshFilter = pEntity->GetComponent<MeshFilterComponent>();
-        auto pMeshRenderer = pEntity->GetComponent<MeshRendererComponent>();
+        snapshot.renderableVersion = m_renderableVersion;
+        snapshot.meshes = m_pMeshes;
+        snapshot.materials = m_pMaterials;
+        snapshot.worldMatrices.resize(count);
+
+        snapshot.renderables.clear();
+        for (size_t i = 0; i < count; i++)
+            snapshot.renderables.push_back(RenderQueueItem{ dynamic_cast<IRenderable*>(m_pMeshes[i].get()), &snapshot.worldMatrices[i] });
+    }
 
-        items.push_back(RenderQueueItem{ dynamic_cast<IRenderable*>(pMeshFilter->GetMesh().get()), pTrans});
+    for (size_t i = 0; i < count; i++)
+        snapshot.worldMatrices[i] = *m_pWorldMatrices[i];
+}
 
-        auto pMaterial = pMeshRenderer->GetMaterial(0).get();
-        UpdateMaterial(pMaterial);
+void DrawingSystem::FlushPending()
+{
+    std::vector<PendingFrameGraph> pendingFrameGraphs;
+    std::vector<std::shared_ptr<IMaterial>> pendingMaterials;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        if (m_pendingFrameGraphs.empty() && m_pendingMaterials.empty())
+            return;
+
+        pendingFrameGraphs.swap(m_pendingFrameGraphs);
+        pendingMaterials.swap(m_pendingMaterials);
     }
+
+    for (auto& pending : pendingFrameGraphs)
+        BuildFrameGraph(pending.pFrameGraph, pending.rendererType);
+
+    for (auto& pMaterial : pendingMaterials)
+        FlushMaterial(pMaterial.get());
+}
+
+void DrawingSystem::RenderFrame(const RenderSnapshot& snapshot)
+{
+    // Anything flushed before this snapshot was published is queued by now.
+    FlushPending();
+
+    m_pRenderSnapshot = &snapshot;
+
+    if (m_materialVersion != snapshot.renderableVersion)
+    {
+        m_materialVersion = snapshot.renderableVersion;
+        for (auto& pMaterial : snapshot.materials)
+            UpdateMaterial(pMaterial.get());
+    }
+
+    for (auto& camera : snapshot.cameras)
+    {
+        m_pRenderCamera = &camera;
+        camera.pFrameGraph->EnqueuePasses();
+    }
+
+    m_pDevice->Present(m_pContext->GetSwapChain(), 0);
+
+    m_pRenderCamera = nullptr;
+    m_pRenderSnapshot = nullptr;
+}
+
+void DrawingSystem::GetVisableRenderable(RenderQueueItemListType& items)
+{
+    items.insert(items.end(), m_pRenderSnapshot->renderables.begin(), m_pRenderSnapshot->renderables.end());
+}
+
+Entity DrawingSystem::GetMainLight()
+{
+    Entity light = INVALID_ENTITY;
+    m_lightQuery.ForEachChunk([&](uint32_t count, Entity* pEntities, const LightComponent*, const TransformComponent*) {
+        if (!light.IsValid() && count > 0)
+            light = pEntities[0];
+    });
+    return light;
 }
 
 void DrawingSystem::UpdateMaterial(IMaterial* pMaterial)
@@ -597,20 +743,20 @@ void DrawingSystem::UpdateStandardMaterial(StandardMaterial* pMaterial)
         pRenderer->UpdateEmissiveTexture(*m_pResourceTable, pTexture->GetTexture());
 }
 
-void DrawingSystem::GetViewMatrix(TransformComponent* pTransform, float4x4& view, float3& dir)
+// Row vectors, the first row of the world matrix is the local x axis the camera looks along
+// and the last row its position.
+void DrawingSystem::GetViewMatrix(const float4x4& world, float4x4& view, float3& dir)
 {
-    float3 pos = pTransform->GetPosition();
-    float3 rotate = pTransform->GetRotate();
+    float3 pos = float3(world.x30, world.x31, world.x32);
 
     float3 up = float3(0.0f, 1.0f, 0.0f);
-    dir = float3(1.0f, 0.0f, 0.0f);
-    dir = Mat::Mul(dir, Mat::EulerRotateLH(rotate.x, rotate.y, rotate.z));
+    dir = Vec::Normalize(float3(world.x00, world.x01, world.x02));
     auto at = dir + pos;
 
     view = Mat::LookAtLH(pos, at, up);
 }
 
-void DrawingSystem::GetProjectionMatrix(CameraComponent* pCamera, float4x4& proj)
+void DrawingSystem::GetProjectionMatrix(const CameraComponent* pCamera, float4x4& proj)
 {
     auto fovy = pCamera->GetFov();
     auto zn = pCamera->GetClippingNear();
@@ -621,14 +767,11 @@ void DrawingSystem::GetProjectionMatrix(CameraComponent* pCamera, float4x4& proj
     proj = Mat::PerspectiveFovLH(fovy, aspect, zn, zf);
 }
 
-void DrawingSystem::GetLightViewProjectionMatrix(TransformComponent* pTransform, float4x4& view, float4x4& proj, float3& dir)
+void DrawingSystem::GetLightViewProjectionMatrix(const float4x4& world, float4x4& view, float4x4& proj, float3& dir)
 {
-    float3 rotate = pTransform->GetRotate();
-
     float3 at = float3(0.0f, 0.0f, 0.0f);
     float3 up = float3(0.0f, 1.0f, 0.0f);
-    dir = float3(1.0f, 0.0f, 0.0f);
-    dir = Vec::Normalize(Mat::Mul(dir, Mat::EulerRotateLH(rotate.x, rotate.y, rotate.z)));
+    dir = Vec::Normalize(float3(world.x00, world.x01, world.x02));
     float3 pos = at - dir;
 
     view = Mat::LookAtLH(pos, at, up);
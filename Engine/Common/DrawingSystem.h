@@ -1,6 +1,9 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 
@@ -16,6 +19,8 @@
 #include "DrawingResourceTable.h"
 #include "ForwardRenderer.h"
 #include "FrameGraph.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
 
 #include "StandardMaterial.h"
 
@@ -24,7 +29,10 @@ namespace Engine
     class TransformComponent;
     class MeshFilterComponent;
     class MeshRendererComponent;
-    class DrawingSystem : public IDrawingSystem, public ECSSystemBase<TransformComponent, MeshFilterComponent, MeshRendererComponent>
+    class LightComponent;
+    class CameraComponent;
+    class FrameGraphComponent;
+    class DrawingSystem : public IDrawingSystem, public ECSSystemBase<const TransformComponent, const MeshFilterComponent, const MeshRendererComponent>
     {
     public:
         DrawingSystem();
@@ -33,8 +41,9 @@ namespace Engine
         void Initialize() override;
         void Shutdown() override;
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "DrawingSystem"; }
 
-        void FlushEntity(IEntity* pEntity) override;
+        void FlushEntity(Entity entity) override;
 
         EConfigurationDeviceType GetDeviceType() const override;
         void SetDeviceType(EConfigurationDeviceType type) override;
@@ -52,11 +61,21 @@ namespace Engine
         void FlushMaterial(IMaterial* pMaterial);
         void FlushStandardMaterial(StandardMaterial* pMaterial);
 
-        void BuildFrameGraph(IEntity* pCamera);
-        bool BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, IEntity* pCamera);
-        bool BuildDeferredFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, IEntity* pCamera);
+        void BuildFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph, ERendererType rendererType);
+        bool BuildForwardFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph);
+        bool BuildDeferredFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph);
+
+        void StartRenderThread();
+        void StopRenderThread();
+        void RenderThreadMain();
+
+        void FlushPending();
+        void ExtractSnapshot(RenderSnapshot& snapshot);
+        void ExtractRenderables(RenderSnapshot& snapshot);
+        void RenderFrame(const RenderSnapshot& snapshot);
 
         void GetVisableRenderable(RenderQueueItemListType& items);
+        Entity GetMainLight();
 
         void UpdateMaterial(IMaterial* pMaterial);
         void UpdateStandardMaterial(StandardMaterial* pMaterial);
@@ -64,10 +83,10 @@ namespace Engine
         std::shared_ptr<DrawingTarget> CreateSwapChain();
         std::shared_ptr<DrawingDepthBuffer> CreateDepthBuffer();
 
-        void GetViewMatrix(TransformComponent* pTransform, float4x4& view, float3& dir = float3());
-        void GetProjectionMatrix(CameraComponent* pCamera, float4x4& proj);
+        void GetViewMatrix(const float4x4& world, float4x4& view, float3& dir);
+        void GetProjectionMatrix(const CameraComponent* pCamera, float4x4& proj);
 
-        void GetLightViewProjectionMatrix(TransformComponent* pTransform, float4x4& view, float4x4& proj, float3& dir = float3());
+        void GetLightViewProjectionMatrix(const float4x4& world, float4x4& view, float4x4& proj, float3& dir);
 
         void UpdateCameraDir(float3 dir);
         void UpdateLightDir(float3 dir);
@@ -87,8 +106,42 @@ namespace Engine
         std::shared_ptr<DrawingResourceFactory> m_pResourceFactory;
         std::shared_ptr<DrawingResourceTable> m_pResourceTable;
 
-        std::vector<IEntity*> m_pCameraList;
-        std::vector<IEntity*> m_pLightList;
-        std::vector<IEntity*> m_pMeshList;
+        ECSQuery<const FrameGraphComponent, const CameraComponent, const TransformComponent> m_cameraQuery;
+        ECSQuery<const LightComponent, const TransformComponent> m_lightQuery;
+        ECSQuery<const MeshFilterComponent, const MeshRendererComponent> m_meshQuery;
+
+        // Gathered again only when the scene layout changes, world matrices are copied
+        // into every snapshot.
+        std::vector<const float4x4*> m_pWorldMatrices;
+        std::vector<std::shared_ptr<IMesh>> m_pMeshes;
+        std::vector<std::shared_ptr<IMaterial>> m_pMaterials;
+        uint32_t m_renderableVersion;
+        uint64_t m_frame;
+
+        TripleBuffer<RenderSnapshot> m_snapshots;
+        bool m_bRenderThread;
+        std::thread m_renderThread;
+
+        // Guards publishing against the render thread going to sleep, so no wake up is lost.
+        std::mutex m_snapshotMutex;
+        std::condition_variable m_snapshotCondition;
+        bool m_bQuitRender;
+
+        struct PendingFrameGraph
+        {
+            std::shared_ptr<FrameGraph> pFrameGraph;
+            ERendererType rendererType;
+        };
+
+        // Queued by FlushEntity and built by the render thread, so the main thread never
+        // waits for a frame to end. The lock only covers the two lists.
+        std::mutex m_pendingMutex;
+        std::vector<PendingFrameGraph> m_pendingFrameGraphs;
+        std::vector<std::shared_ptr<IMaterial>> m_pendingMaterials;
+
+        // Render thread only, valid while a frame is drawn.
+        const RenderSnapshot* m_pRenderSnapshot;
+        const RenderCameraSnapshot* m_pRenderCamera;
+        uint32_t m_materialVersion;
     };
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <assert.h>
+#include <new>
+#include <string.h>
+
+#include "ECSArchetype.h"
+#include "IECSWorld.h"
+#include "Algorithm.h"
+#include "VirtualPagePool.h"
+
+using namespace Engine;
+
+ECSChunk::ECSChunk(uint32_t size) : m_count(0), m_pData(nullptr), m_bPooled(false)
+{
+    if (size == ECSArchetype::CHUNK_SIZE)
+        m_pData = static_cast<uint8_t*>(GetPagePool().AllocatePage());
+
+    // Odd sizes and an exhausted reservation fall back to the heap.
+    m_bPooled = m_pData != nullptr;
+    if (!m_bPooled)
+        m_pData = static_cast<uint8_t*>(::operator new(size, std::align_val_t(ECSArchetype::COLUMN_ALIGNMENT)));
+}
+
+ECSChunk::~ECSChunk()
+{
+    if (m_bPooled)
+        GetPagePool().FreePage(m_pData);
+    else
+        ::operator delete(m_pData, std::align_val_t(ECSArchetype::COLUMN_ALIGNMENT));
+}
+
+uint8_t* ECSChunk::GetData() const
+{
+    return m_pData;
+}
+
+VirtualPagePool& ECSChunk::GetPagePool()
+{
+    // Never destroyed, chunks owned by statics may be released after it would be.
+    static auto pPagePool = new VirtualPagePool(ECSArchetype::CHUNK_SIZE);
+    return *pPagePool;
+}
+
+ECSArchetype::ECSArchetype(CompBitset bitset) : m_bitset(bitset), m_capacity(0), m_chunkSize(CHUNK_SIZE), m_count(0), m_structureVersion(0)
+{
+    for (CompID id = 0; id < MAX_COMPONENTS; id++)
+    {
+        m_columnOffsets[id] = INVALID_OFFSET;
+        m_columnSizes[id] = 0;
+        m_columnIndices[id] = INVALID_OFFSET;
+        if (IsBitOf(bitset, id))
+        {
+            m_columnIndices[id] = (uint32_t)m_ids.size();
+            m_ids.emplace_back(id);
+        }
+    }
+
+    BuildLayout();
+}
+
+ECSArchetype::~ECSArchetype()
+{
+    Clear();
+}
+
+CompBitset ECSArchetype::GetBitset() const
+{
+    return m_bitset;
+}
+
+const std::vector<CompID>& ECSArchetype::GetComponentIDs() const
+{
+    return m_ids;
+}
+
+uint32_t ECSArchetype::GetCapacity() const
+{
+    return m_capacity;
+}
+
+uint32_t ECSArchetype::GetEntityCount() const
+{
+    return m_count;
+}
+
+uint32_t ECSArchetype::GetChunkCount() const
+{
+    return (uint32_t)m_pChunks.size();
+}
+
+uint32_t ECSArchetype::GetChunkEntityCount(uint32_t chunk) const
+{
+    return m_pChunks[chunk]->m_count;
+}
+
+uint32_t ECSArchetype::GetStructureVersion() const
+{
+    return m_structureVersion;
+}
+
+uint32_t ECSArchetype::AllocateRow(Entity entity)
+{
+    return AllocateRows(&entity, 1);
+}
+
+uint32_t ECSArchetype::AllocateRows(const Entity* pEntities, uint32_t count)
+{
+    auto firstRow = m_count;
+    auto chunkCount = (size_t)(m_count + count + m_capacity - 1) / m_capacity;
+    if (chunkCount > m_pChunks.capacity())
+        m_pChunks.reserve(std::max(chunkCount, m_pChunks.capacity() * 2));
+
+    uint32_t allocated = 0;
+    while (allocated < count)
+    {
+        auto chunk = m_count / m_capacity;
+        if (chunk == m_pChunks.size())
+        {
+            m_pChunks.emplace_back(std::make_unique<ECSChunk>(m_chunkSize));
+            m_chunkVersions.resize(m_pChunks.size() * m_ids.size());
+        }
+
+        auto& pChunk = m_pChunks[chunk];
+        auto rows = std::min(count - allocated, m_capacity - pChunk->m_count);
+        memcpy(GetEntities(chunk) + pChunk->m_count, pEntities + allocated, rows * sizeof(Entity));
+        MarkStructureChanged(chunk);
+
+        pChunk->m_count += rows;
+        m_count += rows;
+        allocated += rows;
+    }
+
+    return firstRow;
+}
+
+Entity ECSArchetype::RemoveRow(uint32_t row, bool bDestroy)
+{
+    assert(row < m_count);
+
+    if (bDestroy)
+    {
+        for (auto id : m_ids)
+            IComponent::GetDestroyFunc(id)(GetComponent(id, row));
+    }
+
+    Entity moved = INVALID_ENTITY;
+    auto last = m_count - 1;
+    if (row != last)
+    {
+        for (auto id : m_ids)
+            IComponent::GetRelocateFunc(id)(GetComponent(id, last), GetComponent(id, row));
+
+        moved = GetEntity(last);
+        GetEntities(row / m_capacity)[row % m_capacity] = moved;
+        MarkStructureChanged(row / m_capacity);
+    }
+
+    auto& pChunk = m_pChunks[last / m_capacity];
+    pChunk->m_count--;
+    m_count--;
+    m_structureVersion = IECSWorld::GetGlobalVersion();
+
+    if (pChunk->m_count == 0)
+    {
+        m_pChunks.pop_back();
+        m_chunkVersions.resize(m_pChunks.size() * m_ids.size());
+    }
+
+    return moved;
+}
+
+void ECSArchetype::Clear()
+{
+    for (uint32_t row = 0; row < m_count; row++)
+    {
+        for (auto id : m_ids)
+            IComponent::GetDestroyFunc(id)(GetComponent(id, row));
+    }
+
+    m_pChunks.clear();
+    m_chunkVersions.clear();
+    m_count = 0;
+    m_structureVersion = IECSWorld::GetGlobalVersion();
+}
+
+void ECSArchetype::MarkStructureChanged(uint32_t chunk)
+{
+    auto version = IECSWorld::GetGlobalVersion();
+    for (auto id : m_ids)
+        MarkChunkChanged(id, chunk, version);
+
+    m_structureVersion = version;
+}
+
+void ECSArchetype::BuildLayout()
+{
+    uint32_t rowSize = sizeof(Entity);
+    for (auto id : m_ids)
+        rowSize += IComponent::GetSize(id);
+
+    m_capacity = std::max<uint32_t>(CHUNK_SIZE / rowSize, 1);
+    while (m_capacity > 1 && ComputeLayout(m_capacity) > CHUNK_SIZE)
+        m_capacity--;
+
+    // A row too large for a page gets a heap chunk of its own, like the large command blocks.
+    m_chunkSize = std::max(ComputeLayout(m_capacity), CHUNK_SIZE);
+}
+
+uint32_t ECSArchetype::ComputeLayout(uint32_t capacity)
+{
+    uint32_t offset = AlignUp<uint32_t>(sizeof(Entity) * capacity, COLUMN_ALIGNMENT);
+    for (auto id : m_ids)
+    {
+        assert(IComponent::GetAlignment(id) <= COLUMN_ALIGNMENT);
+
+        m_columnOffsets[id] = offset;
+        m_columnSizes[id] = IComponent::GetSize(id);
+        offset = AlignUp<uint32_t>(offset + m_columnSizes[id] * capacity, COLUMN_ALIGNMENT);
+    }
+    return offset;
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+class VirtualPagePool;
+
+namespace Engine
+{
+    typedef uint32_t CompID;
+    typedef uint64_t CompBitset;
+
+    // Index into the world's entity slots plus the generation the slot had when the
+    // handle was issued, so handles to destroyed entities can be detected in O(1).
+    struct Entity
+    {
+        constexpr static uint32_t INVALID_INDEX = static_cast<uint32_t>(-1);
+
+        uint32_t index;
+        uint32_t generation;
+
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+
+        bool IsValid() const { return index != INVALID_INDEX; }
+    };
+
+    const Entity INVALID_ENTITY = { Entity::INVALID_INDEX, 0 };
+
+    // Chunks of the pool page size come from a reserved address range, so a chunk never
+    // moves and archetype growth only ever adds pages.
+    class ECSChunk
+    {
+    public:
+        ECSChunk(uint32_t size);
+        virtual ~ECSChunk();
+
+        uint8_t* GetData() const;
+
+        static VirtualPagePool& GetPagePool();
+
+        uint32_t m_count;
+
+    private:
+        uint8_t* m_pData;
+        bool m_bPooled;
+    };
+
+    class ECSArchetype
+    {
+    public:
+        constexpr static uint32_t CHUNK_SIZE = 16 * 1024;
+        constexpr static uint32_t COLUMN_ALIGNMENT = 64;
+        constexpr static uint32_t MAX_COMPONENTS = sizeof(CompBitset) * 8;
+        constexpr static uint32_t INVALID_OFFSET = static_cast<uint32_t>(-1);
+
+        ECSArchetype(CompBitset bitset);
+        virtual ~ECSArchetype();
+
+        CompBitset GetBitset() const;
+        const std::vector<CompID>& GetComponentIDs() const;
+
+        uint32_t GetCapacity() const;
+        uint32_t GetEntityCount() const;
+        uint32_t GetChunkCount() const;
+        uint32_t GetChunkEntityCount(uint32_t chunk) const;
+
+        inline bool HasComponent(CompID id) const;
+        inline void* GetColumn(CompID id, uint32_t chunk) const;
+        inline void* GetComponent(CompID id, uint32_t row) const;
+        inline Entity* GetEntities(uint32_t chunk) const;
+        inline Entity GetEntity(uint32_t row) const;
+
+        // Per chunk and column, the global version of the last write. Rows moving in or
+        // out stamp every column of the chunk, so a filtered pass never misses new data.
+        inline uint32_t GetChunkVersion(CompID id, uint32_t chunk) const;
+        inline void MarkChunkChanged(CompID id, uint32_t chunk, uint32_t version);
+        inline void MarkChanged(CompID id, uint32_t row, uint32_t version);
+        uint32_t GetStructureVersion() const;
+
+        uint32_t AllocateRow(Entity entity);
+        uint32_t AllocateRows(const Entity* pEntities, uint32_t count);
+        Entity RemoveRow(uint32_t row, bool bDestroy);
+        void Clear();
+
+    private:
+        void BuildLayout();
+        uint32_t ComputeLayout(uint32_t capacity);
+        void MarkStructureChanged(uint32_t chunk);
+
+    private:
+        CompBitset m_bitset;
+        std::vector<CompID> m_ids;
+
+        uint32_t m_capacity;
+        uint32_t m_chunkSize;
+        uint32_t m_count;
+
+        uint32_t m_columnOffsets[MAX_COMPONENTS];
+        uint32_t m_columnSizes[MAX_COMPONENTS];
+        uint32_t m_columnIndices[MAX_COMPONENTS];
+
+        std::vector<std::unique_ptr<ECSChunk>> m_pChunks;
+        std::vector<uint32_t> m_chunkVersions;
+        uint32_t m_structureVersion;
+    };
+
+    inline bool ECSArchetype::HasComponent(CompID id) const
+    {
+        return m_columnOffsets[id] != INVALID_OFFSET;
+    }
+
+    inline void* ECSArchetype::GetColumn(CompID id, uint32_t chunk) const
+    {
+        return m_pChunks[chunk]->GetData() + m_columnOffsets[id];
+    }
+
+    inline void* ECSArchetype::GetComponent(CompID id, uint32_t row) const
+    {
+        auto chunk = row / m_capacity;
+        auto index = row % m_capacity;
+        return m_pChunks[chunk]->GetData() + m_columnOffsets[id] + index * m_columnSizes[id];
+    }
+
+    inline Entity* ECSArchetype::GetEntities(uint32_t chunk) const
+    {
+        return reinterpret_cast<Entity*>(m_pChunks[chunk]->GetData());
+    }
+
+    inline Entity ECSArchetype::GetEntity(uint32_t row) const
+    {
+        return GetEntities(row / m_capacity)[row % m_capacity];
+    }
+
+    inline uint32_t ECSArchetype::GetChunkVersion(CompID id, uint32_t chunk) const
+    {
+        return m_chunkVersions[chunk * m_ids.size() + m_columnIndices[id]];
+    }
+
+    inline void ECSArchetype::MarkChunkChanged(CompID id, uint32_t chunk, uint32_t version)
+    {
+        m_chunkVersions[chunk * m_ids.size() + m_columnIndices[id]] = version;
+    }
+
+    inline void ECSArchetype::MarkChanged(CompID id, uint32_t row, uint32_t version)
+    {
+        MarkChunkChanged(id, row / m_capacity, version);
+    }
+}
\ No newline at end of file
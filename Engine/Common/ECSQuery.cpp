@@ -0,0 +1,90 @@
+#include "ECSQuery.h"
+
+using namespace Engine;
+
+ECSQueryBase::ECSQueryBase(CompBitset bitset) : m_pWorld(nullptr), m_bitset(bitset), m_archetypeCount(0)
+{
+}
+
+void ECSQueryBase::SetWorld(IECSWorld* pWorld)
+{
+    m_pWorld = pWorld;
+    m_pArchetypes.clear();
+    m_archetypeCount = 0;
+}
+
+CompBitset ECSQueryBase::GetBitset() const
+{
+    return m_bitset;
+}
+
+const std::vector<ECSArchetype*>& ECSQueryBase::GetArchetypes()
+{
+    Update();
+    return m_pArchetypes;
+}
+
+uint32_t ECSQueryBase::GetEntityCount()
+{
+    Update();
+
+    uint32_t count = 0;
+    for (auto pArchetype : m_pArchetypes)
+        count += pArchetype->GetEntityCount();
+    return count;
+}
+
+bool ECSQueryBase::HasChanged(uint32_t version)
+{
+    Update();
+
+    for (auto pArchetype : m_pArchetypes)
+    {
+        if (pArchetype->GetStructureVersion() >= version)
+            return true;
+
+        auto chunkCount = pArchetype->GetChunkCount();
+        for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+        {
+            for (auto id : pArchetype->GetComponentIDs())
+            {
+                if (IsBitOf(m_bitset, id) && pArchetype->GetChunkVersion(id, chunk) >= version)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ECSQueryBase::HasStructureChanged(uint32_t version)
+{
+    Update();
+
+    for (auto pArchetype : m_pArchetypes)
+    {
+        if (pArchetype->GetStructureVersion() >= version)
+            return true;
+    }
+    return false;
+}
+
+void ECSQueryBase::Update()
+{
+    if (m_pWorld == nullptr)
+        return;
+
+    auto& pArchetypes = m_pWorld->GetArchetypes();
+    if (pArchetypes.size() < m_archetypeCount)
+    {
+        m_pArchetypes.clear();
+        m_archetypeCount = 0;
+    }
+
+    // Archetypes are only ever appended, so just match the ones created since the last update.
+    for (; m_archetypeCount < pArchetypes.size(); m_archetypeCount++)
+    {
+        auto pArchetype = pArchetypes[m_archetypeCount].get();
+        if ((pArchetype->GetBitset() & m_bitset) == m_bitset)
+            m_pArchetypes.emplace_back(pArchetype);
+    }
+}
\ No newline at end of file
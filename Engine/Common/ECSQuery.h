@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "IECSWorld.h"
+#include "Algorithm.h"
+
+namespace Engine
+{
+    class ECSQueryBase
+    {
+    public:
+        ECSQueryBase(CompBitset bitset);
+        virtual ~ECSQueryBase() = default;
+
+        void SetWorld(IECSWorld* pWorld);
+
+        CompBitset GetBitset() const;
+        const std::vector<ECSArchetype*>& GetArchetypes();
+        uint32_t GetEntityCount();
+
+        // True if a queried column was written, or rows were added or removed, at or after version.
+        bool HasChanged(uint32_t version);
+        bool HasStructureChanged(uint32_t version);
+
+    protected:
+        void Update();
+
+    protected:
+        IECSWorld* m_pWorld;
+        CompBitset m_bitset;
+
+        std::vector<ECSArchetype*> m_pArchetypes;
+        uint32_t m_archetypeCount;
+    };
+
+    // Iterates the archetype chunks holding every component in Comps, in place.
+    // Attaching or detaching components moves entities between archetypes, so the
+    // world must not change structurally inside the callbacks. Chunks handed out with
+    // non-const Comps are stamped as written, the Changed variants skip chunks none of
+    // whose queried columns changed at or after the given version.
+    template<typename... Comps>
+    class ECSQuery : public ECSQueryBase
+    {
+    public:
+        ECSQuery(IECSWorld* pWorld = nullptr);
+        virtual ~ECSQuery() = default;
+
+        template<typename Func>
+        void ForEach(Func func);
+
+        template<typename Func>
+        void ForEachEntity(Func func);
+
+        template<typename Func>
+        void ForEachChunk(Func func);
+
+        template<typename Func>
+        void ForEachChanged(uint32_t version, Func func);
+
+        template<typename Func>
+        void ForEachChunkChanged(uint32_t version, Func func);
+
+    private:
+        static CompBitset GetQueryBitset();
+
+        template<typename Comp>
+        static void MarkWrite(ECSArchetype* pArchetype, uint32_t chunk, uint32_t version);
+    };
+
+    template<typename... Comps>
+    inline ECSQuery<Comps...>::ECSQuery(IECSWorld* pWorld) : ECSQueryBase(GetQueryBitset())
+    {
+        SetWorld(pWorld);
+    }
+
+    template<typename... Comps>
+    template<typename Func>
+    inline void ECSQuery<Comps...>::ForEach(Func func)
+    {
+        ForEachChunk([&](uint32_t count, Entity*, Comps*... pComps) {
+            for (uint32_t i = 0; i < count; i++)
+                func(pComps[i]...);
+        });
+    }
+
+    template<typename... Comps>
+    template<typename Func>
+    inline void ECSQuery<Comps...>::ForEachEntity(Func func)
+    {
+        ForEachChunk([&](uint32_t count, Entity* pEntities, Comps*... pComps) {
+            for (uint32_t i = 0; i < count; i++)
+                func(pEntities[i], pComps[i]...);
+        });
+    }
+
+    template<typename... Comps>
+    template<typename Func>
+    inline void ECSQuery<Comps...>::ForEachChunk(Func func)
+    {
+        ForEachChunkChanged(0, func);
+    }
+
+    template<typename... Comps>
+    template<typename Func>
+    inline void ECSQuery<Comps...>::ForEachChanged(uint32_t version, Func func)
+    {
+        ForEachChunkChanged(version, [&](uint32_t count, Entity*, Comps*... pComps) {
+            for (uint32_t i = 0; i < count; i++)
+                func(pComps[i]...);
+        });
+    }
+
+    template<typename... Comps>
+    template<typename Func>
+    inline void ECSQuery<Comps...>::ForEachChunkChanged(uint32_t version, Func func)
+    {
+        Update();
+
+        auto currentVersion = IECSWorld::GetGlobalVersion();
+        for (auto pArchetype : m_pArchetypes)
+        {
+            auto chunkCount = pArchetype->GetChunkCount();
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                if (version > 0)
+                {
+                    uint32_t chunkVersion = 0;
+                    for (auto columnVersion : { pArchetype->GetChunkVersion(Comps::GetCompID(), chunk)... })
+                        chunkVersion = std::max(chunkVersion, columnVersion);
+
+                    if (chunkVersion < version)
+                        continue;
+                }
+
+                (MarkWrite<Comps>(pArchetype, chunk, currentVersion), ...);
+                func(pArchetype->GetChunkEntityCount(chunk), pArchetype->GetEntities(chunk), static_cast<Comps*>(pArchetype->GetColumn(Comps::GetCompID(), chunk))...);
+            }
+        }
+    }
+
+    template<typename... Comps>
+    inline CompBitset ECSQuery<Comps...>::GetQueryBitset()
+    {
+        CompBitset bitset = 0;
+        CompID ids[] = { 0, Comps::GetCompID()... };
+        for (uint32_t i = 1; i < sizeof(ids) / sizeof(CompID); i++)
+            AddBit<CompBitset>(bitset, ids[i]);
+        return bitset;
+    }
+
+    template<typename... Comps>
+    template<typename Comp>
+    inline void ECSQuery<Comps...>::MarkWrite(ECSArchetype* pArchetype, uint32_t chunk, uint32_t version)
+    {
+        if constexpr (!std::is_const<Comp>::value)
+            pArchetype->MarkChunkChanged(Comp::GetCompID(), chunk, version);
+    }
+
+    template<typename... Comps>
+    inline ECSQuery<Comps...> IECSWorld::Query()
+    {
+        return ECSQuery<Comps...>(this);
+    }
+}
\ No newline at end of file
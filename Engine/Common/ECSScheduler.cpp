@@ -0,0 +1,121 @@
+#include <thread>
+
+#include "ECSScheduler.h"
+
+using namespace Engine;
+
+ECSScheduler::ECSScheduler(JobSystem* pJobSystem, FrameStats* pFrameStats) : m_pJobSystem(pJobSystem), m_pFrameStats(pFrameStats), m_remainingCount(0), m_elapsedTime(0.0f)
+{
+}
+
+void ECSScheduler::Build(const std::vector<std::shared_ptr<IECSSystem>>& pSystems, bool bFixedStep)
+{
+    std::vector<IECSSystem*> pSelected;
+    for (auto& pSystem : pSystems)
+    {
+        if (pSystem->IsFixedStep() == bFixedStep)
+            pSelected.emplace_back(pSystem.get());
+    }
+
+    m_nodes.clear();
+    m_nodes.resize(pSelected.size());
+    m_pendingCounts = std::make_unique<std::atomic<uint32_t>[]>(pSelected.size());
+
+    // Conflicting systems keep their registration order, so every edge points forward.
+    for (uint32_t i = 0; i < pSelected.size(); i++)
+    {
+        auto& node = m_nodes[i];
+        node.pScheduler = this;
+        node.pSystem = pSelected[i];
+        node.bMainThread = node.pSystem->IsMainThread() || m_pJobSystem == nullptr;
+        node.phase = m_pFrameStats != nullptr ? m_pFrameStats->RegisterPhase(node.pSystem->GetName()) : FrameStats::INVALID_PHASE;
+        node.dependencyCount = 0;
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (IsConflict(m_nodes[j].pSystem, node.pSystem))
+            {
+                m_nodes[j].successors.emplace_back(i);
+                node.dependencyCount++;
+            }
+        }
+    }
+}
+
+void ECSScheduler::Run(float elapsedTime)
+{
+    if (m_nodes.empty())
+        return;
+
+    m_elapsedTime = elapsedTime;
+    m_remainingCount.store((uint32_t)m_nodes.size(), std::memory_order_relaxed);
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+        m_pendingCounts[i].store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        if (m_nodes[i].dependencyCount == 0)
+            Enqueue(i);
+    }
+
+    // The main thread owns the main thread systems and helps the workers while it waits.
+    while (m_remainingCount.load(std::memory_order_acquire) > 0)
+    {
+        uint32_t index;
+        if (m_mainQueue.TryPop(index))
+            Execute(index);
+        else if (m_pJobSystem == nullptr || !m_pJobSystem->TryRunJob())
+            std::this_thread::yield();
+    }
+}
+
+bool ECSScheduler::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+bool ECSScheduler::IsConflict(const IECSSystem* pSystemA, const IECSSystem* pSystemB)
+{
+    if (pSystemA->IsExclusive() || pSystemB->IsExclusive())
+        return true;
+
+    auto readA = pSystemA->GetReadBitset();
+    auto writeA = pSystemA->GetWriteBitset();
+    auto readB = pSystemB->GetReadBitset();
+    auto writeB = pSystemB->GetWriteBitset();
+
+    return (writeA & (readB | writeB)) != 0 || (writeB & readA) != 0;
+}
+
+void ECSScheduler::Enqueue(uint32_t index)
+{
+    auto& node = m_nodes[index];
+    if (node.bMainThread)
+    {
+        m_mainQueue.Push(index);
+        return;
+    }
+
+    m_pJobSystem->Run([](void* pData) {
+        auto pNode = static_cast<SystemNode*>(pData);
+        pNode->pScheduler->Execute((uint32_t)(pNode - pNode->pScheduler->m_nodes.data()));
+    }, &node);
+}
+
+void ECSScheduler::Execute(uint32_t index)
+{
+    auto& node = m_nodes[index];
+    {
+        FrameStats::ScopedPhase phase(m_pFrameStats, node.phase);
+        node.pSystem->UpdateVersion();
+        node.pSystem->Tick(m_elapsedTime);
+    }
+
+    for (auto successor : node.successors)
+    {
+        if (m_pendingCounts[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Enqueue(successor);
+    }
+
+    m_remainingCount.fetch_sub(1, std::memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <memory>
+
+#include "IECSWorld.h"
+#include "JobSystem.h"
+#include "FrameStats.h"
+#include "SafeQueue.h"
+
+namespace Engine
+{
+    class ECSScheduler
+    {
+    public:
+        // Each system's Tick is timed as a phase of pFrameStats, named after the system.
+        ECSScheduler(JobSystem* pJobSystem, FrameStats* pFrameStats = nullptr);
+        virtual ~ECSScheduler() = default;
+
+        // Takes the systems whose IsFixedStep matches bFixedStep.
+        void Build(const std::vector<std::shared_ptr<IECSSystem>>& pSystems, bool bFixedStep);
+        void Run(float elapsedTime);
+
+        bool IsEmpty() const;
+
+        static bool IsConflict(const IECSSystem* pSystemA, const IECSSystem* pSystemB);
+
+    private:
+        struct SystemNode
+        {
+            ECSScheduler* pScheduler;
+            IECSSystem* pSystem;
+            bool bMainThread;
+            uint32_t phase;
+            uint32_t dependencyCount;
+            std::vector<uint32_t> successors;
+        };
+
+        void Enqueue(uint32_t index);
+        void Execute(uint32_t index);
+
+    private:
+        JobSystem* m_pJobSystem;
+        FrameStats* m_pFrameStats;
+
+        std::vector<SystemNode> m_nodes;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_pendingCounts;
+        std::atomic<uint32_t> m_remainingCount;
+
+        SafeQueue<uint32_t> m_mainQueue;
+        float m_elapsedTime;
+    };
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <type_traits>
+
 #include "IECSWorld.h"
+#include "ECSQuery.h"
 #include "Algorithm.h"
 
 namespace Engine
@@ -11,15 +14,36 @@ namespace Engine
     public:
         ECSSystemBase();
         virtual ~ECSSystemBase() = default;
+
+        void AttachWorld(IECSWorld* pWorld) override;
+
+    protected:
+        ECSQuery<ReqComps...> m_query;
     };
 
     template<typename ...ReqComps>
     inline ECSSystemBase<ReqComps...>::ECSSystemBase()
     {
-        m_comps = { ReqComps::m_compID... };
+        m_comps = { ReqComps::GetCompID()... };
         m_compBitset = 0;
         for (CompID id : m_comps)
             AddBit<CompBitset>(m_compBitset, id);
+
+        bool bReadOnly[] = { false, std::is_const<ReqComps>::value... };
+        for (uint32_t i = 0; i < m_comps.size(); i++)
+        {
+            if (bReadOnly[i + 1])
+                AddBit<CompBitset>(m_readBitset, m_comps[i]);
+            else
+                AddBit<CompBitset>(m_writeBitset, m_comps[i]);
+        }
+    }
+
+    template<typename ...ReqComps>
+    inline void ECSSystemBase<ReqComps...>::AttachWorld(IECSWorld* pWorld)
+    {
+        IECSSystem::AttachWorld(pWorld);
+        m_query.SetWorld(pWorld);
     }
 
 }
\ No newline at end of file
@@ -1,47 +1,361 @@
+#include <atomic>
 #include <algorithm>
+#include <assert.h>
+#include <utility>
+#include <vector>
 
 #include "ECSWorld.h"
-#include "Entity.h"
 
 using namespace Engine;
 
+namespace
+{
+    std::atomic<uint64_t> s_worldCount(0);
+
+    // This thread's buffer in each world it recorded into. World IDs are never reused, so
+    // entries of destroyed worlds are never matched again.
+    thread_local std::vector<std::pair<uint64_t, EntityCommandBuffer*>> s_commandBuffers;
+}
+
+ECSWorld::ECSWorld(JobSystem* pJobSystem, FrameStats* pFrameStats) :
+    m_pScheduler(std::make_unique<ECSScheduler>(pJobSystem, pFrameStats)),
+    m_pFixedScheduler(std::make_unique<ECSScheduler>(pJobSystem, pFrameStats)),
+    m_worldID(++s_worldCount)
+{
+}
+
 void ECSWorld::Initialize()
 {
     IECSWorld::Initialize();
     Flush();
-
-    m_bEntityChanged = false;
 }
 
 void ECSWorld::Shutdown()
 {
     IECSWorld::Shutdown();
+
+    for (auto& pBuffer : m_pCommandBuffers)
+        pBuffer->Clear();
+
+    m_newEntities.clear();
+    m_freeSlots.clear();
+    m_entitySlots.clear();
+    m_archetypeTable.clear();
+    m_archetypePool.clear();
 }
 
 void ECSWorld::Tick(float elapsedTime)
 {
+    if (m_bSystemChanged)
+    {
+        m_pScheduler->Build(m_systemPool, false);
+        m_pFixedScheduler->Build(m_systemPool, true);
+        m_bSystemChanged = false;
+    }
+
+    // Simulation catches up in whole steps, commands recorded by a step land before the next.
+    auto stepCount = m_timestep.Advance(elapsedTime);
+    if (!m_pFixedScheduler->IsEmpty())
+    {
+        for (uint32_t step = 0; step < stepCount; step++)
+        {
+            AdvanceGlobalVersion();
+            Playback();
+            Flush();
+            m_pFixedScheduler->Run(m_timestep.GetStep());
+        }
+        InterpolateSystems();
+    }
+
+    AdvanceGlobalVersion();
+
+    Playback();
     Flush();
-    IECSWorld::Tick(elapsedTime);
+
+    m_pScheduler->Run(elapsedTime);
+}
+
+Entity ECSWorld::CreateEntity(const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids)
+{
+    Entity entity;
+    CreateEntities(1, pComponents, ids, &entity);
+    return entity;
+}
+
+void ECSWorld::CreateEntities(uint32_t count, const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids, Entity* pEntities)
+{
+    CompBitset bitset = 0;
+    for (auto id : ids)
+    {
+        assert(!IsBitOf(bitset, id));
+        AddBit<CompBitset>(bitset, id);
+    }
+
+    auto pArchetype = GetArchetype(bitset);
+    auto firstRow = SpawnEntities(pArchetype, count, pEntities);
+
+    // Fill one column at a time so each prototype is copied into contiguous memory.
+    for (uint32_t i = 0; i < ids.size(); i++)
+    {
+        auto createFunc = IComponent::GetCreateFunc(ids[i]);
+        for (uint32_t j = 0; j < count; j++)
+        {
+            auto pComp = createFunc(pComponents[i], pArchetype->GetComponent(ids[i], firstRow + j));
+            pComp->m_entity = pEntities[j];
+            pComp->MarkChanged();
+        }
+    }
+}
+
+void ECSWorld::AttachComponent(Entity entity, CompID compId, const IComponent* pComponent)
+{
+    if (!IsAlive(entity))
+        return;
+
+    auto bitset = GetCompBitset(entity);
+    assert(!IsBitOf(bitset, compId));
+
+    MoveEntity(entity, GetArchetype(AddBit<CompBitset>(bitset, compId)));
+
+    auto& slot = m_entitySlots[entity.index];
+    auto pComp = IComponent::GetCreateFunc(compId)(pComponent, slot.pArchetype->GetComponent(compId, slot.row));
+    pComp->m_entity = entity;
+    pComp->MarkChanged();
+}
+
+void ECSWorld::DetachComponent(Entity entity, CompID compId)
+{
+    auto bitset = GetCompBitset(entity);
+    if (!IsBitOf(bitset, compId))
+        return;
+
+    MoveEntity(entity, GetArchetype(ClearBit<CompBitset>(bitset, compId)));
+}
+
+void ECSWorld::DestroyEntity(Entity entity)
+{
+    if (!IsAlive(entity))
+        return;
+
+    auto& slot = m_entitySlots[entity.index];
+    RemoveEntityRow(slot.pArchetype, slot.row, true);
+
+    slot.pArchetype = nullptr;
+    slot.generation++;
+    m_freeSlots.emplace_back(entity.index);
+}
+
+EntityCommandBuffer* ECSWorld::GetCommandBuffer()
+{
+    for (auto& commandBuffer : s_commandBuffers)
+    {
+        if (commandBuffer.first == m_worldID)
+            return commandBuffer.second;
+    }
+
+    std::lock_guard<std::mutex> lock(m_commandBufferMutex);
+    m_pCommandBuffers.emplace_back(std::make_unique<EntityCommandBuffer>());
+
+    s_commandBuffers.emplace_back(m_worldID, m_pCommandBuffers.back().get());
+    return s_commandBuffers.back().second;
+}
+
+void ECSWorld::Playback()
+{
+    std::vector<std::pair<EntityCommandBuffer*, uint32_t>> creates;
+    std::vector<std::pair<EntityCommandBuffer*, uint32_t>> changes;
+
+    for (auto& pBuffer : m_pCommandBuffers)
+    {
+        for (uint32_t i = 0; i < pBuffer->m_commands.size(); i++)
+        {
+            if (pBuffer->m_commands[i].type == eEntityCommand_Create)
+                creates.emplace_back(pBuffer.get(), i);
+            else
+                changes.emplace_back(pBuffer.get(), i);
+        }
+    }
+
+    if (creates.empty() && changes.empty())
+        return;
+
+    auto getCommand = [](const std::pair<EntityCommandBuffer*, uint32_t>& record) -> const EntityCommandBuffer::Command& {
+        return record.first->m_commands[record.second];
+    };
+
+    // Group creates by archetype so each one gets a single bulk insertion.
+    std::stable_sort(creates.begin(), creates.end(), [&](const auto& a, const auto& b) {
+        auto& commandA = getCommand(a);
+        auto& commandB = getCommand(b);
+        return commandA.bitset != commandB.bitset ? commandA.bitset < commandB.bitset : commandA.sortKey < commandB.sortKey;
+    });
+
+    for (uint32_t begin = 0, end = 0; begin < creates.size(); begin = end)
+    {
+        auto bitset = getCommand(creates[begin]).bitset;
+        for (end = begin + 1; end < creates.size() && getCommand(creates[end]).bitset == bitset; end++);
+
+        std::vector<std::pair<EntityCommandBuffer*, uint32_t>> group(creates.begin() + begin, creates.begin() + end);
+        PlaybackCreate(group);
+    }
+
+    std::stable_sort(changes.begin(), changes.end(), [&](const auto& a, const auto& b) {
+        return getCommand(a).sortKey < getCommand(b).sortKey;
+    });
+
+    for (auto& record : changes)
+        PlaybackChange(record.first, getCommand(record));
+
+    for (auto& pBuffer : m_pCommandBuffers)
+        pBuffer->Clear();
+}
+
+void ECSWorld::PlaybackCreate(const std::vector<std::pair<EntityCommandBuffer*, uint32_t>>& commands)
+{
+    auto pArchetype = GetArchetype(commands.front().first->m_commands[commands.front().second].bitset);
+
+    std::vector<Entity> entities(commands.size());
+    auto firstRow = SpawnEntities(pArchetype, (uint32_t)commands.size(), entities.data());
+
+    for (uint32_t i = 0; i < commands.size(); i++)
+    {
+        auto pBuffer = commands[i].first;
+        auto& command = pBuffer->m_commands[commands[i].second];
+        pBuffer->m_createdEntities[command.entity.index] = entities[i];
+
+        for (uint32_t j = 0; j < command.componentCount; j++)
+        {
+            auto& data = pBuffer->m_components[command.firstComponent + j];
+            data.pComponent->m_entity = entities[i];
+            data.pComponent->MarkChanged();
+            IComponent::GetRelocateFunc(data.id)(data.pData, pArchetype->GetComponent(data.id, firstRow + i));
+            data.pData = nullptr;
+        }
+    }
 }
 
-std::shared_ptr<IEntity> ECSWorld::CreateEntity(const std::vector<IComponent*>& pComponents, const std::vector<CompID>& ids)
+void ECSWorld::PlaybackChange(EntityCommandBuffer* pBuffer, const EntityCommandBuffer::Command& command)
 {
-    std::shared_ptr<IEntity> pEntity = std::make_shared<EntityBase>(std::shared_ptr<IECSWorld>(this));
-    pEntity->m_id = (EntityID)m_entityPool.size();
+    auto entity = pBuffer->Resolve(command.entity);
+    uint32_t id = 0;
+    BitScan(id, command.bitset);
+
+    switch (command.type)
+    {
+        case eEntityCommand_Destroy:
+        {
+            DestroyEntity(entity);
+            break;
+        }
+        case eEntityCommand_Attach:
+        {
+            auto& data = pBuffer->m_components[command.firstComponent];
+            if (!IsAlive(entity))
+                break;
 
-    for (uint32_t i = 0; i < pComponents.size(); i++)
-        pEntity->AttachComponent(ids[i], pComponents[i], m_compTable);
+            // Attaching a component the entity already has replaces it in place.
+            auto& slot = m_entitySlots[entity.index];
+            auto bitset = slot.pArchetype->GetBitset();
+            if (IsBitOf(bitset, id))
+            {
+                IComponent::GetDestroyFunc(id)(slot.pArchetype->GetComponent(id, slot.row));
+                slot.pArchetype->MarkChanged(id, slot.row, GetGlobalVersion());
+            }
+            else
+            {
+                MoveEntity(entity, GetArchetype(AddBit<CompBitset>(bitset, id)));
+            }
 
-    m_entityPool.emplace_back(pEntity);
-    return pEntity;
+            data.pComponent->m_entity = entity;
+            data.pComponent->MarkChanged();
+            IComponent::GetRelocateFunc(id)(data.pData, slot.pArchetype->GetComponent(id, slot.row));
+            data.pData = nullptr;
+            break;
+        }
+        case eEntityCommand_Detach:
+        {
+            DetachComponent(entity, id);
+            break;
+        }
+        default:
+            assert(false);
+    }
+}
+
+uint32_t ECSWorld::SpawnEntities(ECSArchetype* pArchetype, uint32_t count, Entity* pEntities)
+{
+    // Reuse destroyed slots first, their generation was bumped when they were freed.
+    auto reused = std::min(count, (uint32_t)m_freeSlots.size());
+    for (uint32_t i = 0; i < reused; i++)
+    {
+        auto index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+
+        m_entitySlots[index].pArchetype = pArchetype;
+        pEntities[i] = { index, m_entitySlots[index].generation };
+    }
+
+    auto slotCount = m_entitySlots.size() + count - reused;
+    if (slotCount > m_entitySlots.capacity())
+        m_entitySlots.reserve(std::max(slotCount, m_entitySlots.capacity() * 2));
+
+    for (uint32_t i = reused; i < count; i++)
+    {
+        pEntities[i] = { (uint32_t)m_entitySlots.size(), 0 };
+        m_entitySlots.emplace_back(EntitySlot{ pArchetype, 0, pEntities[i].generation });
+    }
+
+    auto firstRow = pArchetype->AllocateRows(pEntities, count);
+    for (uint32_t i = 0; i < count; i++)
+        m_entitySlots[pEntities[i].index].row = firstRow + i;
+
+    m_newEntities.insert(m_newEntities.end(), pEntities, pEntities + count);
+    return firstRow;
+}
+
+void ECSWorld::MoveEntity(Entity entity, ECSArchetype* pArchetype)
+{
+    auto& slot = m_entitySlots[entity.index];
+    auto pSrcArchetype = slot.pArchetype;
+    auto srcRow = slot.row;
+
+    auto row = pArchetype->AllocateRow(entity);
+    slot.pArchetype = pArchetype;
+    slot.row = row;
+
+    for (auto id : pSrcArchetype->GetComponentIDs())
+    {
+        auto pSrc = pSrcArchetype->GetComponent(id, srcRow);
+        if (pArchetype->HasComponent(id))
+            IComponent::GetRelocateFunc(id)(pSrc, pArchetype->GetComponent(id, row));
+        else
+            IComponent::GetDestroyFunc(id)(pSrc);
+    }
+
+    RemoveEntityRow(pSrcArchetype, srcRow, false);
+}
+
+void ECSWorld::RemoveEntityRow(ECSArchetype* pArchetype, uint32_t row, bool bDestroy)
+{
+    auto moved = pArchetype->RemoveRow(row, bDestroy);
+    if (moved.IsValid())
+        m_entitySlots[moved.index].row = row;
 }
 
 void ECSWorld::Flush()
 {
-    if (!m_bEntityChanged)
+    if (m_newEntities.empty())
         return;
 
-    for (auto& system : m_systemPool)
-        for (auto& entity : m_entityPool)
-            system->FlushEntity(entity.get());
+    std::vector<Entity> entities;
+    entities.swap(m_newEntities);
+
+    for (auto& entity : entities)
+    {
+        if (!IsAlive(entity))
+            continue;
+
+        for (auto& system : m_systemPool)
+            system->FlushEntity(entity);
+    }
 }
\ No newline at end of file
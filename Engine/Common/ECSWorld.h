@@ -1,25 +1,53 @@
 #pragma once
 
+#include <mutex>
+
 #include "IECSWorld.h"
+#include "ECSScheduler.h"
+#include "EntityCommandBuffer.h"
 
 namespace Engine
 {
     class ECSWorld : public IECSWorld
     {
     public:
-        ECSWorld() = default;
+        ECSWorld(JobSystem* pJobSystem = nullptr, FrameStats* pFrameStats = nullptr);
 
         void Initialize() override;
         void Shutdown() override;
 
         void Tick(float elapsedTime) override;
 
+        using IECSWorld::AttachComponent;
+        using IECSWorld::DetachComponent;
+
+        void AttachComponent(Entity entity, CompID compId, const IComponent* pComponent) override;
+        void DetachComponent(Entity entity, CompID compId) override;
+
+        void DestroyEntity(Entity entity) override;
+        EntityCommandBuffer* GetCommandBuffer() override;
+
     private:
+        void Playback();
+        void PlaybackCreate(const std::vector<std::pair<EntityCommandBuffer*, uint32_t>>& commands);
+        void PlaybackChange(EntityCommandBuffer* pBuffer, const EntityCommandBuffer::Command& command);
+
+        uint32_t SpawnEntities(ECSArchetype* pArchetype, uint32_t count, Entity* pEntities);
         void Flush();
+        void MoveEntity(Entity entity, ECSArchetype* pArchetype);
+        void RemoveEntityRow(ECSArchetype* pArchetype, uint32_t row, bool bDestroy);
 
     protected:
-        std::shared_ptr<IEntity> CreateEntity(const std::vector<IComponent*>& pComponents, const std::vector<CompID>& ids) override;
+        Entity CreateEntity(const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids) override;
+        void CreateEntities(uint32_t count, const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids, Entity* pEntities) override;
+
+        std::vector<Entity> m_newEntities;
+        std::vector<uint32_t> m_freeSlots;
+        std::unique_ptr<ECSScheduler> m_pScheduler;
+        std::unique_ptr<ECSScheduler> m_pFixedScheduler;
 
-        bool m_bEntityChanged = true;
+        uint64_t m_worldID;
+        std::mutex m_commandBufferMutex;
+        std::vector<std::unique_ptr<EntityCommandBuffer>> m_pCommandBuffers;
     };
-}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <assert.h>
+
+#include "EntityCommandBuffer.h"
+#include "Algorithm.h"
+
+using namespace Engine;
+
+EntityCommandBuffer::EntityCommandBuffer() : m_blockOffset(BLOCK_SIZE), m_sortKey(0)
+{
+}
+
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+    Clear();
+}
+
+void EntityCommandBuffer::SetSortKey(uint32_t sortKey)
+{
+    m_sortKey = sortKey;
+}
+
+void EntityCommandBuffer::DestroyEntity(Entity entity)
+{
+    Record(eEntityCommand_Destroy, entity, 0, nullptr);
+}
+
+bool EntityCommandBuffer::IsEmpty() const
+{
+    return m_commands.empty();
+}
+
+void EntityCommandBuffer::Clear()
+{
+    // Payloads the world has not consumed still have to be destroyed.
+    for (auto& data : m_components)
+    {
+        if (data.pData != nullptr)
+            IComponent::GetDestroyFunc(data.id)(data.pData);
+    }
+
+    m_commands.clear();
+    m_components.clear();
+    m_createdEntities.clear();
+
+    m_pLargeBlocks.clear();
+    if (m_pBlocks.size() > 1)
+        m_pBlocks.resize(1);
+    m_blockOffset = m_pBlocks.empty() ? BLOCK_SIZE : 0;
+}
+
+Entity EntityCommandBuffer::RecordCreate(const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids)
+{
+    Entity entity = { (uint32_t)m_createdEntities.size(), DEFERRED_GENERATION };
+    m_createdEntities.emplace_back(INVALID_ENTITY);
+
+    Command command = { eEntityCommand_Create, m_sortKey, entity, 0, (uint32_t)m_components.size(), (uint32_t)ids.size() };
+    for (uint32_t i = 0; i < ids.size(); i++)
+    {
+        assert(!IsBitOf(command.bitset, ids[i]));
+        AddBit<CompBitset>(command.bitset, ids[i]);
+
+        auto pData = Allocate(IComponent::GetSize(ids[i]), IComponent::GetAlignment(ids[i]));
+        auto pComponent = IComponent::GetCreateFunc(ids[i])(pComponents[i], pData);
+        m_components.emplace_back(ComponentData{ ids[i], pComponent, pData });
+    }
+
+    m_commands.emplace_back(command);
+    return entity;
+}
+
+void EntityCommandBuffer::Record(EEntityCommand type, Entity entity, CompID id, const IComponent* pComponent)
+{
+    Command command = { type, m_sortKey, entity, 0, (uint32_t)m_components.size(), 0 };
+    if (type == eEntityCommand_Attach || type == eEntityCommand_Detach)
+        AddBit<CompBitset>(command.bitset, id);
+
+    if (pComponent != nullptr)
+    {
+        auto pData = Allocate(IComponent::GetSize(id), IComponent::GetAlignment(id));
+        m_components.emplace_back(ComponentData{ id, IComponent::GetCreateFunc(id)(pComponent, pData), pData });
+        command.componentCount = 1;
+    }
+
+    m_commands.emplace_back(command);
+}
+
+void* EntityCommandBuffer::Allocate(uint32_t size, uint32_t alignment)
+{
+    assert(alignment <= ECSArchetype::COLUMN_ALIGNMENT);
+
+    // Payloads never move once recorded, so components that are not trivially
+    // relocatable stay valid until the world consumes them.
+    if (size > BLOCK_SIZE)
+    {
+        m_pLargeBlocks.emplace_back(std::make_unique<ECSChunk>(size));
+        return m_pLargeBlocks.back()->GetData();
+    }
+
+    auto offset = AlignUp<uint32_t>(m_blockOffset, alignment);
+    if (offset + size > BLOCK_SIZE)
+    {
+        m_pBlocks.emplace_back(std::make_unique<ECSChunk>(BLOCK_SIZE));
+        offset = 0;
+    }
+
+    m_blockOffset = offset + size;
+    return m_pBlocks.back()->GetData() + offset;
+}
+
+Entity EntityCommandBuffer::Resolve(Entity entity) const
+{
+    if (entity.generation != DEFERRED_GENERATION)
+        return entity;
+
+    return entity.index < m_createdEntities.size() ? m_createdEntities[entity.index] : INVALID_ENTITY;
+}
\ No newline at end of file
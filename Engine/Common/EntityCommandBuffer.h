@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "IECSWorld.h"
+
+namespace Engine
+{
+    enum EEntityCommand
+    {
+        eEntityCommand_Create = 0,
+        eEntityCommand_Destroy,
+        eEntityCommand_Attach,
+        eEntityCommand_Detach,
+    };
+
+    // Records structural changes so that worker threads never touch the archetypes directly.
+    // The world plays every buffer back at the start of its next tick. Commands are ordered
+    // by their sort key, so jobs that need a deterministic result should set one.
+    class EntityCommandBuffer
+    {
+    friend class ECSWorld;
+    public:
+        constexpr static uint32_t DEFERRED_GENERATION = static_cast<uint32_t>(-1);
+        constexpr static uint32_t BLOCK_SIZE = ECSArchetype::CHUNK_SIZE;
+
+        EntityCommandBuffer();
+        virtual ~EntityCommandBuffer();
+
+        void SetSortKey(uint32_t sortKey);
+
+        // Returns a deferred handle, valid for later commands in this buffer only.
+        template<typename... Comps>
+        Entity CreateEntity(Comps... comps);
+
+        void DestroyEntity(Entity entity);
+
+        template<typename Comp>
+        void AttachComponent(Entity entity, Comp component);
+
+        template<typename Comp>
+        void DetachComponent(Entity entity);
+
+        bool IsEmpty() const;
+        void Clear();
+
+    private:
+        struct Command
+        {
+            EEntityCommand type;
+            uint32_t sortKey;
+            Entity entity;
+            CompBitset bitset;
+            uint32_t firstComponent;
+            uint32_t componentCount;
+        };
+
+        struct ComponentData
+        {
+            CompID id;
+            IComponent* pComponent;
+            void* pData;
+        };
+
+        Entity RecordCreate(const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids);
+        void Record(EEntityCommand type, Entity entity, CompID id, const IComponent* pComponent);
+
+        void* Allocate(uint32_t size, uint32_t alignment);
+        Entity Resolve(Entity entity) const;
+
+    private:
+        std::vector<Command> m_commands;
+        std::vector<ComponentData> m_components;
+        std::vector<Entity> m_createdEntities;
+
+        std::vector<std::unique_ptr<ECSChunk>> m_pBlocks;
+        std::vector<std::unique_ptr<ECSChunk>> m_pLargeBlocks;
+        uint32_t m_blockOffset;
+        uint32_t m_sortKey;
+    };
+
+    template<typename... Comps>
+    inline Entity EntityCommandBuffer::CreateEntity(Comps... comps)
+    {
+        std::vector<CompID> ids = { Comps::GetCompID()... };
+        std::vector<const IComponent*> pComponents = { &comps... };
+        return RecordCreate(pComponents, ids);
+    }
+
+    template<typename Comp>
+    inline void EntityCommandBuffer::AttachComponent(Entity entity, Comp component)
+    {
+        Record(eEntityCommand_Attach, entity, Comp::GetCompID(), &component);
+    }
+
+    template<typename Comp>
+    inline void EntityCommandBuffer::DetachComponent(Entity entity)
+    {
+        Record(eEntityCommand_Detach, entity, Comp::GetCompID(), nullptr);
+    }
+}
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "Global.h"
 #include "EventSystem.h"
 
@@ -9,110 +11,130 @@ void EventSystem::Initialize()
 
 void EventSystem::Shutdown()
 {
-    m_eventQueue.clear();
-    for (auto& it : m_eventListeners)
-    {
-        auto & list = it.second;
-        list.clear();
-    }
-    m_eventListeners.clear();
+    ReleaseChannels();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& pEventQueue : m_pEventQueuePool)
+        pEventQueue->Clear();
 }
 
-void EventSystem::Tick(float elapsedTime)
+void EventSystem::Tick(float)
 {
     ProcessEvents();
 }
 
-void EventSystem::FlushEntity(IEntity* pEntity)
+void EventSystem::FlushEntity(Entity)
 {
 }
 
-bool EventSystem::AddListener(IEventData::id_t id, EventDelegate proc)
+void EventSystem::ProcessEvents()
 {
-    auto it = m_eventListeners.find(id);
-    if (it == m_eventListeners.end())
-        m_eventListeners[id] = EventDelegateList();
-    
-    auto &list = m_eventListeners[id];
-    for (auto &p : list)
+    CollectEvents();
+
+    // Recounted every pass, a listener may queue an event type seen for the first time.
+    for (EventID id = 0; id < IEventQueue::GetEventTypeCount(); id++)
     {
-        if (p.target<EventDelegate>() == proc.target<EventDelegate>())
-            return false;
+        auto pEventQueue = GetEventQueue(id);
+        if (pEventQueue != nullptr)
+            pEventQueue->Dispatch();
     }
-    list.emplace_back(proc);
 
-    return true;
+    ProcessTimeSlice();
 }
 
-bool EventSystem::RemoveListener(IEventData::id_t id, EventDelegate proc)
+void EventSystem::ProcessEvents(EventContext context)
 {
-    auto it = m_eventListeners.find(id);
-    if (it == m_eventListeners.end())
-        return false;
+    if (context == EVENT_CONTEXT_MAIN)
+    {
+        ProcessEvents();
+        return;
+    }
 
-    auto &list = it->second;
-    for (auto it = list.cbegin(); it != list.cend(); ++it)
+    for (EventID id = 0; id < IEventQueue::GetEventTypeCount(); id++)
     {
-        const EventDelegate &p = *it; 
-        if (p.target<EventDelegate>() == proc.target<EventDelegate>())
-        {
-            list.erase(it);
-            return true;
-        }
+        auto pEventQueue = GetEventQueue(id);
+        if (pEventQueue != nullptr)
+            pEventQueue->Dispatch(context);
     }
-    return false;
 }
 
-void EventSystem::QueueEvent(IEventDataPtr e)
+void EventSystem::ProcessEndOfFrame()
 {
-    m_eventQueue.emplace_back(e);
+    CollectEvents();
+
+    auto& channel = m_channels[eEventChannel_EndOfFrame];
+    while (!channel.Empty())
+    {
+        auto entry = channel.Pop();
+        entry.pEventQueue->DispatchSlot(entry.slot);
+    }
 }
 
-void EventSystem::ProcessEvents()
+void EventSystem::CollectEvents()
 {
-    for (auto it = m_eventQueue.cbegin(); it != m_eventQueue.cend();)
+    for (EventID id = 0; id < IEventQueue::GetEventTypeCount(); id++)
     {
-        auto &e = *it;
-        auto listeners = m_eventListeners.find(e->GetID());
-        if (listeners != m_eventListeners.cend())
-        {
-            for (auto p : listeners->second)
-                p(e);
-        }
-        it = m_eventQueue.erase(it);
+        auto pEventQueue = GetEventQueue(id);
+        if (pEventQueue != nullptr)
+            pEventQueue->Collect();
+    }
+}
+
+void EventSystem::ProcessTimeSlice()
+{
+    // Checked after each event, so at least one is delivered per tick whatever the budget.
+    auto& channel = m_channels[eEventChannel_TimeSliced];
+    auto start = std::chrono::steady_clock::now();
+    while (!channel.Empty())
+    {
+        auto entry = channel.Pop();
+        entry.pEventQueue->DispatchSlot(entry.slot);
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        if (elapsed.count() >= m_timeSliceBudget)
+            break;
     }
 }
 
 EventListener::EventListener()
 {
-    el_mEventSystem = gpGlobal->GetEventSystem();
 }
 
+// The event system is looked up on every call, Global clears it before destroying any module.
 EventListener::~EventListener()
 {
-    if (el_mEventSystem.expired())
+    auto em = gpGlobal->Get<IEventSystem>();
+    if (em == nullptr)
         return;
-    auto em = el_mEventSystem.lock();
     for (auto &e : el_mEvent)
-        em->RemoveListener(e.first, e.second);
+        em->RemoveListener(e);
 }
 
-bool EventListener::OnEvent(IEventData::id_t id, EventDelegate proc)
+bool EventListener::Remove(const EventSubscription& subscription)
 {
-    if(el_mEventSystem.expired())
-        return false; 
-    auto em = el_mEventSystem.lock(); 
-    if (em->AddListener(id, proc)){
-        el_mEvent.emplace_back(id, proc); 
-    }
-    return true;
+    auto it = std::find(el_mEvent.begin(), el_mEvent.end(), subscription);
+    auto em = gpGlobal->Get<IEventSystem>();
+    if (it == el_mEvent.end() || em == nullptr)
+        return false;
+
+    el_mEvent.erase(it);
+    return em->RemoveListener(subscription);
 }
 
-bool EventListener::Dispatch(IEventData::id_t id, EventDelegate proc)
+bool EventListener::Dispatch(EventID id)
 {
-    if(el_mEventSystem.expired())
-        return false; 
-    auto em = el_mEventSystem.lock(); 
-    em->RemoveListener(id, proc);
+    auto em = gpGlobal->Get<IEventSystem>();
+    if (em == nullptr)
+        return false;
+    for (auto it = el_mEvent.begin(); it != el_mEvent.end();)
+    {
+        if (it->id != id)
+        {
+            ++it;
+            continue;
+        }
+        em->RemoveListener(*it);
+        it = el_mEvent.erase(it);
+    }
     return true;
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <map>
 #include <memory>
 
 #include "IEventSystem.h"
@@ -18,18 +17,18 @@ namespace Engine
         void Initialize() override;
         void Shutdown() override;
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "EventSystem"; }
 
-        void FlushEntity(IEntity* pEntity) override;
+        void FlushEntity(Entity entity) override;
 
-        bool AddListener(IEventData::id_t id, EventDelegate proc) override;
-        bool RemoveListener(IEventData::id_t id, EventDelegate proc) override;
-        void QueueEvent(IEventDataPtr e) override;
+        void ProcessEvents(EventContext context) override;
+        void ProcessEndOfFrame() override;
 
     protected:
         void ProcessEvents() override;
 
     private:
-        std::list<IEventDataPtr> m_eventQueue;
-        std::map<IEventData::id_t, EventDelegateList> m_eventListeners;
+        void CollectEvents();
+        void ProcessTimeSlice();
     };
 }
\ No newline at end of file
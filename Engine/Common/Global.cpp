@@ -1,8 +1,10 @@
+#include <algorithm>
+#include <iterator>
+
 #include "Global.h"
 
 #include "IApplication.h"
 #include "IECSWorld.h"
-#include "IRenderer.h"
 
 #include "IEventSystem.h"
 #include "IAnimationSystem.h"
@@ -20,12 +22,16 @@ namespace Engine
 
 Global::Global()
 {
+    std::fill(std::begin(m_pServices), std::end(m_pServices), nullptr);
+    m_jobSystem.Initialize();
 }
 
 Global::~Global()
 {
+    std::fill(std::begin(m_pServices), std::end(m_pServices), nullptr);
     m_pRenderers.clear();
     m_pSystems.clear();
+    m_jobSystem.Shutdown();
 }
 
 std::shared_ptr<IApplication> Global::GetApplication()
@@ -40,42 +46,42 @@ std::shared_ptr<IECSWorld> Global::GetECSWorld()
 
 std::shared_ptr<IEventSystem> Global::GetEventSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Event);
+    auto pModule = GetRuntimeModule(eSystem_Event);
     auto pEventSystem = std::dynamic_pointer_cast<IEventSystem>(pModule);
     return pEventSystem;
 }
 
 std::shared_ptr<IAnimationSystem> Global::GetAnimationSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Animation);
+    auto pModule = GetRuntimeModule(eSystem_Animation);
     auto pAnimationSystem = std::dynamic_pointer_cast<IAnimationSystem>(pModule);
     return pAnimationSystem;
 }
 
 std::shared_ptr<IDrawingSystem> Global::GetDrawingSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Drawing);
+    auto pModule = GetRuntimeModule(eSystem_Drawing);
     auto pDrawingSystem = std::dynamic_pointer_cast<IDrawingSystem>(pModule);
     return pDrawingSystem;
 }
 
 std::shared_ptr<ISceneSystem> Global::GetSceneSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Scene);
+    auto pModule = GetRuntimeModule(eSystem_Scene);
     auto pSceneSystem = std::dynamic_pointer_cast<ISceneSystem>(pModule);
     return pSceneSystem;
 }
 
 std::shared_ptr<IInputSystem> Global::GetInputSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Input);
+    auto pModule = GetRuntimeModule(eSystem_Input);
     auto pInputSystem = std::dynamic_pointer_cast<IInputSystem>(pModule);
     return pInputSystem;
 }
 
 std::shared_ptr<ILogSystem> Global::GetLogSystem()
 {
-    auto& pModule = GetRuntimeModule(eSystem_Log);
+    auto pModule = GetRuntimeModule(eSystem_Log);
     auto pLogSystem = std::dynamic_pointer_cast<ILogSystem>(pModule);
     return pLogSystem;
 }
@@ -86,11 +92,7 @@ std::shared_ptr<IRenderer> Global::GetRenderer(ERendererType type)
     if (it == m_pRenderers.end())
         return nullptr;
     else
-    {
-        auto& renderer = it->second;
-        auto result = std::dynamic_pointer_cast<IRenderer>(renderer);
-        return result;
-    }
+        return it->second;
 }
 
 FPSCounter& Global::GetFPSCounter()
@@ -98,6 +100,16 @@ FPSCounter& Global::GetFPSCounter()
     return m_fps;
 }
 
+FrameStats& Global::GetFrameStats()
+{
+    return m_frameStats;
+}
+
+JobSystem& Global::GetJobSystem()
+{
+    return m_jobSystem;
+}
+
 std::shared_ptr<IECSSystem> Global::GetRuntimeModule(ESystemType e)
 {
     auto it = m_pSystems.find(e);
@@ -111,4 +123,26 @@ std::shared_ptr<IECSSystem> Global::GetRuntimeModule(ESystemType e)
 
         
     }
+}
+
+template<typename T>
+void* Global::ResolveSystem(ESystemType e)
+{
+    auto it = m_pSystems.find(e);
+    if (it == m_pSystems.end())
+        return nullptr;
+    return dynamic_cast<T*>(it->second.get());
+}
+
+void Global::ResolveServices()
+{
+    m_pServices[APPLICATION_SERVICE] = m_pApp.get();
+    m_pServices[ECS_WORLD_SERVICE] = m_pWorld.get();
+
+    m_pServices[eSystem_Event] = ResolveSystem<IEventSystem>(eSystem_Event);
+    m_pServices[eSystem_Animation] = ResolveSystem<IAnimationSystem>(eSystem_Animation);
+    m_pServices[eSystem_Drawing] = ResolveSystem<IDrawingSystem>(eSystem_Drawing);
+    m_pServices[eSystem_Scene] = ResolveSystem<ISceneSystem>(eSystem_Scene);
+    m_pServices[eSystem_Input] = ResolveSystem<IInputSystem>(eSystem_Input);
+    m_pServices[eSystem_Log] = ResolveSystem<ILogSystem>(eSystem_Log);
 }
\ No newline at end of file
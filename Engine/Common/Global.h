@@ -3,10 +3,13 @@
 #include <iostream>
 #include <memory>
 #include <unordered_map>
+#include <type_traits>
 #include <stdint.h>
 
 #include "Vector.h"
 #include "FPS.h"
+#include "FrameStats.h"
+#include "JobSystem.h"
 #include "IECSWorld.h"
 #include "ECSWorld.h"
 #include "Configuration.h"
@@ -21,6 +24,7 @@ namespace Engine
         eSystem_Scene = 3,
         eSystem_Input = 4,
         eSystem_Log = 5,
+        eSystem_Count,
     };
 
     enum ERendererType
@@ -47,6 +51,11 @@ namespace Engine
         Global();
         virtual ~Global();
 
+        // Non-owning pointers resolved whenever a module is registered, each call is a single
+        // load. Ownership stays with the getters below, null once Global starts tearing down.
+        template<typename T>
+        inline T* Get();
+
         std::shared_ptr<IApplication> GetApplication();
         std::shared_ptr<IECSWorld> GetECSWorld();
 
@@ -66,14 +75,17 @@ namespace Engine
         }
 
         FPSCounter& GetFPSCounter();
+        FrameStats& GetFrameStats();
+        JobSystem& GetJobSystem();
 
         template<typename T>
         void RegisterApp()
         {
-            m_pWorld = std::make_shared<ECSWorld>();
+            m_pWorld = std::make_shared<ECSWorld>(&m_jobSystem, &m_frameStats);
             auto app = std::make_shared<T>();
             auto result = std::dynamic_pointer_cast<IApplication>(app);
             m_pApp = result;
+            ResolveServices();
         }
 
         template<typename T>
@@ -86,6 +98,7 @@ namespace Engine
             auto result = std::dynamic_pointer_cast<IECSSystem>(system);
 
             m_pSystems[e] = result;
+            ResolveServices();
         }
 
         template<typename T>
@@ -101,9 +114,20 @@ namespace Engine
         }
 
     private:
+        constexpr static uint32_t APPLICATION_SERVICE = eSystem_Count;
+        constexpr static uint32_t ECS_WORLD_SERVICE = eSystem_Count + 1;
+        constexpr static uint32_t SERVICE_COUNT = eSystem_Count + 2;
+
         std::shared_ptr<IECSSystem> GetRuntimeModule(ESystemType e);
 
+        void ResolveServices();
+
+        template<typename T>
+        void* ResolveSystem(ESystemType e);
+
     private:
+        void* m_pServices[SERVICE_COUNT];
+
         std::shared_ptr<IECSWorld> m_pWorld;
 
         std::shared_ptr<IApplication> m_pApp;
@@ -112,7 +136,32 @@ namespace Engine
 
         Configuration m_config;
         FPSCounter m_fps;
+        FrameStats m_frameStats;
+        JobSystem m_jobSystem;
     };
 
+    template<typename T>
+    inline T* Global::Get()
+    {
+        static_assert(!std::is_same<T, T>::value, "Not a Global service");
+        return nullptr;
+    }
+
+#define DECLARE_GLOBAL_SERVICE(type, slot)                              \
+    template<>                                                          \
+    inline type* Global::Get<type>()                                    \
+    {                                                                   \
+        return static_cast<type*>(m_pServices[slot]);                   \
+    }
+
+    DECLARE_GLOBAL_SERVICE(IApplication, APPLICATION_SERVICE)
+    DECLARE_GLOBAL_SERVICE(IECSWorld, ECS_WORLD_SERVICE)
+    DECLARE_GLOBAL_SERVICE(IEventSystem, eSystem_Event)
+    DECLARE_GLOBAL_SERVICE(IAnimationSystem, eSystem_Animation)
+    DECLARE_GLOBAL_SERVICE(IDrawingSystem, eSystem_Drawing)
+    DECLARE_GLOBAL_SERVICE(ISceneSystem, eSystem_Scene)
+    DECLARE_GLOBAL_SERVICE(IInputSystem, eSystem_Input)
+    DECLARE_GLOBAL_SERVICE(ILogSystem, eSystem_Log)
+
     extern Global* gpGlobal;
 }
\ No newline at end of file
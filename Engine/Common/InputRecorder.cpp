@@ -0,0 +1,192 @@
+#include <string.h>
+
+#include "InputRecorder.h"
+
+using namespace Engine;
+
+namespace
+{
+    template<typename T>
+    inline void Write(uint8_t*& pData, T value)
+    {
+        memcpy(pData, &value, sizeof(T));
+        pData += sizeof(T);
+    }
+
+    template<typename T>
+    inline T Read(const uint8_t*& pData)
+    {
+        T value;
+        memcpy(&value, pData, sizeof(T));
+        pData += sizeof(T);
+        return value;
+    }
+}
+
+InputRecorder::InputRecorder() : m_frameCount(0)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+    Close();
+}
+
+bool InputRecorder::Open(const std::string& path)
+{
+    Close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+
+    uint8_t header[8];
+    auto pData = header;
+    Write<uint32_t>(pData, MAGIC);
+    Write<uint32_t>(pData, VERSION);
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    if (!m_file.flush())
+    {
+        Close();
+        return false;
+    }
+
+    m_frameCount = 0;
+    return true;
+}
+
+void InputRecorder::Close()
+{
+    if (m_file.is_open())
+        m_file.close();
+    m_records.clear();
+}
+
+bool InputRecorder::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+void InputRecorder::RecordInput(EInputEvent event, const InputMsg& msg)
+{
+    m_records.push_back({ event, msg });
+}
+
+bool InputRecorder::EndFrame(float elapsedTime)
+{
+    if (!m_file.is_open())
+        return false;
+
+    m_buffer.resize(sizeof(float) + sizeof(uint32_t) + m_records.size() * RECORD_SIZE);
+    auto pData = m_buffer.data();
+    Write<float>(pData, elapsedTime);
+    Write<uint32_t>(pData, (uint32_t)m_records.size());
+    for (auto& record : m_records)
+    {
+        Write<uint32_t>(pData, (uint32_t)record.event);
+        Write<uint32_t>(pData, record.msg.CtrID());
+        Write<int64_t>(pData, record.msg.Param1());
+        Write<int64_t>(pData, record.msg.Param2());
+    }
+
+    // Flushed per frame so a full disk is noticed here, and a crash loses at most this frame.
+    m_records.clear();
+    if (!m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size()) || !m_file.flush())
+    {
+        Close();
+        return false;
+    }
+
+    m_frameCount++;
+    return true;
+}
+
+uint32_t InputRecorder::GetFrameCount() const
+{
+    return m_frameCount;
+}
+
+InputReplayer::InputReplayer() : m_frameCount(0)
+{
+}
+
+InputReplayer::~InputReplayer()
+{
+    Close();
+}
+
+bool InputReplayer::Open(const std::string& path)
+{
+    Close();
+
+    m_file.open(path, std::ios::binary);
+    if (!m_file)
+        return false;
+
+    uint8_t header[8];
+    if (!m_file.read(reinterpret_cast<char*>(header), sizeof(header)))
+    {
+        Close();
+        return false;
+    }
+
+    const uint8_t* pData = header;
+    auto magic = Read<uint32_t>(pData);
+    auto version = Read<uint32_t>(pData);
+    if (magic != InputRecorder::MAGIC || version != InputRecorder::VERSION)
+    {
+        Close();
+        return false;
+    }
+
+    m_frameCount = 0;
+    return true;
+}
+
+void InputReplayer::Close()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+bool InputReplayer::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+bool InputReplayer::ReadFrame(float& elapsedTime, std::vector<InputRecord>& records)
+{
+    records.clear();
+    if (!m_file.is_open())
+        return false;
+
+    uint8_t frameHeader[sizeof(float) + sizeof(uint32_t)];
+    if (!m_file.read(reinterpret_cast<char*>(frameHeader), sizeof(frameHeader)))
+        return false;
+
+    const uint8_t* pData = frameHeader;
+    elapsedTime = Read<float>(pData);
+    auto count = Read<uint32_t>(pData);
+
+    m_buffer.resize((size_t)count * InputRecorder::RECORD_SIZE);
+    if (count > 0 && !m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size()))
+        return false;
+
+    pData = m_buffer.data();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto event = (EInputEvent)Read<uint32_t>(pData);
+        auto ctrID = Read<uint32_t>(pData);
+        auto param1 = Read<int64_t>(pData);
+        auto param2 = Read<int64_t>(pData);
+        records.push_back({ event, InputMsg(ctrID, param1, param2) });
+    }
+
+    m_frameCount++;
+    return true;
+}
+
+uint32_t InputReplayer::GetFrameCount() const
+{
+    return m_frameCount;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "IInputSystem.h"
+
+namespace Engine
+{
+    struct InputRecord
+    {
+        EInputEvent event;
+        InputMsg msg;
+    };
+
+    // A recording is a header followed by one block per frame:
+    //   header: uint32 magic, uint32 version
+    //   frame:  float elapsedTime, uint32 count, count * { uint32 event, uint32 ctrID, int64 param1, int64 param2 }
+    // Fields are written in host byte order, recordings are meant to be replayed on the same platform.
+    class InputRecorder
+    {
+    public:
+        constexpr static uint32_t MAGIC = 0x52494547;
+        constexpr static uint32_t VERSION = 1;
+        constexpr static uint32_t RECORD_SIZE = 24;
+
+        InputRecorder();
+        virtual ~InputRecorder();
+
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const;
+
+        // Buffered until EndFrame writes the whole frame at once. A failed write closes the
+        // recording and returns false, the frames before it stay readable.
+        void RecordInput(EInputEvent event, const InputMsg& msg);
+        bool EndFrame(float elapsedTime);
+
+        uint32_t GetFrameCount() const;
+
+    private:
+        std::ofstream m_file;
+        std::vector<InputRecord> m_records;
+        std::vector<uint8_t> m_buffer;
+        uint32_t m_frameCount;
+    };
+
+    class InputReplayer
+    {
+    public:
+        InputReplayer();
+        virtual ~InputReplayer();
+
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const;
+
+        // False at the end of the recording, a truncated last frame counts as the end.
+        bool ReadFrame(float& elapsedTime, std::vector<InputRecord>& records);
+
+        uint32_t GetFrameCount() const;
+
+    private:
+        std::ifstream m_file;
+        std::vector<uint8_t> m_buffer;
+        uint32_t m_frameCount;
+    };
+}
\ No newline at end of file
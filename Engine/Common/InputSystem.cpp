@@ -1,6 +1,7 @@
 #include "IInputSystem.h"
 #include "EventSystem.h"
 #include "InputSystem.h"
+#include "AsyncLogger.h"
 
 using namespace Engine;
 
@@ -17,6 +18,9 @@ void InputSystem::Shutdown()
 {
     while (!m_inputQueue.empty())
         m_inputQueue.pop();
+
+    StopRecording();
+    StopReplay();
 }
 
 void InputSystem::Tick(float elapsedTime)
@@ -24,6 +28,9 @@ void InputSystem::Tick(float elapsedTime)
     while (!m_inputQueue.empty())
     {
         auto info = m_inputQueue.front();
+        if (m_recorder.IsOpen())
+            m_recorder.RecordInput(info.event, info.msg);
+
         switch (info.event)
         {
             case eEv_Input_KeyChar:
@@ -84,13 +91,60 @@ void InputSystem::Tick(float elapsedTime)
 
         m_inputQueue.pop();
     }
+
+    if (m_recorder.IsOpen() && !m_recorder.EndFrame(elapsedTime))
+        LOG_ERROR("Input recording stopped, failed to write frame {}", m_recorder.GetFrameCount());
 }
 
-void InputSystem::FlushEntity(IEntity* pEntity)
+void InputSystem::FlushEntity(Entity)
 {
 }
 
 void InputSystem::DispatchInputEvent(EInputEvent event, InputMsg msg)
 {
+    if (IsReplaying())
+        return;
+
     m_inputQueue.emplace(event, msg);
+}
+
+bool InputSystem::StartRecording(const std::string& path)
+{
+    return m_recorder.Open(path);
+}
+
+void InputSystem::StopRecording()
+{
+    m_recorder.Close();
+}
+
+bool InputSystem::StartReplay(const std::string& path)
+{
+    while (!m_inputQueue.empty())
+        m_inputQueue.pop();
+
+    return m_replayer.Open(path);
+}
+
+void InputSystem::StopReplay()
+{
+    m_replayer.Close();
+}
+
+bool InputSystem::IsReplaying() const
+{
+    return m_replayer.IsOpen();
+}
+
+bool InputSystem::BeginReplayFrame(float& elapsedTime)
+{
+    if (!m_replayer.ReadFrame(elapsedTime, m_replayRecords))
+    {
+        StopReplay();
+        return false;
+    }
+
+    for (auto& record : m_replayRecords)
+        m_inputQueue.emplace(record.event, record.msg);
+    return true;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include "IInputSystem.h"
+#include "InputRecorder.h"
 
 #include "ECSSystem.h"
 
@@ -18,11 +19,20 @@ namespace Engine
         void Initialize() override;
         void Shutdown() override;
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "InputSystem"; }
 
-        void FlushEntity(IEntity* pEntity) override;
+        void FlushEntity(Entity entity) override;
 
         void DispatchInputEvent(EInputEvent event, InputMsg msg) override;
 
+        bool StartRecording(const std::string& path) override;
+        void StopRecording() override;
+
+        bool StartReplay(const std::string& path) override;
+        void StopReplay() override;
+        bool IsReplaying() const override;
+        bool BeginReplayFrame(float& elapsedTime) override;
+
     private:
         struct InputMsgInfo
         {
@@ -31,5 +41,9 @@ namespace Engine
             InputMsg msg;
         };
         std::queue<InputMsgInfo> m_inputQueue;
+
+        InputRecorder m_recorder;
+        InputReplayer m_replayer;
+        std::vector<InputRecord> m_replayRecords;
     };
 }
\ No newline at end of file
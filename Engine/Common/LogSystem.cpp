@@ -9,6 +9,8 @@ using namespace Engine;
 
 void LogSystem::Initialize()
 {
+    AsyncLogger::Get().Start(std::cout);
+
     m_logSystemEventFunc = std::bind(&LogSystem::OutputLogSystemStream, this, std::placeholders::_1);
     LISTEN_EVENT(eEv_System_App, m_logSystemEventFunc);
 
@@ -28,17 +30,21 @@ void LogSystem::Shutdown()
     DISPATCH_EVENT(eEv_Input_KeyChar, m_LogInputKeyCharFunc);
     DISPATCH_EVENT(eEv_Input_KeyDown, m_LogInputKeyDownFunc);
     DISPATCH_EVENT(eEv_Input_KeyUp, m_LogInputKeyUpFunc);
+
+    auto stats = AsyncLogger::Get().GetStats();
+    LOG_DEBUG("Log: {} written, {} dropped", stats.writtenCount, stats.droppedCount);
+    AsyncLogger::Get().Stop();
 }
 
-void LogSystem::Tick(float elapsedTime)
+void LogSystem::Tick(float)
 {
 }
 
-void LogSystem::FlushEntity(IEntity* pEntity)
+void LogSystem::FlushEntity(Entity)
 {
 }
 
-void LogSystem::OutputLogSystemStream(LogSystemEventPtr data) const
+void LogSystem::OutputLogSystemStream(const LogSystemEvent& data) const
 {
-    std::cout << data->GetMsg() << std::endl;
+    LOG_INFO("{}", data.GetMsg());
 }
\ No newline at end of file
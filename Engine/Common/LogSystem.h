@@ -1,7 +1,9 @@
 #pragma once
 
+#include <fstream>
 #include <functional>
 
+#include "AsyncLogger.h"
 #include "ILogSystem.h"
 #include "IDrawingSystem.h"
 #include "IInputSystem.h"
@@ -22,14 +24,14 @@ namespace Engine
         void Shutdown() override;
 
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "LogSystem"; }
 
-        void FlushEntity(IEntity* pEntity) override;
+        void FlushEntity(Entity entity) override;
 
     private:
         #define DEF_InputEventType(event, enum)                                         \
             typedef Event<InputMsg, EInputEvent, enum> event;                           \
-            typedef std::shared_ptr<event> event##Ptr;                                  \
-            typedef std::function<void(event##Ptr)> event##Func;                        \
+            typedef std::function<void(const event&)> event##Func;                      \
             event##Func m_##event##Func
 
         DEF_InputEventType(LogInputKeyChar, eEv_Input_KeyChar);
@@ -43,13 +45,12 @@ namespace Engine
         DEF_InputEventType(LogInputControlHover, eEv_Input_ControlHover);
 
         typedef Event<std::string, ESystemEvent, eEv_System_App> LogSystemEvent;
-        typedef std::shared_ptr<LogSystemEvent> LogSystemEventPtr;
-        typedef std::function<void(LogSystemEventPtr)> LogSystemEventFunc;
+        typedef std::function<void(const LogSystemEvent&)> LogSystemEventFunc;
     
-        void OutputLogSystemStream(LogSystemEventPtr data) const;
+        void OutputLogSystemStream(const LogSystemEvent& data) const;
 
         template<EInputEvent e>
-        inline void OutputLogInputStream(std::shared_ptr<Event<InputMsg, EInputEvent, e>> data) const {};
+        inline void OutputLogInputStream(const Event<InputMsg, EInputEvent, e>& data) const {};
 
     private:
         DECLARE_LISTENER();
@@ -57,32 +58,44 @@ namespace Engine
     };
 
     template<>
-    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyChar>(LogInputKeyCharPtr data) const
+    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyChar>(const LogInputKeyChar& data) const
     {
-        auto c = static_cast<char>(data->GetMsg().Param1());
+        auto c = static_cast<char>(data.GetMsg().Param1());
         switch (c)
         {
             case 'f':
-                std::cout << "Avg FPS: " <<
-                            gpGlobal->GetFPSCounter().GetFPSAvgSec() << ", " <<
-                            "Cur FPS: " <<
-                            gpGlobal->GetFPSCounter().GetFPSCurrent() << std::endl;
+            {
+                auto summary = gpGlobal->GetFrameStats().GetFrameSummary();
+                LOG_INFO("Avg FPS: {}, Cur FPS: {}", gpGlobal->GetFPSCounter().GetFPSAvgSec(), gpGlobal->GetFPSCounter().GetFPSCurrent());
+                LOG_INFO("Frame ms p50: {}, p95: {}, p99: {}, max: {}", summary.p50, summary.p95, summary.p99, summary.max);
                 break;
+            }
+            case 'c':
+            {
+                std::ofstream file("FrameStats.csv");
+                gpGlobal->GetFrameStats().WriteCSV(file);
+                LOG_INFO("Frame stats written to FrameStats.csv");
+                break;
+            }
             case 'g':
-                gpGlobal->GetDrawingSystem()->FlipDebugState();
+            {
+                auto pDrawingSystem = gpGlobal->Get<IDrawingSystem>();
+                if (pDrawingSystem != nullptr)
+                    pDrawingSystem->FlipDebugState();
                 break;
+            }
             default:
                 break;
         }
     };
 
     template<>
-    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyDown>(LogInputKeyDownPtr data) const
+    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyDown>(const LogInputKeyDown&) const
     {
     };
 
     template<>
-    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyUp>(LogInputKeyUpPtr data) const
+    inline void LogSystem::OutputLogInputStream<eEv_Input_KeyUp>(const LogInputKeyUp&) const
     {
     };
 }
\ No newline at end of file
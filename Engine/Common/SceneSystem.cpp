@@ -4,18 +4,66 @@
 
 using namespace Engine;
 
+SceneSystem::SceneSystem()
+{
+    // Reading local matrices refreshes their cache, so order it like a writer.
+    DeclareWrite<TransformComponent>();
+    DeclareFixedStep();
+}
+
 void SceneSystem::Initialize()
 {
 }
 
 void SceneSystem::Shutdown()
 {
+    m_hierarchy.Clear();
+}
+
+void SceneSystem::Tick(float)
+{
+    auto version = GetLastVersion();
+    if (m_query.HasStructureChanged(version))
+        RemoveDeadNodes();
+
+    m_query.ForEachChunkChanged(version, [&](uint32_t count, Entity* pEntities, const TransformComponent* pTransforms) {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto& transform = pTransforms[i];
+            if (transform.IsChangedSince(version) || !m_hierarchy.HasNode(pEntities[i]))
+                m_hierarchy.SetNode(pEntities[i], transform.GetParent(), transform.GetLocalMatrix());
+        }
+    });
+
+    m_hierarchy.Update();
+}
+
+void SceneSystem::Interpolate(float alpha)
+{
+    m_hierarchy.Interpolate(alpha);
+}
+
+void SceneSystem::FlushEntity(Entity)
+{
+}
+
+const float4x4* SceneSystem::GetWorldMatrix(Entity entity) const
+{
+    return m_hierarchy.GetInterpolatedMatrix(entity);
 }
 
-void SceneSystem::Tick(float elapsedTime)
+uint32_t SceneSystem::GetLayoutVersion() const
 {
+    return m_hierarchy.GetLayoutVersion();
 }
 
-void SceneSystem::FlushEntity(IEntity* pEntity)
+void SceneSystem::RemoveDeadNodes()
 {
+    // Removal only flags the node, the arrays are compacted by the next Update.
+    auto pEntities = m_hierarchy.GetEntities();
+    for (uint32_t i = 0; i < m_hierarchy.GetNodeCount(); i++)
+    {
+        if (pEntities[i].IsValid() && !m_pWorld->HasComponent<TransformComponent>(pEntities[i]))
+            m_hierarchy.RemoveNode(pEntities[i]);
+    }
 }
\ No newline at end of file
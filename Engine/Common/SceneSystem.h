@@ -3,20 +3,32 @@
 #include "ISceneSystem.h"
 
 #include "ECSSystem.h"
+#include "TransformHierarchy.h"
 
 namespace Engine
 {
     class TransformComponent;
-    class SceneSystem: public ISceneSystem, public ECSSystemBase<TransformComponent>
+    class SceneSystem: public ISceneSystem, public ECSSystemBase<const TransformComponent>
     {
     public:
-        SceneSystem() {}
+        SceneSystem();
         virtual ~SceneSystem() {}
 
         void Initialize() override;
         void Shutdown() override;
         void Tick(float elapsedTime) override;
+        const char* GetName() const override { return "SceneSystem"; }
+        void Interpolate(float alpha) override;
 
-        void FlushEntity(IEntity* pEntity) override;
+        void FlushEntity(Entity entity) override;
+
+        const float4x4* GetWorldMatrix(Entity entity) const override;
+        uint32_t GetLayoutVersion() const override;
+
+    private:
+        void RemoveDeadNodes();
+
+    private:
+        TransformHierarchy m_hierarchy;
     };
 }
\ No newline at end of file
@@ -10,12 +10,18 @@
     using namespace Engine;
     #ifdef PREDEFINE_WINDOWS_APP
         #include "WindowsApplication.h"
-        #define PREDEFINE_APP
+        #define PREDEFINE_APP WindowsApplication
+        #define PREDEFINE_DRAWING
+    #endif
+
+    // No window and no device, everything but drawing runs.
+    #ifdef PREDEFINE_HEADLESS_APP
+        #include "HeadlessApplication.h"
+        #define PREDEFINE_APP HeadlessApplication
     #endif
 
     #ifdef PREDEFINE_APP
         #include "AnimationSystem.h"
-        #include "DrawingSystem.h"
         #include "SceneSystem.h"
 
         #include "AnimationComponent.h"
@@ -30,12 +36,14 @@
 
         #include "DirectionalLight.h"
 
-        #include "ForwardRenderer.h"
-
         using namespace Platform;
         std::vector<AnimationFunc> AnimationSystem::s_cbTables;
     #endif
-    IComponent::CompTableType IComponent::m_compTable;
+
+    #ifdef PREDEFINE_DRAWING
+        #include "DrawingSystem.h"
+        #include "ForwardRenderer.h"
+    #endif
 
     class Setup
     {
@@ -46,7 +54,7 @@
                 gpGlobal = new Global();
 
     #ifdef PREDEFINE_APP
-            gpGlobal->RegisterApp<WindowsApplication>();
+            gpGlobal->RegisterApp<PREDEFINE_APP>();
     #else
             gpGlobal->RegisterApp<BaseApplication>();
     #endif
@@ -57,16 +65,21 @@
     #ifdef PREDEFINE_APP
             gpGlobal->RegisterRuntimeModule<SceneSystem>(eSystem_Scene);
             gpGlobal->RegisterRuntimeModule<AnimationSystem>(eSystem_Animation);
+    #endif
+    #ifdef PREDEFINE_DRAWING
             gpGlobal->RegisterRuntimeModule<DrawingSystem>(eSystem_Drawing);
     #endif
 
-            auto& pWorld = gpGlobal->GetECSWorld();
+            auto pWorld = gpGlobal->GetECSWorld();
 
             pWorld->AddECSSystem(gpGlobal->GetInputSystem());
             pWorld->AddECSSystem(gpGlobal->GetEventSystem());
             pWorld->AddECSSystem(gpGlobal->GetLogSystem());
     #ifdef PREDEFINE_APP
             pWorld->AddECSSystem(gpGlobal->GetAnimationSystem());
+            pWorld->AddECSSystem(gpGlobal->GetSceneSystem());
+    #endif
+    #ifdef PREDEFINE_DRAWING
             pWorld->AddECSSystem(gpGlobal->GetDrawingSystem());
 
             gpGlobal->RegisterRenderer<ForwardRenderer>(eRenderer_Forward);
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <string.h>
+
+#include "TransformHierarchy.h"
+#include "IECSWorld.h"
+
+using namespace Engine;
+
+namespace
+{
+    constexpr uint32_t UNKNOWN_DEPTH = static_cast<uint32_t>(-1);
+    constexpr uint32_t VISITING_DEPTH = static_cast<uint32_t>(-2);
+
+    // result = a * b for row-major matrices, the float4x4 overloads are vectorized.
+    inline void MulMatrix(const float4x4& a, const float4x4& b, float4x4& result)
+    {
+        result = Mat::Mul(a, b);
+    }
+
+    inline void LerpMatrix(const float4x4& a, const float4x4& b, float t, float4x4& result)
+    {
+        for (uint32_t i = 0; i < 4; i++)
+            result[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+TransformHierarchy::TransformHierarchy() : m_dirtyCount(0), m_bLayoutChanged(false), m_layoutVersion(0)
+{
+}
+
+void TransformHierarchy::SetNode(Entity entity, Entity parent, const float4x4& localMatrix)
+{
+    auto node = GetNode(entity);
+    if (node == INVALID_NODE)
+    {
+        node = (uint32_t)m_entities.size();
+        m_entities.emplace_back(entity);
+        m_parentEntities.emplace_back(parent);
+        m_parents.emplace_back(INVALID_NODE);
+        m_localMatrices.emplace_back(localMatrix);
+        m_worldMatrices.emplace_back(localMatrix);
+        m_dirty.emplace_back(0);
+
+        if (entity.index >= m_nodeIndices.size())
+            m_nodeIndices.resize(std::max<size_t>(entity.index + 1, m_nodeIndices.size() * 2), INVALID_NODE);
+        m_nodeIndices[entity.index] = node;
+        m_bLayoutChanged = true;
+    }
+
+    if (m_parentEntities[node] != parent)
+    {
+        m_parentEntities[node] = parent;
+        m_bLayoutChanged = true;
+    }
+
+    m_localMatrices[node] = localMatrix;
+    if (!m_dirty[node])
+    {
+        m_dirty[node] = 1;
+        m_dirtyCount++;
+    }
+}
+
+void TransformHierarchy::RemoveNode(Entity entity)
+{
+    auto node = GetNode(entity);
+    if (node == INVALID_NODE)
+        return;
+
+    // Compacted by the next Sort, children of the node become roots.
+    m_entities[node] = INVALID_ENTITY;
+    m_nodeIndices[entity.index] = INVALID_NODE;
+    m_bLayoutChanged = true;
+}
+
+bool TransformHierarchy::HasNode(Entity entity) const
+{
+    return GetNode(entity) != INVALID_NODE;
+}
+
+void TransformHierarchy::Clear()
+{
+    m_entities.clear();
+    m_parentEntities.clear();
+    m_parents.clear();
+    m_localMatrices.clear();
+    m_worldMatrices.clear();
+    m_prevWorldMatrices.clear();
+    m_interpolatedMatrices.clear();
+    m_dirty.clear();
+    m_nodeIndices.clear();
+    m_movedNodes.clear();
+
+    m_dirtyCount = 0;
+    m_bLayoutChanged = false;
+    m_layoutVersion = IECSWorld::GetGlobalVersion();
+}
+
+void TransformHierarchy::Update()
+{
+    SnapMovedNodes();
+
+    // A reorder starts over from the new layout, that step is not interpolated.
+    if (m_bLayoutChanged)
+    {
+        Sort();
+        Propagate();
+        SnapMovedNodes();
+        return;
+    }
+
+    Propagate();
+}
+
+void TransformHierarchy::Interpolate(float alpha)
+{
+    for (auto node : m_movedNodes)
+        LerpMatrix(m_prevWorldMatrices[node], m_worldMatrices[node], alpha, m_interpolatedMatrices[node]);
+}
+
+uint32_t TransformHierarchy::GetNodeCount() const
+{
+    return (uint32_t)m_entities.size();
+}
+
+uint32_t TransformHierarchy::GetMovedNodeCount() const
+{
+    return (uint32_t)m_movedNodes.size();
+}
+
+const Entity* TransformHierarchy::GetEntities() const
+{
+    return m_entities.data();
+}
+
+const float4x4* TransformHierarchy::GetWorldMatrices() const
+{
+    return m_worldMatrices.data();
+}
+
+const float4x4* TransformHierarchy::GetWorldMatrix(Entity entity) const
+{
+    auto node = GetNode(entity);
+    return node != INVALID_NODE ? &m_worldMatrices[node] : nullptr;
+}
+
+const float4x4* TransformHierarchy::GetInterpolatedMatrices() const
+{
+    return m_interpolatedMatrices.data();
+}
+
+const float4x4* TransformHierarchy::GetInterpolatedMatrix(Entity entity) const
+{
+    auto node = GetNode(entity);
+    return node != INVALID_NODE ? &m_interpolatedMatrices[node] : nullptr;
+}
+
+uint32_t TransformHierarchy::GetLayoutVersion() const
+{
+    return m_layoutVersion;
+}
+
+uint32_t TransformHierarchy::GetNode(Entity entity) const
+{
+    if (!entity.IsValid() || entity.index >= m_nodeIndices.size())
+        return INVALID_NODE;
+
+    auto node = m_nodeIndices[entity.index];
+    return node != INVALID_NODE && m_entities[node] == entity ? node : INVALID_NODE;
+}
+
+void TransformHierarchy::Sort()
+{
+    auto count = (uint32_t)m_entities.size();
+    for (uint32_t i = 0; i < count; i++)
+        m_parents[i] = m_entities[i].IsValid() ? GetNode(m_parentEntities[i]) : INVALID_NODE;
+
+    // Walk up to the first ancestor with a known depth, then assign depths on the way back.
+    // A parent that is still being visited closes a cycle, that link is dropped.
+    std::vector<uint32_t> depths(count, UNKNOWN_DEPTH);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!m_entities[i].IsValid())
+            continue;
+
+        for (auto node = i; node != INVALID_NODE && depths[node] == UNKNOWN_DEPTH; node = m_parents[node])
+        {
+            depths[node] = VISITING_DEPTH;
+            chain.emplace_back(node);
+
+            auto parent = m_parents[node];
+            if (parent != INVALID_NODE && depths[parent] == VISITING_DEPTH)
+                m_parents[node] = INVALID_NODE;
+        }
+
+        for (auto it = chain.rbegin(); it != chain.rend(); it++)
+        {
+            auto parent = m_parents[*it];
+            depths[*it] = parent == INVALID_NODE ? 0 : depths[parent] + 1;
+            maxDepth = std::max(maxDepth, depths[*it]);
+        }
+        chain.clear();
+    }
+
+    // Counting sort by depth keeps siblings in insertion order.
+    std::vector<uint32_t> offsets(maxDepth + 2, 0);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (m_entities[i].IsValid())
+            offsets[depths[i] + 1]++;
+    }
+
+    for (uint32_t depth = 1; depth < offsets.size(); depth++)
+        offsets[depth] += offsets[depth - 1];
+
+    auto sortedCount = offsets.back();
+    std::vector<uint32_t> remap(count, INVALID_NODE);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (m_entities[i].IsValid())
+            remap[i] = offsets[depths[i]]++;
+    }
+
+    std::vector<Entity> entities(sortedCount);
+    std::vector<Entity> parentEntities(sortedCount);
+    std::vector<uint32_t> parents(sortedCount);
+    std::vector<float4x4> localMatrices(sortedCount);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto node = remap[i];
+        if (node == INVALID_NODE)
+            continue;
+
+        entities[node] = m_entities[i];
+        parentEntities[node] = m_parentEntities[i];
+        parents[node] = m_parents[i] != INVALID_NODE ? remap[m_parents[i]] : INVALID_NODE;
+        localMatrices[node] = m_localMatrices[i];
+        m_nodeIndices[m_entities[i].index] = node;
+    }
+
+    m_entities.swap(entities);
+    m_parentEntities.swap(parentEntities);
+    m_parents.swap(parents);
+    m_localMatrices.swap(localMatrices);
+    m_worldMatrices.resize(sortedCount);
+    m_prevWorldMatrices.resize(sortedCount);
+    m_interpolatedMatrices.resize(sortedCount);
+    m_dirty.assign(sortedCount, 1);
+    m_movedNodes.clear();
+
+    m_dirtyCount = sortedCount;
+    m_bLayoutChanged = false;
+    m_layoutVersion = IECSWorld::GetGlobalVersion();
+}
+
+void TransformHierarchy::Propagate()
+{
+    if (m_dirtyCount == 0)
+        return;
+
+    // Parents precede children, so a dirty flag reaches the whole subtree in the same pass.
+    auto count = (uint32_t)m_entities.size();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto parent = m_parents[i];
+        if (parent != INVALID_NODE)
+            m_dirty[i] |= m_dirty[parent];
+
+        if (!m_dirty[i])
+            continue;
+
+        if (parent == INVALID_NODE)
+            m_worldMatrices[i] = m_localMatrices[i];
+        else
+            MulMatrix(m_localMatrices[i], m_worldMatrices[parent], m_worldMatrices[i]);
+        m_movedNodes.emplace_back(i);
+    }
+
+    memset(m_dirty.data(), 0, m_dirty.size());
+    m_dirtyCount = 0;
+}
+
+void TransformHierarchy::SnapMovedNodes()
+{
+    // Nodes left alone by a step keep all three matrices equal, only the moved ones need syncing.
+    for (auto node : m_movedNodes)
+    {
+        m_prevWorldMatrices[node] = m_worldMatrices[node];
+        m_interpolatedMatrices[node] = m_worldMatrices[node];
+    }
+    m_movedNodes.clear();
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "ECSArchetype.h"
+#include "Matrix.h"
+
+namespace Engine
+{
+    // Parent/child transforms stored depth-sorted in parallel arrays, so parents always
+    // precede their children and world matrices are resolved in one linear pass. Only
+    // nodes whose local matrix or an ancestor changed are recomputed.
+    //
+    // Each Update is one simulation step. The previous step's matrices of the nodes it
+    // moved are kept, so Interpolate can blend between the two for rendering.
+    class TransformHierarchy
+    {
+    public:
+        constexpr static uint32_t INVALID_NODE = static_cast<uint32_t>(-1);
+
+        TransformHierarchy();
+        virtual ~TransformHierarchy() = default;
+
+        // Parents missing from the hierarchy make the node a root.
+        void SetNode(Entity entity, Entity parent, const float4x4& localMatrix);
+        void RemoveNode(Entity entity);
+        bool HasNode(Entity entity) const;
+        void Clear();
+
+        void Update();
+
+        // Blends the nodes moved by the last Update towards their new matrices. Matrices are
+        // lerped per element, close enough to the real path for the short span of one step.
+        void Interpolate(float alpha);
+
+        uint32_t GetNodeCount() const;
+        // Nodes whose world matrix the last Update recomputed.
+        uint32_t GetMovedNodeCount() const;
+        const Entity* GetEntities() const;
+        const float4x4* GetWorldMatrices() const;
+        const float4x4* GetWorldMatrix(Entity entity) const;
+        const float4x4* GetInterpolatedMatrices() const;
+        const float4x4* GetInterpolatedMatrix(Entity entity) const;
+
+        // Version of the last reorder, pointers into the world matrices stay valid until it changes.
+        uint32_t GetLayoutVersion() const;
+
+    private:
+        uint32_t GetNode(Entity entity) const;
+        void Sort();
+        void Propagate();
+        void SnapMovedNodes();
+
+    private:
+        std::vector<Entity> m_entities;
+        std::vector<Entity> m_parentEntities;
+        std::vector<uint32_t> m_parents;
+        std::vector<float4x4> m_localMatrices;
+        std::vector<float4x4> m_worldMatrices;
+        std::vector<float4x4> m_prevWorldMatrices;
+        std::vector<float4x4> m_interpolatedMatrices;
+        std::vector<uint8_t> m_dirty;
+
+        std::vector<uint32_t> m_movedNodes;
+
+        std::vector<uint32_t> m_nodeIndices;
+
+        uint32_t m_dirtyCount;
+        bool m_bLayoutChanged;
+        uint32_t m_layoutVersion;
+    };
+}
\ No newline at end of file
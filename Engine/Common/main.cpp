@@ -2,9 +2,13 @@
 #include <stdexcept>
 #include <iostream>
 #include <chrono>
+#include <string>
+#include <string.h>
 
 #include "Global.h"
+#include "FramePacer.h"
 #include "IApplication.h"
+#include "IInputSystem.h"
 
 using namespace Engine;
 
@@ -14,6 +18,18 @@ int main(int argc, char** argv)
     if (!g_pApp)
         return 0;
 
+    // --record <file> saves input and frame times, --replay <file> feeds a recording back
+    // in place of live input and wall-clock time and quits at its end.
+    std::string recordPath;
+    std::string replayPath;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--record") == 0)
+            recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0)
+            replayPath = argv[++i];
+    }
+
     try
     {
         g_pApp->Initialize();
@@ -24,14 +40,42 @@ int main(int argc, char** argv)
         return -1;
     }
 
+    auto pInputSystem = gpGlobal->GetInputSystem();
+    if (pInputSystem && !recordPath.empty() && !pInputSystem->StartRecording(recordPath))
+        std::cout << "Cannot record to " << recordPath << std::endl;
+    if (pInputSystem && !replayPath.empty() && !pInputSystem->StartReplay(replayPath))
+        std::cout << "Cannot replay " << replayPath << std::endl;
+
+    bool bReplay = pInputSystem && pInputSystem->IsReplaying();
+    uint32_t replayFrameCount = 0;
+    auto replayStartTime = std::chrono::steady_clock::now();
+
+    // Frames are timed start to start, so time spent waiting counts towards the simulation.
+    // A replay runs unpaced on its recorded frame times.
+    auto& timeConfig = gpGlobal->GetConfiguration<TimeConfiguration>();
+    FramePacer pacer;
+    pacer.SetTargetFrameRate(bReplay ? 0 : timeConfig.GetTargetFrameRate());
+    pacer.SetPacing(timeConfig.GetFramePacing());
+
+    auto& frameStats = gpGlobal->GetFrameStats();
+    auto pacingPhase = frameStats.RegisterPhase("Pacing");
+
     while (!g_pApp->IsQuit()) {
         try
         {
             auto& fpsCounter = gpGlobal->GetFPSCounter();
 
+            auto pacingBeginTime = FrameStats::Clock::now();
+            auto elapsedTime = pacer.BeginFrame();
+            frameStats.AddPhaseTime(pacingPhase, FrameStats::Clock::now() - pacingBeginTime);
+            if (bReplay && !pInputSystem->BeginReplayFrame(elapsedTime))
+                break;
+
             fpsCounter.BeginTick();
-            g_pApp->Tick(fpsCounter.GetElapsedTime());
+            g_pApp->Tick(elapsedTime);
             fpsCounter.EndTick();
+            frameStats.EndFrame();
+            replayFrameCount++;
         }
         catch (const std::runtime_error& e)
         {
@@ -40,6 +84,12 @@ int main(int argc, char** argv)
         }
     }
 
+    if (bReplay)
+    {
+        std::chrono::duration<float, std::milli> replayTime = std::chrono::steady_clock::now() - replayStartTime;
+        std::cout << "Replayed " << replayFrameCount << " frames in " << replayTime.count() << " ms" << std::endl;
+    }
+
     g_pApp->Shutdown();
 
     return 0;
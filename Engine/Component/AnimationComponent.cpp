@@ -10,6 +10,7 @@ void AnimationComponent::SetAnimationFunc(AnimationFunc& func)
     auto size = AnimationSystem::s_cbTables.size();
     m_cbID = (uint32_t)size;
     AnimationSystem::s_cbTables.emplace_back(func);
+    MarkChanged();
 }
 
 const AnimationFunc& AnimationComponent::GetAnimationFunc()
@@ -27,6 +27,7 @@ ERendererType CameraComponent::GetRendererType() const
 void CameraComponent::SetRendererType(ERendererType type)
 {
     m_rendererType = type;
+    MarkChanged();
 }
 
 EProjectionType CameraComponent::GetProjectionType() const
@@ -37,6 +38,7 @@ EProjectionType CameraComponent::GetProjectionType() const
 void CameraComponent::SetProjectionType(EProjectionType type)
 {
     m_projType = type;
+    MarkChanged();
 }
 
 EClearType CameraComponent::GetClearType() const
@@ -47,6 +49,7 @@ EClearType CameraComponent::GetClearType() const
 void CameraComponent::SetClearType(EClearType type)
 {
     m_clearType = type;
+    MarkChanged();
 }
 
 float4 CameraComponent::GetBackground() const
@@ -57,6 +60,7 @@ float4 CameraComponent::GetBackground() const
 void CameraComponent::SetBackground(float4& color)
 {
     m_background = color;
+    MarkChanged();
 }
 
 float CameraComponent::GetFov() const
@@ -67,6 +71,7 @@ float CameraComponent::GetFov() const
 void CameraComponent::SetFov(float fov)
 {
     m_fov = fov;
+    MarkChanged();
 }
 
 float CameraComponent::GetClippingNear() const
@@ -77,6 +82,7 @@ float CameraComponent::GetClippingNear() const
 void CameraComponent::SetClippingNear(float near)
 {
     m_clippingNear = near;
+    MarkChanged();
 }
 
 float CameraComponent::GetClippingFar() const
@@ -87,4 +93,5 @@ float CameraComponent::GetClippingFar() const
 void CameraComponent::SetClippingFar(float far)
 {
     m_clippingFar = far;
+    MarkChanged();
 }
\ No newline at end of file
@@ -1,11 +1,19 @@
+#include <stdexcept>
+#include <string>
+
 #include "Component.h"
 #include "TransformComponent.h"
 
 using namespace Engine;
 
-uint32_t IComponent::RegisterComponent(CreateCompFunc createFunc, DestroyCompFunc destroyFunc, uint32_t size)
+uint32_t IComponent::RegisterComponent(CreateCompFunc createFunc, RelocateCompFunc relocateFunc, DestroyCompFunc destroyFunc, uint32_t size, uint32_t alignment)
 {
-    CompID id = (CompID)m_compTable.size();
-    m_compTable.emplace_back(CompType(createFunc, destroyFunc, size));
+    // Types register on first use, possibly on several workers at once. Entries never move
+    // and each one is filled before its ID is handed out.
+    CompID id = GetCompCount().fetch_add(1, std::memory_order_relaxed);
+    if (id >= ECSArchetype::MAX_COMPONENTS)
+        throw std::runtime_error("Too many component types, CompBitset has " + std::to_string(ECSArchetype::MAX_COMPONENTS) + " bits");
+
+    GetCompTable()[id] = CompType(createFunc, relocateFunc, destroyFunc, size, alignment);
     return id;
 }
\ No newline at end of file
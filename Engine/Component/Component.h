@@ -6,57 +6,43 @@
 namespace Engine
 {
     template<typename T>
-    class ComponentBase : public IComponent
+    auto createFunc = [](const IComponent* pComponent, void* pMemory) -> IComponent*
     {
-    public:
-        inline ComponentBase()
-        {
-            if (m_compID != static_cast<uint32_t>(-1))
-                return;
-
-            m_createFunc = createFunc<T>;
-            m_destroyFunc = destroyFunc<T>;
-            m_size = sizeof(T);
-            m_compID = RegisterComponent(ComponentBase<T>::m_createFunc, ComponentBase<T>::m_destroyFunc, ComponentBase<T>::m_size);
-        }
-
-        inline virtual ~ComponentBase()
-        {
-        }
-
-        inline static CompID m_compID = static_cast<uint32_t>(-1);
-        inline static CreateCompFunc m_createFunc;
-        inline static DestroyCompFunc m_destroyFunc;
-        inline static uint32_t m_size;
-        inline static uint32_t m_size2;
+        T* pComp = new(pMemory)T(*static_cast<const T*>(pComponent));
+        return pComp;
     };
 
     template<typename T>
-    auto createFunc = [](IComponent* pComponent, std::shared_ptr<IEntity> pEntity, std::vector<uint8_t>& memory) -> CompIndex
+    auto relocateFunc = [](void* pSrc, void* pDst) -> void
     {
-        CompIndex index = (CompIndex)memory.size();
-        memory.resize(index + T::m_size);
-        T* pComp = new(&memory[index])T(*(T*)pComponent);
-        pComp->m_pEntity = pEntity;
-        return index;
+        T* pComp = static_cast<T*>(pSrc);
+        new(pDst)T(std::move(*pComp));
+        pComp->~T();
     };
 
     template<typename T>
-    auto destroyFunc = [](IComponent* pComponent) -> void
+    auto destroyFunc = [](void* pMemory) -> void
     {
-        T* pComp = (T*)pComponent;
+        T* pComp = static_cast<T*>(pMemory);
         pComp->~T();
     };
 
     template<typename T>
-    CreateCompFunc ComponentBase<T>::m_createFunc;
-
-    template<typename T>
-    DestroyCompFunc ComponentBase<T>::m_destroyFunc;
+    class ComponentBase : public IComponent
+    {
+    public:
+        inline ComponentBase()
+        {
+        }
 
-    template<typename T>
-    uint32_t ComponentBase<T>::m_size;
+        inline virtual ~ComponentBase()
+        {
+        }
 
-    template<typename T>
-    CompID ComponentBase<T>::m_compID;
-}
+        inline static CompID GetCompID()
+        {
+            static const CompID compID = RegisterComponent(createFunc<T>, relocateFunc<T>, destroyFunc<T>, sizeof(T), alignof(T));
+            return compID;
+        }
+    };
+}
\ No newline at end of file
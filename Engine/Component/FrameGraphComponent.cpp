@@ -10,4 +10,5 @@ std::shared_ptr<FrameGraph> FrameGraphComponent::GetFrameGraph() const
 void FrameGraphComponent::SetFrameGraph(std::shared_ptr<FrameGraph> pFrameGraph)
 {
     m_pFrameGraph = pFrameGraph;
+    MarkChanged();
 }
\ No newline at end of file
@@ -10,4 +10,5 @@ std::shared_ptr<ILight> LightComponent::GetLight() const
 void LightComponent::SetLight(std::shared_ptr<ILight> pLight)
 {
     m_pLight = pLight;
+    MarkChanged();
 }
\ No newline at end of file
@@ -10,4 +10,5 @@ std::shared_ptr<IMesh> MeshFilterComponent::GetMesh() const
 void MeshFilterComponent::SetMesh(std::shared_ptr<IMesh> pMesh)
 {
     m_pMesh = pMesh;
+    MarkChanged();
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ void MeshRendererComponent::SetMaterialSize(uint32_t size)
 {
     m_materialSize = size;
     m_pMaterialList.resize(m_materialSize);
+    MarkChanged();
 }
 
 std::shared_ptr<IMaterial> MeshRendererComponent::GetMaterial(uint32_t index) const
@@ -35,4 +36,5 @@ void MeshRendererComponent::SetMaterial(std::shared_ptr<IMaterial> pMaterial, ui
 {
     assert(index < m_materialSize);
     m_pMaterialList[index] = pMaterial;
+    MarkChanged();
 }
\ No newline at end of file
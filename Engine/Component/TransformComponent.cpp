@@ -3,7 +3,7 @@
 using namespace Engine;
 
 TransformComponent::TransformComponent() : ComponentBase<TransformComponent>(),
-    m_scale(1.0f, 1.0f, 1.0f), m_quaternion(0.0f, 0.0f, 0.0f, 1.0f)
+    m_scale(1.0f, 1.0f, 1.0f), m_parent(INVALID_ENTITY), m_bLocalMatrixDirty(true)
 {
 }
 
@@ -12,29 +12,37 @@ float3 TransformComponent::GetPosition() const
     return m_position;
 }
 
-void TransformComponent::SetPosition(float3& pos)
+void TransformComponent::SetPosition(const float3& pos)
 {
     m_position = pos;
+    m_bLocalMatrixDirty = true;
+    MarkChanged();
 }
 
 float3 TransformComponent::GetRotate() const
 {
-    return m_rotate;
+    float3 rotate;
+    m_quaternion.ToEulerAngles(rotate.x, rotate.y, rotate.z);
+    return rotate;
 }
 
-void TransformComponent::SetRotate(float3& rotate)
+void TransformComponent::SetRotate(const float3& rotate)
 {
-    m_rotate = rotate;
+    m_quaternion = quat::EulerAngles(rotate.x, rotate.y, rotate.z);
+    m_bLocalMatrixDirty = true;
+    MarkChanged();
 }
 
-float4 TransformComponent::GetQuaternion() const
+quat TransformComponent::GetQuaternion() const
 {
     return m_quaternion;
 }
 
-void TransformComponent::SetQuaternion(float4& quaternion)
+void TransformComponent::SetQuaternion(const quat& quaternion)
 {
     m_quaternion = quaternion;
+    m_bLocalMatrixDirty = true;
+    MarkChanged();
 }
 
 float3 TransformComponent::GetScale() const
@@ -42,7 +50,34 @@ float3 TransformComponent::GetScale() const
     return m_scale;
 }
 
-void TransformComponent::SetScale(float3& scale)
+void TransformComponent::SetScale(const float3& scale)
 {
     m_scale = scale;
+    m_bLocalMatrixDirty = true;
+    MarkChanged();
+}
+
+Entity TransformComponent::GetParent() const
+{
+    return m_parent;
+}
+
+void TransformComponent::SetParent(Entity parent)
+{
+    m_parent = parent;
+    MarkChanged();
+}
+
+const float4x4& TransformComponent::GetLocalMatrix() const
+{
+    if (m_bLocalMatrixDirty)
+        UpdateLocalMatrix();
+
+    return m_localMatrix;
+}
+
+void TransformComponent::UpdateLocalMatrix() const
+{
+    m_localMatrix = Mat::ComposeTRS(m_position, m_quaternion, m_scale);
+    m_bLocalMatrixDirty = false;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Vector.h"
+#include "Matrix.h"
+#include "Quaternion.h"
 
 #include "Component.h"
 
@@ -13,21 +15,35 @@ namespace Engine
         virtual ~TransformComponent() = default;
 
         float3 GetPosition() const;
-        void SetPosition(float3& pos);
+        void SetPosition(const float3& pos);
 
+        // Euler angles in degrees, a view of the quaternion rather than a second rotation.
         float3 GetRotate() const;
-        void SetRotate(float3& rotate);
+        void SetRotate(const float3& rotate);
 
-        float4 GetQuaternion() const;
-        void SetQuaternion(float4& quaternion);
+        quat GetQuaternion() const;
+        void SetQuaternion(const quat& quaternion);
 
         float3 GetScale() const;
-        void SetScale(float3& scale);
+        void SetScale(const float3& scale);
+
+        // Transforms are relative to the parent, INVALID_ENTITY makes this a root.
+        Entity GetParent() const;
+        void SetParent(Entity parent);
+
+        // Rebuilt on first use after a setter, static transforms never pay for it again.
+        const float4x4& GetLocalMatrix() const;
+
+    private:
+        void UpdateLocalMatrix() const;
 
     private:
         float3 m_position;
-        float3 m_rotate;
-        float4 m_quaternion;
+        quat m_quaternion;
         float3 m_scale;
+        Entity m_parent;
+
+        mutable float4x4 m_localMatrix;
+        mutable bool m_bLocalMatrixDirty;
     };
 }
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <math.h>
+#include <string.h>
+
 #include "GLTF2Loader.h"
 
 #include "Texture.h"
@@ -17,11 +20,16 @@ GLTF2Loader::~GLTF2Loader()
 }
 
 void GLTF2Loader::Load(std::string filename)
+{
+    Load(gltf2::load(filename));
+}
+
+void GLTF2Loader::Load(gltf2::Asset asset)
 {
     m_pMeshes.clear();
     m_pMaterials.clear();
 
-    m_asset = gltf2::load(filename);
+    m_asset = std::move(asset);
 
     LoadMaterials();
     LoadMeshes();
@@ -29,33 +37,47 @@ void GLTF2Loader::Load(std::string filename)
 
 void GLTF2Loader::ApplyToWorld()
 {
-    auto& pWorld = gpGlobal->GetECSWorld();
-
-    auto nodes = m_asset.nodes;
-    auto meshes = m_asset.meshes;
-
-    std::for_each(nodes.begin(), nodes.end(), [&](gltf2::Node& aNode){
-        auto mesh = meshes[aNode.mesh];
-
-        auto pMaterial = m_pMaterials[mesh.primitives[0].material];
-        auto pMesh = m_pMeshes[aNode.mesh];
+    auto& nodes = m_asset.nodes;
 
-        TransformComponent transformComp;
-        MeshFilterComponent meshFilterComp;
-        MeshRendererComponent meshRendererComp;
+    // Walk the node graph from the roots, parents are created before their children.
+    std::vector<uint32_t> roots;
+    if (!m_asset.scenes.empty())
+    {
+        auto scene = m_asset.scene >= 0 && m_asset.scene < (int32_t)m_asset.scenes.size() ? m_asset.scene : 0;
+        roots = m_asset.scenes[scene].nodes;
+    }
+    else
+    {
+        std::vector<bool> bChildren(nodes.size(), false);
+        for (auto& aNode : nodes)
+        {
+            for (auto child : aNode.children)
+                bChildren[child] = true;
+        }
 
-        float x = aNode.rotation[0];
-        float y = aNode.rotation[1];
-        float z = aNode.rotation[2];
-        float w = aNode.rotation[3];
+        for (uint32_t i = 0; i < nodes.size(); i++)
+        {
+            if (!bChildren[i])
+                roots.emplace_back(i);
+        }
+    }
 
-        transformComp.SetQuaternion(float4(x, y, z, w));
-        meshFilterComp.SetMesh(std::shared_ptr<IMesh>(pMesh));
-        meshRendererComp.SetMaterialSize(1);
-        meshRendererComp.SetMaterial(std::shared_ptr<IMaterial>(pMaterial));
+    // Explicit stack, imported hierarchies can be far deeper than the call stack allows.
+    std::vector<std::pair<uint32_t, Entity>> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); it++)
+        stack.emplace_back(*it, INVALID_ENTITY);
 
-        pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(transformComp, meshFilterComp, meshRendererComp);
-    });
+    while (!stack.empty())
+    {
+        auto node = stack.back().first;
+        auto parent = stack.back().second;
+        stack.pop_back();
+
+        auto entity = CreateEntity(nodes[node], parent);
+        auto& children = nodes[node].children;
+        for (auto it = children.rbegin(); it != children.rend(); it++)
+            stack.emplace_back(*it, entity);
+    }
 }
 
 void GLTF2Loader::LoadMaterials()
@@ -77,7 +99,7 @@ void GLTF2Loader::LoadMaterials()
         pMaterial->SetRoughness(roughness);
         pMaterial->SetEmissive(emissive);
 
-        uint32_t index = -1;
+        int32_t index = -1;
         if ((index = aMaterial.pbr.baseColorTexture.index) != -1)
         {
             auto baseColorTexture = images[textures[index].source].uri;
@@ -104,7 +126,7 @@ void GLTF2Loader::LoadMaterials()
             pMaterial->SetEmissiveMap(std::shared_ptr<ITexture>(new Texture(emissiveTexture)));
         }
 
-        m_pMaterials.push_back(pMaterial);
+        m_pMaterials.push_back(std::shared_ptr<StandardMaterial>(pMaterial));
     });
 }
 
@@ -162,7 +184,51 @@ void GLTF2Loader::LoadMeshes()
 
             pMesh->AttachIndexData(data, subsize, count);
 
-            m_pMeshes.push_back(pMesh);
+            m_pMeshes.push_back(std::shared_ptr<Mesh>(pMesh));
         });
     });
+}
+
+Entity GLTF2Loader::CreateEntity(const gltf2::Node& aNode, Entity parent)
+{
+    auto pWorld = gpGlobal->GetECSWorld();
+
+    float3 translation(aNode.translation[0], aNode.translation[1], aNode.translation[2]);
+    quat rotation(aNode.rotation[0], aNode.rotation[1], aNode.rotation[2], aNode.rotation[3]);
+    float3 scale(aNode.scale[0], aNode.scale[1], aNode.scale[2]);
+
+    // A node carries either TRS or a matrix. The column-major, column-vector glTF matrix
+    // has the same memory layout as our row-major, row-vector one.
+    auto m = aNode.matrix;
+    float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    if (memcmp(m, identity, sizeof(identity)) != 0)
+    {
+        translation = float3(m[12], m[13], m[14]);
+        scale = float3(Vec::Length(float3(m[0], m[1], m[2])), Vec::Length(float3(m[4], m[5], m[6])), Vec::Length(float3(m[8], m[9], m[10])));
+
+        // The upper 3x3 rows with the scale divided out are the rotation.
+        rotation = quat::FromMatrix(float3x3(m[0] / scale.x, m[1] / scale.x, m[2] / scale.x,
+                                             m[4] / scale.y, m[5] / scale.y, m[6] / scale.y,
+                                             m[8] / scale.z, m[9] / scale.z, m[10] / scale.z));
+    }
+
+    TransformComponent transformComp;
+    transformComp.SetParent(parent);
+    transformComp.SetPosition(translation);
+    transformComp.SetQuaternion(rotation);
+    transformComp.SetScale(scale);
+
+    if (aNode.mesh < 0)
+        return pWorld->CreateEntity<TransformComponent>(transformComp);
+
+    auto& mesh = m_asset.meshes[aNode.mesh];
+
+    MeshFilterComponent meshFilterComp;
+    MeshRendererComponent meshRendererComp;
+
+    meshFilterComp.SetMesh(m_pMeshes[aNode.mesh]);
+    meshRendererComp.SetMaterialSize(1);
+    meshRendererComp.SetMaterial(m_pMaterials[mesh.primitives[0].material]);
+
+    return pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(transformComp, meshFilterComp, meshRendererComp);
 }
\ No newline at end of file
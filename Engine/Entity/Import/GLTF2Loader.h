@@ -18,16 +18,20 @@ namespace Engine
         virtual ~GLTF2Loader();
 
         void Load(std::string filename);
+        // An asset parsed elsewhere or built in code.
+        void Load(gltf2::Asset asset);
         void ApplyToWorld();
 
     protected:
         void LoadMaterials();
         void LoadMeshes();
 
+        Entity CreateEntity(const gltf2::Node& aNode, Entity parent);
+
     private:
         gltf2::Asset m_asset;
 
-        std::vector<Mesh*> m_pMeshes;
-        std::vector<StandardMaterial*> m_pMaterials;
+        std::vector<std::shared_ptr<Mesh>> m_pMeshes;
+        std::vector<std::shared_ptr<StandardMaterial>> m_pMaterials;
     };
 }
\ No newline at end of file
@@ -14,12 +14,12 @@ Mesh::~Mesh()
     m_indexCount = 0;
 }
 
-void Mesh::GetRenderable(RenderQueue &queue, const TransformComponent* pTransformComp) const
+void Mesh::GetRenderable(RenderQueue &queue, const float4x4* pWorldMatrix) const
 {
     const IRenderable* renderable = this;
 
     ERenderQueueType type = ERenderQueueType::Opaque;
-    auto pMesh = queue.Add<Mesh>(type, RenderQueueItem { renderable, pTransformComp });
+    queue.Add<Mesh>(type, RenderQueueItem { renderable, pWorldMatrix });
 }
 
 const std::vector<std::shared_ptr<Attribute>> Mesh::GetAttributes() const
@@ -32,17 +32,17 @@ const std::shared_ptr<char> Mesh::GetIndexData() const
     return m_pIndexData;
 }
 
-const uint32_t Mesh::IndexSize() const
+uint32_t Mesh::IndexSize() const
 {
     return m_indexSize;
 }
 
-const uint32_t Mesh::VertexCount() const
+uint32_t Mesh::VertexCount() const
 {
     return m_vertexCount;
 }
 
-const uint32_t Mesh::IndexCount() const
+uint32_t Mesh::IndexCount() const
 {
     return m_indexCount;
 }
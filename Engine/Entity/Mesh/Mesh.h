@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <vector>
+#include <string.h>
 
 #include "IMesh.h"
 #include "IRenderable.h"
@@ -14,14 +15,14 @@ namespace Engine
         Mesh();
         virtual ~Mesh();
 
-        void GetRenderable(RenderQueue &queue, const TransformComponent* pTransformComp) const override;
+        void GetRenderable(RenderQueue &queue, const float4x4* pWorldMatrix) const override;
 
         const std::vector<std::shared_ptr<Attribute>> GetAttributes() const override;
         const std::shared_ptr<char> GetIndexData() const override;
-        const uint32_t IndexSize() const override;
+        uint32_t IndexSize() const override;
 
-        const uint32_t VertexCount() const override;
-        const uint32_t IndexCount() const override;
+        uint32_t VertexCount() const override;
+        uint32_t IndexCount() const override;
 
         void AttachVertexData(const char array[], const uint32_t size, const uint32_t count, Attribute::ESemanticType type, std::string name) override;
         void AttachIndexData(const char array[], const uint32_t size, const uint32_t count) override;
@@ -4,6 +4,7 @@
 
 #include "Macros.h"
 #include "DrawingRawResource_D3D11.h"
+#include "DrawingReflection.h"
 
 using namespace Engine;
 
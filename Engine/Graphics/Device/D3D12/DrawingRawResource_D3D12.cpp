@@ -1,5 +1,6 @@
 #include "Macros.h"
 #include "DrawingRawResource_D3D12.h"
+#include "DrawingReflection.h"
 
 using namespace Engine;
 
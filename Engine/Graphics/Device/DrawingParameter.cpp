@@ -34,42 +34,42 @@ const uint32_t DrawingParameter::BasicTypeSize[eBasic_Count] =
     sizeof(double),
 };
 
-const uint32_t DrawingParameter::GetBitsValue(uint32_t val, uint32_t bits, uint32_t offset)
+uint32_t DrawingParameter::GetBitsValue(uint32_t val, uint32_t bits, uint32_t offset)
 {
     return ((val >> offset) & ((0x1 << bits) - 1));
 }
 
-const uint32_t DrawingParameter::GetObjectType(uint32_t type)
+uint32_t DrawingParameter::GetObjectType(uint32_t type)
 {
     return GetBitsValue(type, Object_Type_Bits, Object_Type_Offset);
 }
 
-const uint32_t DrawingParameter::GetDataSetType(uint32_t type)
+uint32_t DrawingParameter::GetDataSetType(uint32_t type)
 {
     return GetBitsValue(type, DataSet_Type_Bits, DataSet_Type_Offset);
 }
 
-const uint32_t DrawingParameter::GetBasicType(uint32_t type)
+uint32_t DrawingParameter::GetBasicType(uint32_t type)
 {
     return GetBitsValue(type, Basic_Type_Bits, Basic_Type_Offset);
 }
 
-const uint32_t DrawingParameter::GetArraySize(uint32_t type)
+uint32_t DrawingParameter::GetArraySize(uint32_t type)
 {
     return GetBitsValue(type, Array_Size_Bits, Array_Size_Offset);
 }
 
-const uint32_t DrawingParameter::GetRowSize(uint32_t type)
+uint32_t DrawingParameter::GetRowSize(uint32_t type)
 {
     return GetBitsValue(type, Row_Size_Bits, Row_Size_Offset);
 }
 
-const uint32_t DrawingParameter::GetColSize(uint32_t type)
+uint32_t DrawingParameter::GetColSize(uint32_t type)
 {
     return GetBitsValue(type, Col_Size_Bits, Col_Size_Offset);
 }
 
-const uint32_t DrawingParameter::GetStructSize(uint32_t type)
+uint32_t DrawingParameter::GetStructSize(uint32_t type)
 {
     return GetBitsValue(type, Struct_Size_Bits, Struct_Size_Offset);
 }
@@ -124,7 +124,7 @@ void DrawingParameter::SetType(uint32_t type)
     m_type = type;
 }
 
-const void* const DrawingParameter::GetValuePtr() const
+const void* DrawingParameter::GetValuePtr() const
 {
     return m_pValue;
 }
@@ -1038,7 +1038,7 @@ void DrawingParameter::AsScalarArray(const T* val, uint32_t array_size)
 }
 
 template <typename T, EBasicType type, uint32_t size>
-const T* const DrawingParameter::AsVectorArray(uint32_t& array_size) const
+const T* DrawingParameter::AsVectorArray(uint32_t& array_size) const
 {
     assert(GetObjectType() == eObject_Value);
     assert(GetDataSetType() == eDataSet_Vector);
@@ -1060,7 +1060,7 @@ void DrawingParameter::AsVectorArray(const T* val, uint32_t array_size)
 }
 
 template <typename T, EBasicType type, uint32_t row_size, uint32_t col_size>
-const T* const DrawingParameter::AsMatrixArray(uint32_t& array_size) const
+const T* DrawingParameter::AsMatrixArray(uint32_t& array_size) const
 {
     assert(GetObjectType() == eObject_Value);
     assert(GetDataSetType() == eDataSet_Matrix);
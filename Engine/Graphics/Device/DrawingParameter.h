@@ -146,14 +146,14 @@ namespace Engine
         DrawingParameter(const std::shared_ptr<std::string> pName, uint32_t type, void* pInitVal = nullptr, const std::shared_ptr<std::string> pSemantic = nullptr);
         virtual ~DrawingParameter();
 
-        static const uint32_t GetBitsValue(uint32_t val, uint32_t bits, uint32_t offset);
-        static const uint32_t GetObjectType(uint32_t type);
-        static const uint32_t GetDataSetType(uint32_t type);
-        static const uint32_t GetBasicType(uint32_t type);
-        static const uint32_t GetArraySize(uint32_t type);
-        static const uint32_t GetRowSize(uint32_t type);
-        static const uint32_t GetColSize(uint32_t type);
-        static const uint32_t GetStructSize(uint32_t type);
+        static uint32_t GetBitsValue(uint32_t val, uint32_t bits, uint32_t offset);
+        static uint32_t GetObjectType(uint32_t type);
+        static uint32_t GetDataSetType(uint32_t type);
+        static uint32_t GetBasicType(uint32_t type);
+        static uint32_t GetArraySize(uint32_t type);
+        static uint32_t GetRowSize(uint32_t type);
+        static uint32_t GetColSize(uint32_t type);
+        static uint32_t GetStructSize(uint32_t type);
 
         std::shared_ptr<std::string> GetName() const;
         void SetName(std::shared_ptr<std::string> pName);
@@ -170,7 +170,7 @@ namespace Engine
         uint32_t GetType() const;
         void SetType(uint32_t type);
 
-        const void* const GetValuePtr() const;
+        const void* GetValuePtr() const;
         uint32_t GetValueSize() const;
 
         void SetValue(const void* pInitVal, uint32_t size);
@@ -368,12 +368,12 @@ namespace Engine
         void AsScalarArray(const T* val, uint32_t array_size);
 
         template <typename T, EBasicType type, uint32_t size>
-        const T* const AsVectorArray(uint32_t& array_size) const;
+        const T* AsVectorArray(uint32_t& array_size) const;
         template <typename T, EBasicType type, uint32_t size>
         void AsVectorArray(const T* val, uint32_t array_size);
 
         template <typename T, EBasicType type, uint32_t row_size, uint32_t col_size>
-        const T* const AsMatrixArray(uint32_t& array_size) const;
+        const T* AsMatrixArray(uint32_t& array_size) const;
         template <typename T, EBasicType type, uint32_t row_size, uint32_t col_size>
         void AsMatrixArray(const T* val, uint32_t array_size);
 
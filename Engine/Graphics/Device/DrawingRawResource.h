@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <string.h>
 #include <assert.h>
 #include <unordered_set>
 #include <unordered_map>
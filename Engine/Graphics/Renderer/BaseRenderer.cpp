@@ -127,7 +127,7 @@ void BaseRenderer::AddRenderables(RenderQueueItemListType renderables)
 {
     m_renderQueue.Reset();
     for (auto& item : renderables)
-        item.pRenderable->GetRenderable(m_renderQueue, item.pTransformComp);
+        item.pRenderable->GetRenderable(m_renderQueue, item.pWorldMatrix);
 }
 
 void BaseRenderer::Clear(DrawingResourceTable& resTable, std::shared_ptr<DrawingPass> pPass)
@@ -141,8 +141,7 @@ void BaseRenderer::Render(DrawingResourceTable& resTable, std::shared_ptr<Drawin
         if (pMesh == nullptr)
             return;
 
-        auto trans = UpdateWorldMatrix(item.pTransformComp);
-        m_pDeviceContext->UpdateTransform(resTable, trans);
+        m_pDeviceContext->UpdateTransform(resTable, *item.pWorldMatrix);
 
         BeginDrawPass();
         AttachMesh(pMesh);
@@ -1314,44 +1313,4 @@ void BaseRenderer::UpdateRectPrimitive(DrawingResourceTable& resTable)
     pPrimitive->SetVertexOffset(0);
     pPrimitive->SetIndexOffset(0);
     pPrimitive->SetInstanceOffset(0);
-}
-
-float4x4 BaseRenderer::UpdateWorldMatrix(const TransformComponent* pTransform)
-{
-    float3 position = pTransform->GetPosition();
-    float3 rotate = pTransform->GetRotate();
-    float3 scale = pTransform->GetScale();
-    float4 quaternion = pTransform->GetQuaternion();
-
-    float4x4 posMatrix = {
-        1.f, 0.f, 0.f, 0.f,
-        0.f, 1.f, 0.f, 0.f,
-        0.f, 0.f, 1.f, 0.f,
-        position.x, position.y, position.z, 1.f
-    };
-
-    auto rotMat = Mat::EulerRotateLH(rotate.x, rotate.y, rotate.z);
-    float4x4 rotMatrix = {
-        rotMat.x00, rotMat.x01, rotMat.x02, 0.f,
-        rotMat.x10, rotMat.x11, rotMat.x12, 0.f,
-        rotMat.x20, rotMat.x21, rotMat.x22, 0.f,
-        0.f, 0.f, 0.f, 1.f
-    };
-
-    auto quatMat = Mat::QuatRotateLH(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
-    float4x4 quatMatrix = {
-        quatMat.x00, quatMat.x01, quatMat.x02, 0.f,
-        quatMat.x10, quatMat.x11, quatMat.x12, 0.f,
-        quatMat.x20, quatMat.x21, quatMat.x22, 0.f,
-        0.f, 0.f, 0.f, 1.f
-    };
-
-    float4x4 scaleMatrix = {
-        scale.x, 0.f, 0.f, 0.f,
-        0.f, scale.y, 0.f, 0.f,
-        0.f, 0.f, scale.z, 0.f,
-        0.f, 0.f, 0.f, 1.f
-    };
-
-    return Mat::Mul(scaleMatrix, Mat::Mul(quatMatrix, Mat::Mul(rotMatrix, posMatrix)));
 }
\ No newline at end of file
@@ -69,8 +69,6 @@ namespace Engine
         void UpdatePrimitive(DrawingResourceTable& resTable);
         void UpdateRectPrimitive(DrawingResourceTable& resTable);
 
-        float4x4 UpdateWorldMatrix(const TransformComponent* pTransform);
-
     public:
         // Define shader resource names
         FuncResourceName(BasicVertexShader)
@@ -1,3 +1,4 @@
+#include "Global.h"
 #include "FrameGraph.h"
 
 using namespace Engine;
@@ -5,6 +6,8 @@ using namespace Engine;
 FrameGraphNode::FrameGraphNode(FrameGraph& frameGraph, uint32_t index, std::shared_ptr<DrawingPass> pPass, FrameGraphFlagBits bits) :
     m_frameGraph(frameGraph), m_index(index), m_pPass(pPass), m_bits(bits)
 {
+    // Passes are timed by name, so rebuilt graphs keep adding to the same phase.
+    m_phase = gpGlobal->GetFrameStats().RegisterPhase("Pass " + *pPass->GetName());
 }
 
 FrameGraphNode::~FrameGraphNode()
@@ -114,6 +117,11 @@ std::shared_ptr<DrawingPass> FrameGraphNode::GetDrawingPass() const
     return m_pPass;
 }
 
+uint32_t FrameGraphNode::GetPhase() const
+{
+    return m_phase;
+}
+
 FrameGraph::FrameGraph()
 {
 }
@@ -148,11 +156,13 @@ bool FrameGraph::InitializePasses()
 
 void FrameGraph::EnqueuePasses()
 {
+    auto& frameStats = gpGlobal->GetFrameStats();
     for (auto& pNode : m_nodes)
     {
         if (pNode == nullptr)
             continue;
 
+        FrameStats::ScopedPhase phase(&frameStats, pNode->GetPhase());
         pNode->RunClearColorFunc();
         pNode->RunClearDepthStencilFunc();
 
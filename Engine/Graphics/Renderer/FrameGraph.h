@@ -43,6 +43,7 @@ namespace Engine
         uint32_t GetIndex() const;
         FrameGraphFlagBits GetFrameGraphFlagBit() const;
         std::shared_ptr<DrawingPass> GetDrawingPass() const;
+        uint32_t GetPhase() const;
 
     private:
         typedef std::unordered_map<unsigned int, std::function<void (float4&)>> ClearColorFuncTable;
@@ -50,6 +51,7 @@ namespace Engine
         FrameGraph& m_frameGraph;
 
         uint32_t m_index;
+        uint32_t m_phase;
         FrameGraphFlagBits m_bits;
         std::shared_ptr<DrawingPass> m_pPass;
 
@@ -22,7 +22,7 @@ namespace Engine
     struct RenderQueueItem
     {
         const IRenderable* pRenderable;
-        const TransformComponent* pTransformComp;
+        const float4x4* pWorldMatrix;
     };
 
     typedef std::vector<RenderQueueItem> RenderQueueItemListType;
@@ -44,6 +44,6 @@ namespace Engine
         }
 
     private:
-        RenderQueueItemListType m_queues[ERenderQueueType::Count];
+        RenderQueueItemListType m_queues[enum_cast(ERenderQueueType::Count)];
     };
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "IMaterial.h"
+#include "IMesh.h"
+#include "FrameGraph.h"
+#include "RenderQueue.h"
+
+namespace Engine
+{
+    struct RenderCameraSnapshot
+    {
+        std::shared_ptr<FrameGraph> pFrameGraph;
+        float4x4 view;
+        float4x4 proj;
+        float3 dir;
+        float4 background;
+    };
+
+    struct RenderLightSnapshot
+    {
+        float4x4 view;
+        float4x4 proj;
+        float3 dir;
+    };
+
+    // Everything a frame is drawn from, copied out of the world once simulation is done, so
+    // the render thread never reads live components.
+    struct RenderSnapshot
+    {
+        uint64_t frame = 0;
+        bool bDebug = false;
+
+        std::vector<RenderCameraSnapshot> cameras;
+
+        bool bMainLight = false;
+        RenderLightSnapshot mainLight;
+
+        // Renderables point into worldMatrices. Meshes and materials are held until the
+        // snapshot is reused, in case their entities are destroyed while it is drawn.
+        uint32_t renderableVersion = 0;
+        RenderQueueItemListType renderables;
+        std::vector<float4x4> worldMatrices;
+        std::vector<std::shared_ptr<IMesh>> meshes;
+        std::vector<std::shared_ptr<IMaterial>> materials;
+    };
+}
\ No newline at end of file
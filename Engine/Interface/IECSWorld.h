@@ -1,151 +1,247 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <type_traits>
 
 #include "IRuntimeModule.h"
+#include "ECSArchetype.h"
+#include "Algorithm.h"
+#include "FixedTimestep.h"
 
 namespace Engine
 {
     class IComponent;
-    class IEntity;
     class IECSWorld;
+    class EntityCommandBuffer;
 
-    typedef uint32_t CompID;
-    typedef uint32_t CompIndex;
-    typedef uint64_t CompBitset;
-
-    typedef CompIndex(*CreateCompFunc)(IComponent*, std::shared_ptr<IEntity>, std::vector<uint8_t>&);
-    typedef void(*DestroyCompFunc)(IComponent*);
+    template<typename... Comps>
+    class ECSQuery;
 
-    typedef uint32_t EntityID;
+    typedef IComponent*(*CreateCompFunc)(const IComponent*, void*);
+    typedef void(*RelocateCompFunc)(void*, void*);
+    typedef void(*DestroyCompFunc)(void*);
 
-    class IComponent : public std::enable_shared_from_this<IComponent>
+    class IComponent
     {
     public:
         IComponent() = default;
         ~IComponent() = default;
 
-        typedef std::tuple<CreateCompFunc, DestroyCompFunc, uint32_t> CompType;
-        typedef std::vector<CompType> CompTableType;
+        typedef std::tuple<CreateCompFunc, RelocateCompFunc, DestroyCompFunc, uint32_t, uint32_t> CompType;
+        typedef std::array<CompType, ECSArchetype::MAX_COMPONENTS> CompTableType;
 
-        static uint32_t RegisterComponent(CreateCompFunc createFunc, DestroyCompFunc destroyFunc, uint32_t size);
+        // Throws once every bit of CompBitset is taken.
+        static uint32_t RegisterComponent(CreateCompFunc createFunc, RelocateCompFunc relocateFunc, DestroyCompFunc destroyFunc, uint32_t size, uint32_t alignment);
 
         static CreateCompFunc GetCreateFunc(uint32_t id)
         {
-            return std::get<0>(m_compTable[id]);
+            return std::get<0>(GetCompTable()[id]);
+        }
+
+        static RelocateCompFunc GetRelocateFunc(uint32_t id)
+        {
+            return std::get<1>(GetCompTable()[id]);
         }
 
         static DestroyCompFunc GetDestroyFunc(uint32_t id)
         {
-            return std::get<1>(m_compTable[id]);
+            return std::get<2>(GetCompTable()[id]);
         }
 
         static uint32_t GetSize(uint32_t id)
         {
-            return std::get<2>(m_compTable[id]);
+            return std::get<3>(GetCompTable()[id]);
+        }
+
+        static uint32_t GetAlignment(uint32_t id)
+        {
+            return std::get<4>(GetCompTable()[id]);
         }
 
         static void ClearComponentTable()
         {
-            m_compTable.clear();
+            GetCompCount().store(0, std::memory_order_relaxed);
+        }
+
+        // Global version of the last write, mutable accessors stamp it through MarkChanged.
+        uint32_t GetVersion() const
+        {
+            return m_version;
         }
 
+        bool IsChangedSince(uint32_t version) const
+        {
+            return m_version >= version;
+        }
+
+        inline void MarkChanged();
+
     public:
-        std::shared_ptr<IEntity> m_pEntity = nullptr;
+        Entity m_entity = INVALID_ENTITY;
 
     private:
-        static CompTableType m_compTable;
+        uint32_t m_version = 0;
+
+        static CompTableType& GetCompTable()
+        {
+            static CompTableType compTable;
+            return compTable;
+        }
+
+        static std::atomic<uint32_t>& GetCompCount()
+        {
+            static std::atomic<uint32_t> compCount(0);
+            return compCount;
+        }
     };
 
-    class IEntity : public std::enable_shared_from_this<IEntity>
+    class IECSSystem : public IRuntimeModule
     {
     public:
-        IEntity(std::shared_ptr<IECSWorld> pWorld) : m_pWorld(pWorld), m_compBitset(0) {}
-        virtual ~IEntity() = default;
+        IECSSystem() : m_pWorld(nullptr), m_compBitset(0), m_readBitset(0), m_writeBitset(0), m_bMainThread(false), m_bFixedStep(false), m_version(0), m_lastVersion(0) {}
+        virtual ~IECSSystem() = default;
 
-        virtual void AttachComponent(CompID compId, IComponent* pComponent, std::unordered_map<CompID, std::vector<uint8_t>>& memory) = 0;
-        virtual void DetachComponent(CompID compId, CompIndex compIndex, std::unordered_map<CompID, std::vector<uint8_t>>& memory) = 0;
+        virtual void Initialize() = 0;
+        virtual void Shutdown() = 0;
 
-        template<typename Comp>
-        inline Comp* GetComponent();
+        virtual void Tick(float elapsedTime) = 0;
+        virtual void FlushEntity(Entity entity) = 0;
 
-        template<typename Comp>
-        inline bool HasComponent();
+        // Names the system's phase in frame statistics, the same on every compiler.
+        virtual const char* GetName() const = 0;
 
-        template<typename Comp>
-        inline void AttachComponent(Comp component);
+        virtual void AttachWorld(IECSWorld* pWorld)
+        {
+            m_pWorld = pWorld;
+        }
 
-    public:
-        EntityID m_id;
+        // Fixed step systems only, called on the main thread once per frame after the steps
+        // with how far the frame is past the last one, to blend state for rendering.
+        virtual void Interpolate(float) {}
 
-    protected:
-        std::shared_ptr<IECSWorld> m_pWorld;
-        CompBitset m_compBitset;
-        std::vector<std::pair<CompID, CompIndex>> m_comps;
-    };
+        CompBitset GetReadBitset() const
+        {
+            return m_readBitset;
+        }
 
-    template<typename Comp>
-    inline Comp* IEntity::GetComponent()
-    {
-        CompID compId = Comp::m_compID;
-        CompIndex compIndex = 0;
-        bool bFound = false;
-        for(auto comp : m_comps)
-            if (compId == comp.first)
-            {
-                compIndex = comp.second;
-                bFound = true;
-                break;
-            }
-        if (!bFound)
-            return nullptr;
+        CompBitset GetWriteBitset() const
+        {
+            return m_writeBitset;
+        }
 
-        Comp* pComp = (Comp*)(&m_pWorld->m_compTable[compId][compIndex]);
-        return pComp;
-    };
+        bool IsMainThread() const
+        {
+            return m_bMainThread || IsExclusive();
+        }
 
-    template<typename Comp>
-    inline bool IEntity::HasComponent()
-    {
-        static_assert(std::is_base_of<IComponent, Comp>::value);
-        return IsBitOf(m_compBitset, Comp::m_compID);
-    };
+        // A system that declares no component access may touch anything, so it
+        // runs alone on the main thread as a barrier between its neighbours.
+        bool IsExclusive() const
+        {
+            return (m_readBitset | m_writeBitset) == 0;
+        }
 
-    template<typename Comp>
-    inline void IEntity::AttachComponent(Comp component)
-    {
-        IComponent* pComp = &component;
-        AttachComponent(Comp::m_compID, pComp, m_pWorld->GetCompTable());
-    }
+        bool IsFixedStep() const
+        {
+            return m_bFixedStep;
+        }
 
-    class IECSSystem : public IRuntimeModule
-    {
-    public:
-        IECSSystem() : m_compBitset(0) {}
-        virtual ~IECSSystem() = default;
+        // Called before every Tick. Anything stamped at or after GetLastVersion() was
+        // written since the previous Tick started, including by this system.
+        inline void UpdateVersion();
 
-        virtual void Initialize() = 0;
-        virtual void Shutdown() = 0;
+        uint32_t GetLastVersion() const
+        {
+            return m_lastVersion;
+        }
 
-        virtual void Tick(float elapsedTime) = 0;
-        virtual void FlushEntity(IEntity* pEntity) = 0;
+    protected:
+        template<typename Comp>
+        void DeclareRead()
+        {
+            AddBit<CompBitset>(m_readBitset, Comp::GetCompID());
+        }
+
+        template<typename Comp>
+        void DeclareWrite()
+        {
+            AddBit<CompBitset>(m_writeBitset, Comp::GetCompID());
+        }
+
+        void DeclareMainThread()
+        {
+            m_bMainThread = true;
+        }
+
+        // Ticks in whole steps of the world's fixed timestep instead of once per frame.
+        void DeclareFixedStep()
+        {
+            m_bFixedStep = true;
+        }
 
     protected:
+        IECSWorld* m_pWorld;
         CompBitset m_compBitset;
         std::vector<CompID> m_comps;
+
+        CompBitset m_readBitset;
+        CompBitset m_writeBitset;
+        bool m_bMainThread;
+        bool m_bFixedStep;
+
+        uint32_t m_version;
+        uint32_t m_lastVersion;
     };
 
     class IECSWorld : public IRuntimeModule
     {
-    friend IEntity;
     public:
         template<typename ...Comps>
-        std::shared_ptr<IEntity> CreateEntity(Comps... comps);
+        Entity CreateEntity(Comps... comps);
+
+        template<typename... Comps>
+        Entity CreateEntity();
+
+        // Spawns count copies of the prototype components with one row allocation.
+        template<typename... Comps>
+        std::vector<Entity> CreateEntities(uint32_t count, Comps... prototype);
+
+        virtual void DestroyEntity(Entity entity) = 0;
+
+        // Structural changes from worker threads go through the calling thread's buffer.
+        virtual EntityCommandBuffer* GetCommandBuffer() = 0;
+
+        bool IsAlive(Entity entity) const
+        {
+            return GetEntitySlot(entity) != nullptr;
+        }
+
+        CompBitset GetCompBitset(Entity entity) const
+        {
+            auto pSlot = GetEntitySlot(entity);
+            return pSlot != nullptr ? pSlot->pArchetype->GetBitset() : 0;
+        }
+
+        // GetComponent<const Comp> only reads. A mutable Comp stamps the chunk as changed,
+        // which systems may only do for components they declared a write to.
+        template<typename Comp>
+        Comp* GetComponent(Entity entity);
+
+        template<typename Comp>
+        bool HasComponent(Entity entity) const;
+
+        template<typename Comp>
+        void AttachComponent(Entity entity, Comp component);
+
+        template<typename Comp>
+        void DetachComponent(Entity entity);
 
         template<typename... Comps>
-        std::shared_ptr<IEntity> CreateEntity();
+        ECSQuery<Comps...> Query();
 
         template<typename T>
         void AddECSSystem(std::shared_ptr<T> pSystem);
@@ -164,59 +260,208 @@ namespace Engine
         }
 
         void Tick(float elapsedTime) override
+        {
+            auto stepCount = m_timestep.Advance(elapsedTime);
+            for (uint32_t step = 0; step < stepCount; step++)
+            {
+                AdvanceGlobalVersion();
+                TickSystems(true, m_timestep.GetStep());
+            }
+            InterpolateSystems();
+
+            AdvanceGlobalVersion();
+            TickSystems(false, elapsedTime);
+        }
+
+        void SetFixedStep(float step, uint32_t maxSteps)
+        {
+            m_timestep.SetStep(step);
+            m_timestep.SetMaxSteps(maxSteps);
+        }
+
+        const FixedTimestep& GetFixedTimestep() const
+        {
+            return m_timestep;
+        }
+
+        // Shared by every world so component and chunk stamps stay comparable.
+        static uint32_t GetGlobalVersion()
+        {
+            return GetVersionCounter().load(std::memory_order_relaxed);
+        }
+
+        // Returns the new version, writes made from now on are stamped with at least it.
+        static uint32_t AdvanceGlobalVersion()
+        {
+            return GetVersionCounter().fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        const std::vector<std::shared_ptr<ECSArchetype>>& GetArchetypes() const
+        {
+            return m_archetypePool;
+        }
+
+        virtual void AttachComponent(Entity entity, CompID compId, const IComponent* pComponent) = 0;
+        virtual void DetachComponent(Entity entity, CompID compId) = 0;
+
+    private:
+        virtual Entity CreateEntity(const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids) = 0;
+        virtual void CreateEntities(uint32_t count, const std::vector<const IComponent*>& pComponents, const std::vector<CompID>& ids, Entity* pEntities) = 0;
+
+    protected:
+        void TickSystems(bool bFixedStep, float elapsedTime)
         {
             for (uint32_t i = 0; i < m_systemPool.size(); i++)
+            {
+                if (m_systemPool[i]->IsFixedStep() != bFixedStep)
+                    continue;
+
+                m_systemPool[i]->UpdateVersion();
                 m_systemPool[i]->Tick(elapsedTime);
+            }
         }
 
-        std::unordered_map<CompID, std::vector<uint8_t>>& GetCompTable()
+        void InterpolateSystems()
         {
-            return m_compTable;
+            auto alpha = m_timestep.GetAlpha();
+            for (uint32_t i = 0; i < m_systemPool.size(); i++)
+            {
+                if (m_systemPool[i]->IsFixedStep())
+                    m_systemPool[i]->Interpolate(alpha);
+            }
+        }
+
+        ECSArchetype* GetArchetype(CompBitset bitset)
+        {
+            auto it = m_archetypeTable.find(bitset);
+            if (it != m_archetypeTable.end())
+                return it->second;
+
+            auto pArchetype = std::make_shared<ECSArchetype>(bitset);
+            m_archetypePool.emplace_back(pArchetype);
+            m_archetypeTable[bitset] = pArchetype.get();
+            return pArchetype.get();
+        }
+
+        // Destroyed slots are recycled with a bumped generation, so a stale handle fails the check.
+        struct EntitySlot
+        {
+            ECSArchetype* pArchetype;
+            uint32_t row;
+            uint32_t generation;
+        };
+
+        const EntitySlot* GetEntitySlot(Entity entity) const
+        {
+            if (entity.index >= m_entitySlots.size())
+                return nullptr;
+
+            auto& slot = m_entitySlots[entity.index];
+            return slot.generation == entity.generation && slot.pArchetype != nullptr ? &slot : nullptr;
         }
 
     private:
-        virtual std::shared_ptr<IEntity> CreateEntity(const std::vector<IComponent*>& pComponents, const std::vector<CompID>& ids) = 0;
+        static std::atomic<uint32_t>& GetVersionCounter()
+        {
+            static std::atomic<uint32_t> version(1);
+            return version;
+        }
 
     protected:
-        std::unordered_map<CompID, std::vector<uint8_t>> m_compTable;
-        std::vector<std::shared_ptr<IEntity>> m_entityPool;
+        bool m_bSystemChanged = true;
+        std::vector<std::shared_ptr<ECSArchetype>> m_archetypePool;
+        std::unordered_map<CompBitset, ECSArchetype*> m_archetypeTable;
+        std::vector<EntitySlot> m_entitySlots;
         std::vector<std::shared_ptr<IECSSystem>> m_systemPool;
+        FixedTimestep m_timestep;
     };
 
     template<typename ...Comps>
-    inline std::shared_ptr<IEntity> IECSWorld::CreateEntity(Comps... comps)
+    inline Entity IECSWorld::CreateEntity(Comps... comps)
     {
-        std::vector<CompID> ids = { Comps::m_compID... };
-        std::vector<IComponent*> pComponents = { &comps... };
-        auto pEntity = CreateEntity(pComponents, ids);
-        return pEntity;
+        std::vector<CompID> ids = { Comps::GetCompID()... };
+        std::vector<const IComponent*> pComponents = { &comps... };
+        return CreateEntity(pComponents, ids);
     }
 
     template<typename... Comps>
-    inline std::shared_ptr<IEntity> IECSWorld::CreateEntity()
+    inline Entity IECSWorld::CreateEntity()
+    {
+        return CreateEntity<Comps...>(Comps()...);
+    }
+
+    template<typename... Comps>
+    inline std::vector<Entity> IECSWorld::CreateEntities(uint32_t count, Comps... prototype)
+    {
+        std::vector<CompID> ids = { Comps::GetCompID()... };
+        std::vector<const IComponent*> pComponents = { &prototype... };
+        std::vector<Entity> entities(count);
+        CreateEntities(count, pComponents, ids, entities.data());
+        return entities;
+    }
+
+    template<typename Comp>
+    inline Comp* IECSWorld::GetComponent(Entity entity)
+    {
+        auto pSlot = GetEntitySlot(entity);
+        if (pSlot == nullptr || !pSlot->pArchetype->HasComponent(Comp::GetCompID()))
+            return nullptr;
+
+        // The caller may write through the pointer, so its chunk counts as changed.
+        if constexpr (!std::is_const<Comp>::value)
+            pSlot->pArchetype->MarkChanged(Comp::GetCompID(), pSlot->row, GetGlobalVersion());
+        return static_cast<Comp*>(pSlot->pArchetype->GetComponent(Comp::GetCompID(), pSlot->row));
+    }
+
+    template<typename Comp>
+    inline bool IECSWorld::HasComponent(Entity entity) const
+    {
+        static_assert(std::is_base_of<IComponent, Comp>::value);
+        auto pSlot = GetEntitySlot(entity);
+        return pSlot != nullptr && pSlot->pArchetype->HasComponent(Comp::GetCompID());
+    }
+
+    template<typename Comp>
+    inline void IECSWorld::AttachComponent(Entity entity, Comp component)
+    {
+        AttachComponent(entity, Comp::GetCompID(), &component);
+    }
+
+    template<typename Comp>
+    inline void IECSWorld::DetachComponent(Entity entity)
+    {
+        DetachComponent(entity, Comp::GetCompID());
+    }
+
+    inline void IComponent::MarkChanged()
     {
-        std::vector<CompID> ids = { Comps::m_compID... };
-        std::vector<IComponent*> pComponents = { new Comps()... };
-        auto pEntity = CreateEntity(pComponents, ids);
-        return pEntity;
+        m_version = IECSWorld::GetGlobalVersion();
+    }
+
+    inline void IECSSystem::UpdateVersion()
+    {
+        m_lastVersion = m_version;
+        m_version = IECSWorld::AdvanceGlobalVersion();
     }
 
     template<typename T>
     inline void IECSWorld::AddECSSystem(std::shared_ptr<T> pSystem)
     {
         auto pECSSystem = std::dynamic_pointer_cast<IECSSystem>(pSystem);
+        pECSSystem->AttachWorld(this);
         m_systemPool.push_back(pECSSystem);
+        m_bSystemChanged = true;
     }
 
     inline void IECSWorld::RemoveECSSystem(std::shared_ptr<IECSSystem> pSystem)
     {
-        for(uint32_t i = 0; i < m_systemPool.size(); i++)
-        {
-            if (m_systemPool[i] == pSystem)
-            {
-                m_systemPool[i] = m_systemPool[m_systemPool.size() - 1];
-                m_systemPool.pop_back();
-            }
-        }
+        // Keep registration order, the scheduler uses it to order conflicting systems.
+        auto it = std::find(m_systemPool.begin(), m_systemPool.end(), pSystem);
+        if (it == m_systemPool.end())
+            return;
+
+        pSystem->AttachWorld(nullptr);
+        m_systemPool.erase(it);
+        m_bSystemChanged = true;
     }
 }
\ No newline at end of file
@@ -1,60 +1,760 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <memory>
-#include <list>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
-#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <assert.h>
 #include <stdint.h>
 
 #include "IRuntimeModule.h"
+#include "RingBuffer.h"
+#include "MPSCQueue.h"
 #include "Traits.h"
 #include "Global.h"
 
 namespace Engine
 {
-    class IEventData
+    typedef uint32_t EventID;
+    typedef uint32_t EventContext;
+
+    // Listeners run on the thread that ticks the event system unless they are bound
+    // to another context, whose thread or job drains it with ProcessEvents(context).
+    constexpr EventContext EVENT_CONTEXT_MAIN = 0;
+    constexpr uint32_t MAX_EVENT_CONTEXTS = 8;
+
+    // Immediate calls the listeners inside QueueEvent on the owning thread, queued from
+    // other threads it falls back to Frame. Frame is delivered per type in queuing order
+    // when the event system ticks. EndOfFrame and TimeSliced are ordered by priority
+    // across types, the first drained after the world ticked, the second within a budget.
+    enum EEventChannel
+    {
+        eEventChannel_Immediate,
+        eEventChannel_Frame,
+        eEventChannel_EndOfFrame,
+        eEventChannel_TimeSliced,
+        eEventChannel_Count
+    };
+
+    // Handle to one registered delegate. Removing it moves the slot's generation on,
+    // so a stale handle no longer matches.
+    struct EventSubscription
+    {
+        constexpr static uint32_t INVALID_SLOT = static_cast<uint32_t>(-1);
+
+        EventID id;
+        uint32_t slot;
+        uint32_t generation;
+
+        bool operator==(const EventSubscription& other) const { return id == other.id && slot == other.slot && generation == other.generation; }
+        bool operator!=(const EventSubscription& other) const { return !(*this == other); }
+
+        bool IsValid() const { return slot != INVALID_SLOT; }
+    };
+
+    const EventSubscription INVALID_SUBSCRIPTION = { 0, EventSubscription::INVALID_SLOT, 0 };
+
+    // Back-pressure of events queued from threads other than the owning one.
+    struct EventQueueStats
+    {
+        uint64_t pushedCount;
+        uint64_t overflowCount;
+        uint32_t peakCount;
+    };
+
+    class IEventQueue
+    {
+    public:
+        virtual ~IEventQueue() = default;
+
+        // Moves events posted from other threads to the channels they were queued on.
+        virtual void Collect() = 0;
+
+        // Delivers the Frame channel, including events queued by the listeners on the way.
+        virtual void Dispatch() = 0;
+        virtual void Dispatch(EventContext context) = 0;
+
+        // Slots hold the payloads of the prioritized channels until their turn.
+        virtual void DispatchSlot(uint32_t slot) = 0;
+        virtual void ReleaseSlot(uint32_t slot) = 0;
+
+        virtual bool RemoveListener(const EventSubscription& subscription) = 0;
+
+        virtual void Clear() = 0;
+
+        virtual EventQueueStats GetStats() const = 0;
+
+        static EventID RegisterEventType()
+        {
+            return GetEventTypeCounter().fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static EventID GetEventTypeCount()
+        {
+            return GetEventTypeCounter().load(std::memory_order_acquire);
+        }
+
+    private:
+        static std::atomic<EventID>& GetEventTypeCounter()
+        {
+            static std::atomic<EventID> count(0);
+            return count;
+        }
+    };
+
+    // Priority queue shared by every event type. Payloads stay with the queue of their
+    // type, an entry only names that queue and a slot. Owning thread only.
+    class EventChannel
     {
     public:
-        typedef uint32_t id_t;
-        typedef std::string name_t;
+        struct Entry
+        {
+            int32_t priority;
+            uint64_t sequence;
+            IEventQueue* pEventQueue;
+            uint32_t slot;
+        };
+
+        EventChannel() : m_sequence(0) {}
+
+        void Push(IEventQueue* pEventQueue, uint32_t slot, int32_t priority)
+        {
+            m_heap.push_back({ priority, m_sequence++, pEventQueue, slot });
+            std::push_heap(m_heap.begin(), m_heap.end(), &IsLower);
+        }
+
+        // Highest priority first, equal priorities in queuing order.
+        Entry Pop()
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end(), &IsLower);
+            auto entry = m_heap.back();
+            m_heap.pop_back();
+            return entry;
+        }
+
+        bool Empty() const
+        {
+            return m_heap.empty();
+        }
+
+        uint32_t Size() const
+        {
+            return (uint32_t)m_heap.size();
+        }
+
+    private:
+        static bool IsLower(const Entry& a, const Entry& b)
+        {
+            return a.priority != b.priority ? a.priority < b.priority : a.sequence > b.sequence;
+        }
 
-        virtual id_t GetID() const = 0;
-        virtual name_t GetName() const = 0;
+    private:
+        std::vector<Entry> m_heap;
+        uint64_t m_sequence;
     };
 
+    // The payload type and enum value together identify an event type, the event
+    // itself is just the payload so it can be queued by value.
     template <typename T, typename E, E e,
               typename = typename std::enable_if<std::is_enum<E>::value>::type>
-    class Event : public IEventData
+    class Event
     {
     public:
         typedef T msg_t;
+        constexpr static E TAG = e;
+
+        Event(const msg_t& msg) : m_msg(msg) {}
 
-        Event() {}
-        Event(const msg_t t, const char* n) : m_id(e), m_name(n), m_msg(t) {}
+        // Dense index of the event type's queue, resolved once per type.
+        inline static EventID GetID()
+        {
+            static const EventID id = IEventQueue::RegisterEventType();
+            return id;
+        }
 
-        id_t GetID() const override     { return m_id; }
-        name_t GetName() const override { return m_name; }
-        msg_t GetMsg() const            { return m_msg; }
+        const msg_t& GetMsg() const { return m_msg; }
 
     private:
-        id_t m_id;
-        name_t m_name;
         msg_t m_msg;
     };
 
-    typedef std::shared_ptr<IEventData> IEventDataPtr;
-    typedef std::function<void(const IEventDataPtr&)> EventDelegate;
-    typedef std::list<EventDelegate> EventDelegateList;
-    typedef uintptr_t EventListenerAddr;
+    // Plain function pointer and the object it is called on, no type erasure beyond that.
+    // The context picks the thread it is called on.
+    template<typename Ev>
+    struct EventDelegate
+    {
+        typedef void(*Func)(void* pTarget, const Ev& event);
+
+        Func pFunc;
+        void* pTarget;
+        EventContext context;
+    };
+
+    // Lock-free while the bounded queue has room. A full queue spills into a locked ring
+    // instead of dropping or blocking, and stays there until the consumer has caught up
+    // so events from one producer keep their order.
+    template<typename T>
+    class EventMailbox
+    {
+    public:
+        constexpr static uint32_t CAPACITY = 256;
+
+        EventMailbox() : m_queue(CAPACITY), m_bOverflow(false), m_pushedCount(0), m_overflowCount(0) {}
+
+        void Push(const T& value)
+        {
+            m_pushedCount.fetch_add(1, std::memory_order_relaxed);
+            if (!m_bOverflow.load(std::memory_order_acquire) && m_queue.TryPush(value))
+                return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_overflow.Push(value);
+            m_bOverflow.store(true, std::memory_order_release);
+            m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Consumer only, hands every pending value to func in order. func must not post
+        // to this mailbox, the overflow lock may be held.
+        template<typename Func>
+        uint32_t Drain(Func func)
+        {
+            uint32_t count = 0;
+            while (m_queue.TryPop(func))
+                count++;
+
+            if (m_bOverflow.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                while (m_queue.TryPop(func))
+                    count++;
+
+                for (; !m_overflow.Empty(); count++)
+                {
+                    func(m_overflow.Front());
+                    m_overflow.Pop();
+                }
+                m_bOverflow.store(false, std::memory_order_release);
+            }
+            return count;
+        }
+
+        uint64_t GetPushedCount() const
+        {
+            return m_pushedCount.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetOverflowCount() const
+        {
+            return m_overflowCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        MPSCQueue<T> m_queue;
+        std::mutex m_mutex;
+        RingBuffer<T> m_overflow;
+        std::atomic<bool> m_bOverflow;
+
+        std::atomic<uint64_t> m_pushedCount;
+        std::atomic<uint64_t> m_overflowCount;
+    };
+
+    // Events queued on the owning thread go straight to their channel, other threads post
+    // to the mailbox which Collect drains. Listeners are registered on the owning thread.
+    template<typename Ev>
+    class EventQueue : public IEventQueue
+    {
+    public:
+        EventQueue(std::thread::id ownerThread, EventChannel* pChannels) : m_ownerThread(ownerThread), m_pChannels(pChannels), m_contextMask(0), m_removalCount(0), m_dispatchDepth(0), m_bCompact(false), m_peakCount(0)
+        {
+            for (auto& count : m_contextCounts)
+                count = 0;
+        }
+
+        virtual ~EventQueue()
+        {
+            assert(m_freeSlots.size() == m_slots.size());
+        }
+
+        void Push(const Ev& event, EEventChannel channel, int32_t priority)
+        {
+            if (std::this_thread::get_id() != m_ownerThread)
+                m_mailbox.Push({ event, channel, priority });
+            else if (channel == eEventChannel_Immediate)
+                Deliver(event);
+            else
+                Route(event, channel, priority);
+        }
+
+        // pOwner is kept alive until the delegate is gone, which removal during a dispatch
+        // defers until the dispatch has returned.
+        EventSubscription AddListener(const EventDelegate<Ev>& delegate, std::shared_ptr<void> pOwner)
+        {
+            if (delegate.context >= MAX_EVENT_CONTEXTS)
+                return INVALID_SUBSCRIPTION;
+
+            std::lock_guard<std::mutex> lock(m_listenerMutex);
+            uint32_t slot;
+            if (m_freeListenerSlots.empty())
+            {
+                slot = (uint32_t)m_listenerSlots.size();
+                m_listenerSlots.push_back({ 0, 0 });
+            }
+            else
+            {
+                slot = m_freeListenerSlots.back();
+                m_freeListenerSlots.pop_back();
+            }
+
+            m_listenerSlots[slot].index = (uint32_t)m_delegates.size();
+            m_delegates.emplace_back(delegate);
+            m_delegateSlots.emplace_back(slot);
+            m_delegateOwners.emplace_back(std::move(pOwner));
+
+            if (delegate.context != EVENT_CONTEXT_MAIN)
+            {
+                if (m_pInboxes[delegate.context] == nullptr)
+                    m_pInboxes[delegate.context] = std::make_unique<ContextInbox>();
+                if (m_contextCounts[delegate.context]++ == 0)
+                    m_contextMask |= 1u << delegate.context;
+            }
+
+            return { Ev::GetID(), slot, m_listenerSlots[slot].generation };
+        }
+
+        bool RemoveListener(const EventSubscription& subscription) override
+        {
+            std::lock_guard<std::mutex> lock(m_listenerMutex);
+            if (subscription.slot >= m_listenerSlots.size() || m_listenerSlots[subscription.slot].generation != subscription.generation)
+                return false;
+
+            auto& listenerSlot = m_listenerSlots[subscription.slot];
+            auto index = listenerSlot.index;
+            auto context = m_delegates[index].context;
+            if (context != EVENT_CONTEXT_MAIN && --m_contextCounts[context] == 0)
+                m_contextMask &= ~(1u << context);
+
+            listenerSlot.generation++;
+            m_freeListenerSlots.push_back(subscription.slot);
+            m_removalCount.fetch_add(1, std::memory_order_release);
+
+            // A running dispatch may still call into the owner, the hole is closed afterwards.
+            if (m_dispatchDepth.load(std::memory_order_acquire) > 0)
+            {
+                m_delegates[index].pFunc = nullptr;
+                m_delegateSlots[index] = EventSubscription::INVALID_SLOT;
+                m_bCompact.store(true, std::memory_order_release);
+            }
+            else
+                EraseDelegate(index);
+
+            return true;
+        }
+
+        void Collect() override
+        {
+            auto count = m_mailbox.Drain([this](PendingEvent& pending) {
+                Route(std::move(pending.event), pending.channel, pending.priority);
+            });
+            m_peakCount = std::max(m_peakCount, count);
+        }
+
+        void Dispatch() override
+        {
+            while (!m_events.Empty())
+            {
+                // Moved out first, a listener queuing the same type may grow the ring.
+                Ev event(std::move(m_events.Front()));
+                m_events.Pop();
+                Deliver(event);
+            }
+        }
+
+        // Only the thread draining context touches its inbox, the lock guards the pointer.
+        void Dispatch(EventContext context) override
+        {
+            ContextInbox* pInbox;
+            {
+                std::lock_guard<std::mutex> lock(m_listenerMutex);
+                pInbox = m_pInboxes[context].get();
+            }
+            if (pInbox == nullptr)
+                return;
+
+            pInbox->mailbox.Drain([&](Ev& event) { pInbox->events.Push(std::move(event)); });
+            while (!pInbox->events.Empty())
+            {
+                Ev event(std::move(pInbox->events.Front()));
+                pInbox->events.Pop();
+                Invoke(event, context);
+            }
+        }
+
+        void DispatchSlot(uint32_t slot) override
+        {
+            Ev event(std::move(*GetSlot(slot)));
+            ReleaseSlot(slot);
+            Deliver(event);
+        }
+
+        void ReleaseSlot(uint32_t slot) override
+        {
+            GetSlot(slot)->~Ev();
+            m_freeSlots.push_back(slot);
+        }
+
+        // The owner releases the channel entries pointing here first.
+        void Clear() override
+        {
+            std::lock_guard<std::mutex> lock(m_listenerMutex);
+            m_mailbox.Drain([](PendingEvent&) {});
+            m_events.Clear();
+            m_delegates.clear();
+            m_delegateSlots.clear();
+            m_delegateOwners.clear();
+
+            // Outstanding subscriptions go stale, every slot is free again.
+            m_freeListenerSlots.clear();
+            for (uint32_t slot = 0; slot < m_listenerSlots.size(); slot++)
+            {
+                m_listenerSlots[slot].generation++;
+                m_freeListenerSlots.push_back(slot);
+            }
+            m_removalCount.fetch_add(1, std::memory_order_release);
+
+            for (auto& pInbox : m_pInboxes)
+                pInbox.reset();
+            for (auto& count : m_contextCounts)
+                count = 0;
+            m_contextMask = 0;
+        }
+
+        EventQueueStats GetStats() const override
+        {
+            return { m_mailbox.GetPushedCount(), m_mailbox.GetOverflowCount(), m_peakCount };
+        }
+
+    private:
+        struct PendingEvent
+        {
+            Ev event;
+            EEventChannel channel;
+            int32_t priority;
+        };
+
+        struct ContextInbox
+        {
+            EventMailbox<Ev> mailbox;
+            RingBuffer<Ev> events;
+        };
+
+        struct SnapshotEntry
+        {
+            EventDelegate<Ev> delegate;
+            uint32_t slot;
+            uint32_t generation;
+        };
+
+        typedef typename std::aligned_storage<sizeof(Ev), alignof(Ev)>::type Slot;
+
+        void Route(Ev event, EEventChannel channel, int32_t priority)
+        {
+            if (channel == eEventChannel_Immediate || channel == eEventChannel_Frame)
+            {
+                m_events.Push(std::move(event));
+                return;
+            }
+
+            uint32_t slot;
+            if (m_freeSlots.empty())
+            {
+                // A deque never moves existing slots when it grows.
+                slot = (uint32_t)m_slots.size();
+                m_slots.emplace_back();
+            }
+            else
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            new (GetSlot(slot)) Ev(std::move(event));
+            m_pChannels[channel].Push(this, slot, priority);
+        }
+
+        void Deliver(const Ev& event)
+        {
+            Invoke(event, EVENT_CONTEXT_MAIN, true);
+        }
+
+        // One lock per event copies the live delegates of context, then they run unlocked so
+        // listeners may add and remove listeners on any thread. Listeners added on the way start
+        // with the next event. A removal anywhere bumps m_removalCount, only then is the rest of
+        // the copy checked against the subscription generations again.
+        void Invoke(const Ev& event, EventContext context, bool bPost = false)
+        {
+            auto& snapshot = GetSnapshot();
+            auto begin = snapshot.size();
+            uint32_t removalCount;
+            {
+                std::lock_guard<std::mutex> lock(m_listenerMutex);
+                if (bPost)
+                {
+                    for (auto mask = m_contextMask; mask != 0; mask &= mask - 1)
+                        m_pInboxes[CountTrailingZeros(mask)]->mailbox.Push(event);
+                }
+
+                m_dispatchDepth.fetch_add(1, std::memory_order_relaxed);
+                removalCount = m_removalCount.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < m_delegates.size(); i++)
+                {
+                    auto& delegate = m_delegates[i];
+                    if (delegate.pFunc != nullptr && delegate.context == context)
+                        snapshot.push_back({ delegate, m_delegateSlots[i], m_listenerSlots[m_delegateSlots[i]].generation });
+                }
+            }
+
+            // Indexed, a nested dispatch on this thread may grow the snapshot.
+            for (auto i = begin; i < snapshot.size(); i++)
+            {
+                if (m_removalCount.load(std::memory_order_acquire) != removalCount)
+                {
+                    std::lock_guard<std::mutex> lock(m_listenerMutex);
+                    removalCount = m_removalCount.load(std::memory_order_relaxed);
+                    for (auto j = i; j < snapshot.size(); j++)
+                    {
+                        if (m_listenerSlots[snapshot[j].slot].generation != snapshot[j].generation)
+                            snapshot[j].delegate.pFunc = nullptr;
+                    }
+                }
+
+                auto delegate = snapshot[i].delegate;
+                if (delegate.pFunc != nullptr)
+                    delegate.pFunc(delegate.pTarget, event);
+            }
+            snapshot.resize(begin);
+
+            // Removed owners stay alive until no dispatch can still be calling into them.
+            if (m_dispatchDepth.fetch_sub(1, std::memory_order_acq_rel) == 1 && m_bCompact.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(m_listenerMutex);
+                if (m_dispatchDepth.load(std::memory_order_relaxed) == 0 && m_bCompact.load(std::memory_order_relaxed))
+                {
+                    for (auto i = m_delegates.size(); i-- > 0;)
+                    {
+                        if (m_delegates[i].pFunc == nullptr)
+                            EraseDelegate((uint32_t)i);
+                    }
+                    m_bCompact.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Swaps the last delegate into the hole so the array stays dense.
+        void EraseDelegate(uint32_t index)
+        {
+            auto last = (uint32_t)m_delegates.size() - 1;
+            if (index != last)
+            {
+                m_delegates[index] = m_delegates[last];
+                m_delegateSlots[index] = m_delegateSlots[last];
+                m_delegateOwners[index] = std::move(m_delegateOwners[last]);
+                if (m_delegateSlots[index] != EventSubscription::INVALID_SLOT)
+                    m_listenerSlots[m_delegateSlots[index]].index = index;
+            }
+
+            m_delegates.pop_back();
+            m_delegateSlots.pop_back();
+            m_delegateOwners.pop_back();
+        }
+
+        // Per thread, nested dispatches stack their copies on top.
+        static std::vector<SnapshotEntry>& GetSnapshot()
+        {
+            static thread_local std::vector<SnapshotEntry> s_snapshot;
+            return s_snapshot;
+        }
+
+        Ev* GetSlot(uint32_t slot)
+        {
+            return reinterpret_cast<Ev*>(&m_slots[slot]);
+        }
+
+        static uint32_t CountTrailingZeros(uint32_t mask)
+        {
+            uint32_t index = 0;
+            while ((mask & 1) == 0)
+            {
+                mask >>= 1;
+                index++;
+            }
+            return index;
+        }
+
+    private:
+        std::thread::id m_ownerThread;
+        EventChannel* m_pChannels;
+        RingBuffer<Ev> m_events;
+        std::deque<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        EventMailbox<PendingEvent> m_mailbox;
+
+        struct ListenerSlot
+        {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        std::mutex m_listenerMutex;
+        std::vector<EventDelegate<Ev>> m_delegates;
+        std::vector<uint32_t> m_delegateSlots;
+        std::vector<std::shared_ptr<void>> m_delegateOwners;
+        std::vector<ListenerSlot> m_listenerSlots;
+        std::vector<uint32_t> m_freeListenerSlots;
+
+        std::unique_ptr<ContextInbox> m_pInboxes[MAX_EVENT_CONTEXTS];
+        uint32_t m_contextCounts[MAX_EVENT_CONTEXTS];
+        uint32_t m_contextMask;
+
+        // Written under m_listenerMutex, read by dispatches without it.
+        std::atomic<uint32_t> m_removalCount;
+        std::atomic<uint32_t> m_dispatchDepth;
+        std::atomic<bool> m_bCompact;
+
+        uint32_t m_peakCount;
+    };
 
     class IEventSystem
     {
     public:
-        virtual bool AddListener(IEventData::id_t id, EventDelegate proc) = 0;
-        virtual bool RemoveListener(IEventData::id_t id, EventDelegate proc) = 0;
-        virtual void QueueEvent(IEventDataPtr e) = 0;
+        constexpr static uint32_t MAX_EVENT_TYPES = 256;
+        constexpr static uint32_t DEFAULT_TIME_SLICE_BUDGET = 1000;
+
+        // The constructing thread owns the system, it ticks it and registers listeners.
+        IEventSystem() : m_ownerThread(std::this_thread::get_id()), m_timeSliceBudget(DEFAULT_TIME_SLICE_BUDGET)
+        {
+            for (auto& pEventQueue : m_pEventQueues)
+                pEventQueue.store(nullptr, std::memory_order_relaxed);
+        }
+
+        virtual ~IEventSystem()
+        {
+            ReleaseChannels();
+        }
+
+        // Safe from any thread. Priorities only order the EndOfFrame and TimeSliced channels.
+        // False if the event type did not fit in the queue table.
+        template<typename Ev>
+        bool QueueEvent(const Ev& event, EEventChannel channel = eEventChannel_Frame, int32_t priority = 0)
+        {
+            auto pEventQueue = GetEventQueue<Ev>();
+            if (pEventQueue == nullptr)
+                return false;
+
+            pEventQueue->Push(event, channel, priority);
+            return true;
+        }
+
+        template<typename Ev>
+        EventSubscription AddListener(const EventDelegate<Ev>& delegate, std::shared_ptr<void> pOwner = nullptr)
+        {
+            auto pEventQueue = GetEventQueue<Ev>();
+            if (pEventQueue == nullptr)
+                return INVALID_SUBSCRIPTION;
+
+            return pEventQueue->AddListener(delegate, std::move(pOwner));
+        }
+
+        // O(1), also from inside a listener. Stale subscriptions are ignored.
+        bool RemoveListener(const EventSubscription& subscription)
+        {
+            auto pEventQueue = GetEventQueue(subscription.id);
+            return pEventQueue != nullptr && pEventQueue->RemoveListener(subscription);
+        }
+
+        template<typename Ev>
+        EventQueueStats GetEventStats()
+        {
+            auto pEventQueue = GetEventQueue<Ev>();
+            return pEventQueue != nullptr ? pEventQueue->GetStats() : EventQueueStats{ 0, 0, 0 };
+        }
+
+        // Microseconds the TimeSliced channel may take per tick, the rest waits for the next one.
+        void SetTimeSliceBudget(uint32_t microseconds)
+        {
+            m_timeSliceBudget = microseconds;
+        }
+
+        uint32_t GetTimeSliceBudget() const
+        {
+            return m_timeSliceBudget;
+        }
+
+        uint32_t GetPendingCount(EEventChannel channel) const
+        {
+            return m_channels[channel].Size();
+        }
+
         virtual void ProcessEvents() = 0;
+        virtual void ProcessEndOfFrame() = 0;
+
+        // Runs the listeners bound to context on the calling thread.
+        virtual void ProcessEvents(EventContext context) = 0;
+
+    protected:
+        // Null for event types past MAX_EVENT_TYPES.
+        template<typename Ev>
+        EventQueue<Ev>* GetEventQueue()
+        {
+            auto id = Ev::GetID();
+            if (id >= MAX_EVENT_TYPES)
+                return nullptr;
+
+            auto pEventQueue = m_pEventQueues[id].load(std::memory_order_acquire);
+            if (pEventQueue == nullptr)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                pEventQueue = m_pEventQueues[id].load(std::memory_order_relaxed);
+                if (pEventQueue == nullptr)
+                {
+                    m_pEventQueuePool.emplace_back(std::make_unique<EventQueue<Ev>>(m_ownerThread, m_channels));
+                    pEventQueue = m_pEventQueuePool.back().get();
+                    m_pEventQueues[id].store(pEventQueue, std::memory_order_release);
+                }
+            }
+
+            return static_cast<EventQueue<Ev>*>(pEventQueue);
+        }
+
+        IEventQueue* GetEventQueue(EventID id) const
+        {
+            return id < MAX_EVENT_TYPES ? m_pEventQueues[id].load(std::memory_order_acquire) : nullptr;
+        }
+
+        // Destroys the undelivered payloads of the prioritized channels.
+        void ReleaseChannels()
+        {
+            for (auto& channel : m_channels)
+            {
+                while (!channel.Empty())
+                {
+                    auto entry = channel.Pop();
+                    entry.pEventQueue->ReleaseSlot(entry.slot);
+                }
+            }
+        }
+
+    protected:
+        std::thread::id m_ownerThread;
+        EventChannel m_channels[eEventChannel_Count];
+        uint32_t m_timeSliceBudget;
+        std::atomic<IEventQueue*> m_pEventQueues[MAX_EVENT_TYPES];
+        std::vector<std::unique_ptr<IEventQueue>> m_pEventQueuePool;
+        std::mutex m_mutex;
     };
 
     class EventListener
@@ -63,38 +763,50 @@ namespace Engine
         EventListener();
         virtual ~EventListener();
 
-        template<class T>
-        bool OnEvent(IEventData::id_t id, std::function<void(std::shared_ptr<T>)> proc)
+        // The event system owns the callable from here on and passes it back as the target.
+        template<typename Ev, typename Func>
+        EventSubscription OnEvent(Func func, EventContext context = EVENT_CONTEXT_MAIN)
         {
-            return OnEvent(id, [&, proc](IEventDataPtr data){
-                auto ev = std::dynamic_pointer_cast<T>(data); 
-                if(ev) proc(ev);
-            }); 
+            auto em = gpGlobal->Get<IEventSystem>();
+            if (em == nullptr)
+                return INVALID_SUBSCRIPTION;
+
+            auto pFunc = std::make_shared<Func>(func);
+            auto subscription = em->AddListener<Ev>({ &Invoke<Ev, Func>, pFunc.get(), context }, pFunc);
+            el_mEvent.emplace_back(subscription);
+            return subscription;
         }
-        template<class T>
-        bool Dispatch(IEventData::id_t id, std::function<void(std::shared_ptr<T>)> proc)
+
+        // Drops every subscription this listener made for the event type.
+        template<typename Ev>
+        bool Dispatch()
         {
-            return Dispatch(id, [&, proc](IEventDataPtr data){
-                auto ev = std::dynamic_pointer_cast<T>(data); 
-                if(ev) proc(ev); 
-            });
+            return Dispatch(Ev::GetID());
         }
 
-    protected:
-        typedef std::pair<IEventData::id_t, EventDelegate> EventPair;
-        bool OnEvent(IEventData::id_t id, EventDelegate proc);
-        bool Dispatch(IEventData::id_t id, EventDelegate proc);
+        bool Remove(const EventSubscription& subscription);
+
+    private:
+        template<typename Ev, typename Func>
+        static void Invoke(void* pTarget, const Ev& event)
+        {
+            (*static_cast<Func*>(pTarget))(event);
+        }
+
+        bool Dispatch(EventID id);
 
     private:
-        std::weak_ptr<IEventSystem> el_mEventSystem;
-        std::vector<EventPair> el_mEvent;
-    }; 
+        std::vector<EventSubscription> el_mEvent;
+    };
 
 #define DECLARE_EVENT(id, event, msg)                                                                       \
-    Event<decltype(msg), decltype(id), id> event(msg, #id)
+    Event<decltype(msg), decltype(id), id> event(msg)
 
 #define EMITTER_EVENT(event)                                                                                \
-    gpGlobal->GetEventSystem()->QueueEvent(std::shared_ptr<IEventData>(new decltype(event)(event)))
+    gpGlobal->Get<IEventSystem>()->QueueEvent(event)
+
+#define EMITTER_EVENT_TO(event, channel, priority)                                                          \
+    gpGlobal->Get<IEventSystem>()->QueueEvent(event, channel, priority)
 
 #define DECLARE_LISTENER()                                                                                  \
     EventListener listener
@@ -103,13 +815,26 @@ namespace Engine
     {                                                                                                       \
         auto f = func;                                                                                      \
         typedef function_traits<decltype(f)> traits;                                                        \
-        listener.OnEvent<traits::arg<0>::type::element_type>(id, func);                                     \
+        typedef std::decay<traits::arg<0>::type>::type event_t;                                             \
+        static_assert(event_t::TAG == id, "listener does not take " #id);                                   \
+        listener.OnEvent<event_t>(f);                                                                       \
     }                                                                                                       \
 
+#define LISTEN_EVENT_ON(id, context, func)                                                                  \
+    {                                                                                                       \
+        auto f = func;                                                                                      \
+        typedef function_traits<decltype(f)> traits;                                                        \
+        typedef std::decay<traits::arg<0>::type>::type event_t;                                             \
+        static_assert(event_t::TAG == id, "listener does not take " #id);                                   \
+        listener.OnEvent<event_t>(f, context);                                                              \
+    }
+
 #define DISPATCH_EVENT(id, func)                                                                            \
     {                                                                                                       \
         auto f = func;                                                                                      \
         typedef function_traits<decltype(f)> traits;                                                        \
-        listener.Dispatch<traits::arg<0>::type::element_type>(id, func);                                    \
+        typedef std::decay<traits::arg<0>::type>::type event_t;                                             \
+        static_assert(event_t::TAG == id, "listener does not take " #id);                                   \
+        listener.Dispatch<event_t>();                                                                       \
     }
 }
\ No newline at end of file
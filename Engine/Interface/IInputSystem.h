@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <string>
 
 #include "IRuntimeModule.h"
 #include "IEventSystem.h"
@@ -58,6 +59,16 @@ namespace Engine
         virtual void Tick(float elapsedTime) override = 0;
 
         virtual void DispatchInputEvent(EInputEvent event, InputMsg msg) = 0;
+
+        // Records every input drained by Tick together with the elapsed time of that tick.
+        virtual bool StartRecording(const std::string& path) = 0;
+        virtual void StopRecording() = 0;
+
+        // While replaying live input is ignored. Each BeginReplayFrame queues the input of the
+        // next recorded frame and returns its elapsed time, false once the recording ends.
+        virtual bool StartReplay(const std::string& path) = 0;
+        virtual void StopReplay() = 0;
+        virtual bool IsReplaying() const = 0;
+        virtual bool BeginReplayFrame(float& elapsedTime) = 0;
     };
 }
-
@@ -33,10 +33,10 @@ namespace Engine
 
         virtual const std::vector<std::shared_ptr<Attribute>> GetAttributes() const = 0;
         virtual const std::shared_ptr<char> GetIndexData() const = 0;
-        virtual const uint32_t IndexSize() const = 0;
+        virtual uint32_t IndexSize() const = 0;
 
-        virtual const uint32_t VertexCount() const = 0;
-        virtual const uint32_t IndexCount() const = 0;
+        virtual uint32_t VertexCount() const = 0;
+        virtual uint32_t IndexCount() const = 0;
 
         virtual void AttachVertexData(const char array[], const uint32_t size, const uint32_t count, Attribute::ESemanticType type, std::string name) = 0;
         virtual void AttachIndexData(const char array[], const uint32_t size, const uint32_t count) = 0;
@@ -11,6 +11,6 @@ namespace Engine
     public:
         virtual ~IRenderable() = default;
 
-        virtual void GetRenderable(RenderQueue &queue, const TransformComponent* pTransformComp) const = 0;
+        virtual void GetRenderable(RenderQueue &queue, const float4x4* pWorldMatrix) const = 0;
     };
 }
\ No newline at end of file
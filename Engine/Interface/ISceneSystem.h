@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IRuntimeModule.h"
+#include "ECSArchetype.h"
+#include "Matrix.h"
 
 namespace Engine
 {
@@ -14,5 +16,10 @@ namespace Engine
         virtual void Shutdown() = 0;
 
         virtual void Tick(float elapsedTime) = 0;
+
+        // Blended between the last two simulation steps for rendering. Points into one
+        // contiguous array, valid until the layout version changes.
+        virtual const float4x4* GetWorldMatrix(Entity entity) const = 0;
+        virtual uint32_t GetLayoutVersion() const = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cmath>
+#include <float.h>
+
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace Engine
+{
+    class AABB3
+    {
+    public:
+        Vec3<float> mMin, mMax;
+
+        AABB3()
+        {
+            Clear();
+        }
+
+        AABB3(const Vec3<float>& min, const Vec3<float>& max) : mMin(min), mMax(max)
+        {
+        }
+
+        static AABB3 FromCenterExtent(const Vec3<float>& center, const Vec3<float>& extent)
+        {
+            return AABB3(center - extent, center + extent);
+        }
+
+        Vec3<float> Center() const
+        {
+            return mMax * 0.5f + mMin * 0.5f;
+        }
+
+        // Half the size, negative on an empty box.
+        Vec3<float> Extent() const
+        {
+            return mMax * 0.5f - mMin * 0.5f;
+        }
+
+        Vec3<float> Size() const
+        {
+            return mMax - mMin;
+        }
+
+        // A single point is not empty, min > max on any axis is.
+        bool IsEmpty() const
+        {
+            return mMin.x > mMax.x || mMin.y > mMax.y || mMin.z > mMax.z;
+        }
+
+        void Clear()
+        {
+            mMin = Vec3<float>(FLT_MAX, FLT_MAX, FLT_MAX);
+            mMax = Vec3<float>(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        }
+
+        void Expand(const Vec3<float>& point)
+        {
+            MATH_LOOP_OPERATION(i, 3, mMin[i] = point[i] < mMin[i] ? point[i] : mMin[i]);
+            MATH_LOOP_OPERATION(i, 3, mMax[i] = point[i] > mMax[i] ? point[i] : mMax[i]);
+        }
+
+        void Expand(const AABB3& box)
+        {
+            MATH_LOOP_OPERATION(i, 3, mMin[i] = box.mMin[i] < mMin[i] ? box.mMin[i] : mMin[i]);
+            MATH_LOOP_OPERATION(i, 3, mMax[i] = box.mMax[i] > mMax[i] ? box.mMax[i] : mMax[i]);
+        }
+
+        // Boundaries count as inside.
+        bool Contains(const Vec3<float>& point) const
+        {
+            return point.x >= mMin.x && point.x <= mMax.x &&
+                   point.y >= mMin.y && point.y <= mMax.y &&
+                   point.z >= mMin.z && point.z <= mMax.z;
+        }
+
+        bool Intersects(const AABB3& box) const
+        {
+            return mMin.x <= box.mMax.x && mMax.x >= box.mMin.x &&
+                   mMin.y <= box.mMax.y && mMax.y >= box.mMin.y &&
+                   mMin.z <= box.mMax.z && mMax.z >= box.mMin.z;
+        }
+
+        // The box around the transformed corners, found from the center and the absolute matrix
+        // instead of eight points. An empty box stays empty.
+        AABB3 Transform(const Mat4x4<float>& mat) const
+        {
+            Vec3<float> center = Mat::TransformPoint(Center(), mat);
+            Vec3<float> extent = Extent();
+            Vec3<float> newExtent;
+            MATH_LOOP_OPERATION(i, 3, newExtent[i] = std::abs(mat[0][i]) * extent.x + std::abs(mat[1][i]) * extent.y + std::abs(mat[2][i]) * extent.z);
+            return AABB3(center - newExtent, center + newExtent);
+        }
+    };
+}
\ No newline at end of file
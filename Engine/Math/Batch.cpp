@@ -0,0 +1,274 @@
+#include <assert.h>
+#include <atomic>
+#include <stdint.h>
+
+#include "Batch.h"
+#include "Batch_kernels.h"
+
+#if defined(MATH_SIMD_SSE)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+using namespace Engine;
+
+namespace
+{
+    struct LanesScalar
+    {
+        typedef float Register;
+        constexpr static size_t WIDTH = 1;
+
+        static Register Load(const float* pData)                        { return *pData; }
+        static void Store(float* pData, Register v)                     { *pData = v; }
+        static Register Splat(float value)                              { return value; }
+        static Register Add(Register a, Register b)                     { return a + b; }
+        static Register Sub(Register a, Register b)                     { return a - b; }
+        static Register Mul(Register a, Register b)                     { return a * b; }
+        static Register MulAdd(Register a, Register b, Register c)      { return a * b + c; }
+        static Register Min(Register a, Register b)                     { return a < b ? a : b; }
+        static Register Max(Register a, Register b)                     { return a > b ? a : b; }
+    };
+
+#if defined(MATH_SIMD)
+    struct LanesSIMD128
+    {
+        typedef Simd::Register Register;
+        constexpr static size_t WIDTH = 4;
+
+        static Register Load(const float* pData)                        { return Simd::Load(pData); }
+        static void Store(float* pData, Register v)                     { Simd::Store(pData, v); }
+        static Register Splat(float value)                              { return Simd::Splat(value); }
+        static Register Add(Register a, Register b)                     { return Simd::Add(a, b); }
+        static Register Sub(Register a, Register b)                     { return Simd::Sub(a, b); }
+        static Register Mul(Register a, Register b)                     { return Simd::Mul(a, b); }
+        static Register MulAdd(Register a, Register b, Register c)      { return Simd::MulAdd(a, b, c); }
+        static Register Min(Register a, Register b)                     { return Simd::Min(a, b); }
+        static Register Max(Register a, Register b)                     { return Simd::Max(a, b); }
+    };
+#endif
+
+#if defined(MATH_SIMD_SSE)
+    void CpuId(int leaf, int subLeaf, uint32_t (&regs)[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, leaf, subLeaf);
+        for (int i = 0; i < 4; i++)
+            regs[i] = static_cast<uint32_t>(info[i]);
+#else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    uint64_t GetEnabledXState()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    Batch::ELevel DetectLevel()
+    {
+#if defined(MATH_SIMD_SSE)
+        uint32_t regs[4];
+        CpuId(0, 0, regs);
+        if (regs[0] < 7)
+            return Batch::eLevel_SIMD128;
+
+        CpuId(1, 0, regs);
+        bool bOSXSave = (regs[2] >> 27) & 1;
+        bool bFMA = (regs[2] >> 12) & 1;
+        if (!bOSXSave || !bFMA)
+            return Batch::eLevel_SIMD128;
+
+        // The OS has to save the wider registers too, XMM | YMM and then opmask | ZMM.
+        uint64_t xState = GetEnabledXState();
+        CpuId(7, 0, regs);
+        bool bAVX2 = ((regs[1] >> 5) & 1) && (xState & 0x6) == 0x6;
+        bool bAVX512 = ((regs[1] >> 16) & 1) && (xState & 0xE6) == 0xE6;
+
+        if (bAVX2 && bAVX512 && GetBatchKernelsAVX512() != nullptr)
+            return Batch::eLevel_AVX512;
+        if (bAVX2 && GetBatchKernelsAVX2() != nullptr)
+            return Batch::eLevel_AVX2;
+        return Batch::eLevel_SIMD128;
+#elif defined(MATH_SIMD)
+        return Batch::eLevel_SIMD128;
+#else
+        return Batch::eLevel_Scalar;
+#endif
+    }
+
+    std::atomic<int>& GetLevelState()
+    {
+        static std::atomic<int> level(Batch::GetSupportedLevel());
+        return level;
+    }
+
+    void GetPlaneData(const Frustum& frustum, float* pData)
+    {
+        for (int i = 0; i < Frustum::ePlane_Count; i++)
+        {
+            MATH_LOOP_OPERATION(j, 3, pData[i * 4 + j] = frustum.mPlanes[i].mNormal[j]);
+            pData[i * 4 + 3] = frustum.mPlanes[i].mDistance;
+        }
+    }
+
+    const BatchKernels* GetActiveKernels()
+    {
+        switch (GetLevelState().load(std::memory_order_relaxed))
+        {
+        case Batch::eLevel_AVX512:
+            return GetBatchKernelsAVX512();
+        case Batch::eLevel_AVX2:
+            return GetBatchKernelsAVX2();
+        case Batch::eLevel_SIMD128:
+            return GetBatchKernelsSIMD128();
+        default:
+            return GetBatchKernelsScalar();
+        }
+    }
+}
+
+const BatchKernels* Engine::GetBatchKernelsScalar()
+{
+    return BatchKernel::GetKernels<LanesScalar>();
+}
+
+const BatchKernels* Engine::GetBatchKernelsSIMD128()
+{
+#if defined(MATH_SIMD)
+    return BatchKernel::GetKernels<LanesSIMD128>();
+#else
+    return nullptr;
+#endif
+}
+
+Batch::ELevel Batch::GetSupportedLevel()
+{
+    static ELevel level = DetectLevel();
+    return level;
+}
+
+Batch::ELevel Batch::GetLevel()
+{
+    return static_cast<ELevel>(GetLevelState().load(std::memory_order_relaxed));
+}
+
+void Batch::SetLevel(ELevel level)
+{
+    GetLevelState() = level < GetSupportedLevel() ? level : GetSupportedLevel();
+}
+
+const char* Batch::GetLevelName(ELevel level)
+{
+    switch (level)
+    {
+    case eLevel_SIMD128:
+        return "SIMD128";
+    case eLevel_AVX2:
+        return "AVX2";
+    case eLevel_AVX512:
+        return "AVX512";
+    default:
+        return "Scalar";
+    }
+}
+
+void Batch::TransformPoints(const Vec3SoA& points, const float4x4& mat, Vec3SoA& result)
+{
+    result.Resize(points.Size());
+    if (points.Size() == 0)
+        return;
+
+    float matData[16];
+    MATH_LOOP_OPERATION(i, 4, MATH_LOOP_OPERATION(j, 4, matData[i * 4 + j] = mat[i][j]));
+    GetActiveKernels()->pTransformPoints(matData, points.GetComponents(), result.GetComponents(), points.Size());
+}
+
+void Batch::MulMatrices(const Mat4SoA& mat1, const Mat4SoA& mat2, Mat4SoA& result)
+{
+    assert(mat1.Size() == mat2.Size());
+    result.Resize(mat1.Size());
+    if (mat1.Size() == 0)
+        return;
+
+    GetActiveKernels()->pMulMatrices(mat1.GetComponents(), mat2.GetComponents(), result.GetComponents(), mat1.Size());
+}
+
+void Batch::ComposeTRS(const Vec3SoA& translation, const Vec4SoA& rotation, const Vec3SoA& scale, Mat4SoA& result)
+{
+    assert(translation.Size() == rotation.Size() && translation.Size() == scale.Size());
+    result.Resize(translation.Size());
+    if (translation.Size() == 0)
+        return;
+
+    GetActiveKernels()->pComposeTRS(translation.GetComponents(), rotation.GetComponents(), scale.GetComponents(), result.GetComponents(), translation.Size());
+}
+
+void Batch::ComputeBounds(const Vec3SoA& points, float3& min, float3& max)
+{
+    min = float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    max = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    if (points.Size() == 0)
+        return;
+
+    float minData[3], maxData[3];
+    GetActiveKernels()->pComputeBounds(points.GetComponents(), points.Size(), minData, maxData);
+    min = float3(minData[0], minData[1], minData[2]);
+    max = float3(maxData[0], maxData[1], maxData[2]);
+}
+
+void Batch::TransformAABBs(const AABB3SoA& boxes, const float4x4& mat, AABB3SoA& result)
+{
+    result.Resize(boxes.Size());
+    if (boxes.Size() == 0)
+        return;
+
+    float matData[16];
+    MATH_LOOP_OPERATION(i, 4, MATH_LOOP_OPERATION(j, 4, matData[i * 4 + j] = mat[i][j]));
+    GetActiveKernels()->pTransformAABBs(matData, boxes.GetComponents(), result.GetComponents(), boxes.Size());
+}
+
+void Batch::CullAABBs(const Frustum& frustum, const AABB3SoA& boxes, std::vector<uint8_t>& visible)
+{
+    visible.resize(boxes.Size());
+    if (boxes.Size() == 0)
+        return;
+
+    float planeData[Frustum::ePlane_Count * 4];
+    GetPlaneData(frustum, planeData);
+    GetActiveKernels()->pCullAABBs(planeData, boxes.GetComponents(), visible.data(), boxes.Size());
+}
+
+void Batch::CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::vector<uint8_t>& visible)
+{
+    visible.resize(spheres.Size());
+    if (spheres.Size() == 0)
+        return;
+
+    float planeData[Frustum::ePlane_Count * 4];
+    GetPlaneData(frustum, planeData);
+    GetActiveKernels()->pCullSpheres(planeData, spheres.GetComponents(), visible.data(), spheres.Size());
+}
+
+void Batch::IntersectRay(const Ray& ray, const AABB3SoA& boxes, std::vector<uint8_t>& hit)
+{
+    hit.resize(boxes.Size());
+    if (boxes.Size() == 0)
+        return;
+
+    float rayData[6];
+    MATH_LOOP_OPERATION(i, 3, rayData[i] = ray.mOrigin[i]);
+    MATH_LOOP_OPERATION(i, 3, rayData[3 + i] = ray.mDirection[i]);
+    GetActiveKernels()->pIntersectRay(rayData, boxes.GetComponents(), hit.data(), boxes.Size());
+}
\ No newline at end of file
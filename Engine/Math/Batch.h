@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "SoA.h"
+#include "Frustum.h"
+#include "Ray.h"
+
+namespace Engine
+{
+    // Kernels over whole SoA arrays, 4, 8 or 16 elements per instruction. The widest
+    // instruction set the CPU supports is picked the first time a kernel runs.
+    class Batch
+    {
+    public:
+        enum ELevel
+        {
+            eLevel_Scalar,
+            eLevel_SIMD128,
+            eLevel_AVX2,
+            eLevel_AVX512,
+        };
+
+        static ELevel GetSupportedLevel();
+        static ELevel GetLevel();
+        // Clamped to the supported level, lets benchmarks and tests run the narrower paths.
+        static void SetLevel(ELevel level);
+        static const char* GetLevelName(ELevel level);
+
+        // result[i] = TransformPoint(points[i], mat)
+        static void TransformPoints(const Vec3SoA& points, const float4x4& mat, Vec3SoA& result);
+        // result[i] = Mul(mat1[i], mat2[i]), result may be either input.
+        static void MulMatrices(const Mat4SoA& mat1, const Mat4SoA& mat2, Mat4SoA& result);
+        // result[i] = scale * rotate * translate, rotations are unit quaternions (x, y, z, w).
+        static void ComposeTRS(const Vec3SoA& translation, const Vec4SoA& rotation, const Vec3SoA& scale, Mat4SoA& result);
+        // An empty array gives min = FLT_MAX and max = -FLT_MAX.
+        static void ComputeBounds(const Vec3SoA& points, float3& min, float3& max);
+
+        // result[i] = boxes[i].Transform(mat), result may be boxes.
+        static void TransformAABBs(const AABB3SoA& boxes, const float4x4& mat, AABB3SoA& result);
+        // visible[i] = frustum.Intersects(boxes[i]), 0 or 1.
+        static void CullAABBs(const Frustum& frustum, const AABB3SoA& boxes, std::vector<uint8_t>& visible);
+        // visible[i] = frustum.Intersects(spheres[i]), 0 or 1.
+        static void CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::vector<uint8_t>& visible);
+        // hit[i] = ray.Intersects(boxes[i], distance), 0 or 1. Run Ray::Intersects on the hits for the distance.
+        static void IntersectRay(const Ray& ray, const AABB3SoA& boxes, std::vector<uint8_t>& hit);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+// Built with AVX2 and FMA enabled, only called once Batch has checked the CPU.
+#include "Batch_kernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+using namespace Engine;
+
+namespace
+{
+    struct LanesAVX2
+    {
+        typedef __m256 Register;
+        constexpr static size_t WIDTH = 8;
+
+        static Register Load(const float* pData)                        { return _mm256_loadu_ps(pData); }
+        static void Store(float* pData, Register v)                     { _mm256_storeu_ps(pData, v); }
+        static Register Splat(float value)                              { return _mm256_set1_ps(value); }
+        static Register Add(Register a, Register b)                     { return _mm256_add_ps(a, b); }
+        static Register Sub(Register a, Register b)                     { return _mm256_sub_ps(a, b); }
+        static Register Mul(Register a, Register b)                     { return _mm256_mul_ps(a, b); }
+        static Register MulAdd(Register a, Register b, Register c)      { return _mm256_fmadd_ps(a, b, c); }
+        static Register Min(Register a, Register b)                     { return _mm256_min_ps(a, b); }
+        static Register Max(Register a, Register b)                     { return _mm256_max_ps(a, b); }
+    };
+}
+
+const BatchKernels* Engine::GetBatchKernelsAVX2()
+{
+    return BatchKernel::GetKernels<LanesAVX2>();
+}
+#else
+const Engine::BatchKernels* Engine::GetBatchKernelsAVX2()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
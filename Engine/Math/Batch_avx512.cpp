@@ -0,0 +1,37 @@
+// Built with AVX-512 enabled, only called once Batch has checked the CPU.
+#include "Batch_kernels.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+using namespace Engine;
+
+namespace
+{
+    struct LanesAVX512
+    {
+        typedef __m512 Register;
+        constexpr static size_t WIDTH = 16;
+
+        static Register Load(const float* pData)                        { return _mm512_loadu_ps(pData); }
+        static void Store(float* pData, Register v)                     { _mm512_storeu_ps(pData, v); }
+        static Register Splat(float value)                              { return _mm512_set1_ps(value); }
+        static Register Add(Register a, Register b)                     { return _mm512_add_ps(a, b); }
+        static Register Sub(Register a, Register b)                     { return _mm512_sub_ps(a, b); }
+        static Register Mul(Register a, Register b)                     { return _mm512_mul_ps(a, b); }
+        static Register MulAdd(Register a, Register b, Register c)      { return _mm512_fmadd_ps(a, b, c); }
+        static Register Min(Register a, Register b)                     { return _mm512_min_ps(a, b); }
+        static Register Max(Register a, Register b)                     { return _mm512_max_ps(a, b); }
+    };
+}
+
+const BatchKernels* Engine::GetBatchKernelsAVX512()
+{
+    return BatchKernel::GetKernels<LanesAVX512>();
+}
+#else
+const Engine::BatchKernels* Engine::GetBatchKernelsAVX512()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
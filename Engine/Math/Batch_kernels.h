@@ -0,0 +1,356 @@
+#pragma once
+
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Kernel bodies shared by the Batch translation units. Each unit instantiates them with its own
+// lane type and instruction set flags, so nothing in here may use inline code from other headers.
+namespace Engine
+{
+    struct BatchKernels
+    {
+        void (*pTransformPoints)(const float* pMat, const float* const* pPoints, float* const* pResult, size_t count);
+        void (*pMulMatrices)(const float* const* pMat1, const float* const* pMat2, float* const* pResult, size_t count);
+        void (*pComposeTRS)(const float* const* pTranslation, const float* const* pRotation, const float* const* pScale, float* const* pResult, size_t count);
+        void (*pComputeBounds)(const float* const* pPoints, size_t count, float* pMin, float* pMax);
+        void (*pTransformAABBs)(const float* pMat, const float* const* pBoxes, float* const* pResult, size_t count);
+        void (*pCullAABBs)(const float* pPlanes, const float* const* pBoxes, uint8_t* pVisible, size_t count);
+        void (*pCullSpheres)(const float* pPlanes, const float* const* pSpheres, uint8_t* pVisible, size_t count);
+        void (*pIntersectRay)(const float* pRay, const float* const* pBoxes, uint8_t* pHit, size_t count);
+    };
+
+    const BatchKernels* GetBatchKernelsScalar();
+    const BatchKernels* GetBatchKernelsSIMD128();
+    const BatchKernels* GetBatchKernelsAVX2();
+    const BatchKernels* GetBatchKernelsAVX512();
+
+    namespace BatchKernel
+    {
+        // Calls block(pIn, pOut, offset) for every whole batch of L::WIDTH elements. The tail goes
+        // through one batch on the stack, padded with the last element.
+        template<typename L, int IN, int OUT, typename Block>
+        inline void Run(const float* const* pIn, float* const* pOut, size_t count, Block block)
+        {
+            size_t offset = 0;
+            for (; offset + L::WIDTH <= count; offset += L::WIDTH)
+                block(pIn, pOut, offset);
+
+            if (offset == count)
+                return;
+
+            alignas(64) float tailIn[IN][L::WIDTH];
+            alignas(64) float tailOut[OUT > 0 ? OUT : 1][L::WIDTH];
+            const float* pTailIn[IN];
+            float* pTailOut[OUT > 0 ? OUT : 1];
+            for (int i = 0; i < IN; i++)
+            {
+                for (size_t j = 0; j < L::WIDTH; j++)
+                    tailIn[i][j] = pIn[i][offset + j < count ? offset + j : count - 1];
+                pTailIn[i] = tailIn[i];
+            }
+            for (int i = 0; i < OUT; i++)
+                pTailOut[i] = tailOut[i];
+
+            block(pTailIn, pTailOut, 0);
+
+            for (int i = 0; i < OUT; i++)
+                for (size_t j = 0; offset + j < count; j++)
+                    pOut[i][offset + j] = tailOut[i][j];
+        }
+
+        // Run for kernels that reduce each element to a flag, block(pIn, offset) returns lanes
+        // that are >= 0 where the flag is set. Batches arrive in order, so the tail is found
+        // by counting instead of by offset.
+        template<typename L, int IN, typename Block>
+        inline void RunMask(const float* const* pIn, uint8_t* pMask, size_t count, Block block)
+        {
+            size_t index = 0;
+            Run<L, IN, 0>(pIn, nullptr, count, [&](const float* const* pIn, float* const*, size_t offset)
+            {
+                alignas(64) float lanes[L::WIDTH];
+                L::Store(lanes, block(pIn, offset));
+                for (size_t j = 0; j < L::WIDTH && index < count; j++, index++)
+                    pMask[index] = lanes[j] >= 0.0f ? 1 : 0;
+            });
+        }
+
+        template<typename L>
+        inline void TransformPoints(const float* pMat, const float* const* pPoints, float* const* pResult, size_t count)
+        {
+            typedef typename L::Register R;
+            R mat[16];
+            for (int i = 0; i < 16; i++)
+                mat[i] = L::Splat(pMat[i]);
+
+            Run<L, 3, 3>(pPoints, pResult, count, [&mat](const float* const* pIn, float* const* pOut, size_t offset)
+            {
+                R x = L::Load(pIn[0] + offset);
+                R y = L::Load(pIn[1] + offset);
+                R z = L::Load(pIn[2] + offset);
+                for (int i = 0; i < 3; i++)
+                    L::Store(pOut[i] + offset, L::MulAdd(x, mat[i], L::MulAdd(y, mat[4 + i], L::MulAdd(z, mat[8 + i], mat[12 + i]))));
+            });
+        }
+
+        template<typename L>
+        inline void MulMatrices(const float* const* pMat1, const float* const* pMat2, float* const* pResult, size_t count)
+        {
+            typedef typename L::Register R;
+            const float* pIn[32];
+            for (int i = 0; i < 16; i++)
+            {
+                pIn[i] = pMat1[i];
+                pIn[16 + i] = pMat2[i];
+            }
+
+            Run<L, 32, 16>(pIn, pResult, count, [](const float* const* pIn, float* const* pOut, size_t offset)
+            {
+                // All of the second matrix first, the result may alias either input.
+                R mat2[16];
+                for (int i = 0; i < 16; i++)
+                    mat2[i] = L::Load(pIn[16 + i] + offset);
+
+                for (int i = 0; i < 4; i++)
+                {
+                    R a0 = L::Load(pIn[i * 4] + offset);
+                    R a1 = L::Load(pIn[i * 4 + 1] + offset);
+                    R a2 = L::Load(pIn[i * 4 + 2] + offset);
+                    R a3 = L::Load(pIn[i * 4 + 3] + offset);
+                    for (int j = 0; j < 4; j++)
+                        L::Store(pOut[i * 4 + j] + offset, L::MulAdd(a0, mat2[j], L::MulAdd(a1, mat2[4 + j], L::MulAdd(a2, mat2[8 + j], L::Mul(a3, mat2[12 + j])))));
+                }
+            });
+        }
+
+        template<typename L>
+        inline void ComposeTRS(const float* const* pTranslation, const float* const* pRotation, const float* const* pScale, float* const* pResult, size_t count)
+        {
+            typedef typename L::Register R;
+            const float* pIn[10];
+            for (int i = 0; i < 3; i++)
+            {
+                pIn[i] = pTranslation[i];
+                pIn[7 + i] = pScale[i];
+            }
+            for (int i = 0; i < 4; i++)
+                pIn[3 + i] = pRotation[i];
+
+            Run<L, 10, 16>(pIn, pResult, count, [](const float* const* pIn, float* const* pOut, size_t offset)
+            {
+                R tx = L::Load(pIn[0] + offset), ty = L::Load(pIn[1] + offset), tz = L::Load(pIn[2] + offset);
+                R x = L::Load(pIn[3] + offset), y = L::Load(pIn[4] + offset), z = L::Load(pIn[5] + offset), w = L::Load(pIn[6] + offset);
+                R sx = L::Load(pIn[7] + offset), sy = L::Load(pIn[8] + offset), sz = L::Load(pIn[9] + offset);
+
+                R x2 = L::Add(x, x), y2 = L::Add(y, y), z2 = L::Add(z, z);
+                R xx = L::Mul(x, x2), yy = L::Mul(y, y2), zz = L::Mul(z, z2);
+                R xy = L::Mul(x, y2), xz = L::Mul(x, z2), yz = L::Mul(y, z2);
+                R wx = L::Mul(w, x2), wy = L::Mul(w, y2), wz = L::Mul(w, z2);
+                R one = L::Splat(1.0f), zero = L::Splat(0.0f);
+
+                // Scale, then the rotation of Mat::QuatRotateLH, then translation.
+                L::Store(pOut[0] + offset, L::Mul(sx, L::Sub(one, L::Add(yy, zz))));
+                L::Store(pOut[1] + offset, L::Mul(sx, L::Add(xy, wz)));
+                L::Store(pOut[2] + offset, L::Mul(sx, L::Sub(xz, wy)));
+                L::Store(pOut[3] + offset, zero);
+                L::Store(pOut[4] + offset, L::Mul(sy, L::Sub(xy, wz)));
+                L::Store(pOut[5] + offset, L::Mul(sy, L::Sub(one, L::Add(xx, zz))));
+                L::Store(pOut[6] + offset, L::Mul(sy, L::Add(yz, wx)));
+                L::Store(pOut[7] + offset, zero);
+                L::Store(pOut[8] + offset, L::Mul(sz, L::Add(xz, wy)));
+                L::Store(pOut[9] + offset, L::Mul(sz, L::Sub(yz, wx)));
+                L::Store(pOut[10] + offset, L::Mul(sz, L::Sub(one, L::Add(xx, yy))));
+                L::Store(pOut[11] + offset, zero);
+                L::Store(pOut[12] + offset, tx);
+                L::Store(pOut[13] + offset, ty);
+                L::Store(pOut[14] + offset, tz);
+                L::Store(pOut[15] + offset, one);
+            });
+        }
+
+        template<typename L>
+        inline void ComputeBounds(const float* const* pPoints, size_t count, float* pMin, float* pMax)
+        {
+            typedef typename L::Register R;
+            R lower[3], upper[3];
+            for (int i = 0; i < 3; i++)
+            {
+                lower[i] = L::Splat(FLT_MAX);
+                upper[i] = L::Splat(-FLT_MAX);
+            }
+
+            Run<L, 3, 0>(pPoints, nullptr, count, [&lower, &upper](const float* const* pIn, float* const*, size_t offset)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    R value = L::Load(pIn[i] + offset);
+                    lower[i] = L::Min(lower[i], value);
+                    upper[i] = L::Max(upper[i], value);
+                }
+            });
+
+            for (int i = 0; i < 3; i++)
+            {
+                alignas(64) float lowerLanes[L::WIDTH];
+                alignas(64) float upperLanes[L::WIDTH];
+                L::Store(lowerLanes, lower[i]);
+                L::Store(upperLanes, upper[i]);
+                pMin[i] = FLT_MAX;
+                pMax[i] = -FLT_MAX;
+                for (size_t j = 0; j < L::WIDTH; j++)
+                {
+                    pMin[i] = lowerLanes[j] < pMin[i] ? lowerLanes[j] : pMin[i];
+                    pMax[i] = upperLanes[j] > pMax[i] ? upperLanes[j] : pMax[i];
+                }
+            }
+        }
+
+        // Boxes are min xyz then max xyz. Center and extent go through the matrix and its
+        // absolute value, halves are taken first so an empty box does not overflow.
+        template<typename L>
+        inline void TransformAABBs(const float* pMat, const float* const* pBoxes, float* const* pResult, size_t count)
+        {
+            typedef typename L::Register R;
+            R mat[12], absMat[9];
+            for (int i = 0; i < 4; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    mat[i * 3 + j] = L::Splat(pMat[i * 4 + j]);
+                    if (i < 3)
+                        absMat[i * 3 + j] = L::Splat(pMat[i * 4 + j] < 0.0f ? -pMat[i * 4 + j] : pMat[i * 4 + j]);
+                }
+            }
+
+            Run<L, 6, 6>(pBoxes, pResult, count, [&mat, &absMat](const float* const* pIn, float* const* pOut, size_t offset)
+            {
+                R half = L::Splat(0.5f);
+                R center[3], extent[3];
+                for (int i = 0; i < 3; i++)
+                {
+                    R lower = L::Mul(L::Load(pIn[i] + offset), half);
+                    R upper = L::Mul(L::Load(pIn[3 + i] + offset), half);
+                    center[i] = L::Add(upper, lower);
+                    extent[i] = L::Sub(upper, lower);
+                }
+
+                for (int i = 0; i < 3; i++)
+                {
+                    R newCenter = L::MulAdd(center[0], mat[i], L::MulAdd(center[1], mat[3 + i], L::MulAdd(center[2], mat[6 + i], mat[9 + i])));
+                    R newExtent = L::MulAdd(extent[0], absMat[i], L::MulAdd(extent[1], absMat[3 + i], L::Mul(extent[2], absMat[6 + i])));
+                    L::Store(pOut[i] + offset, L::Sub(newCenter, newExtent));
+                    L::Store(pOut[3 + i] + offset, L::Add(newCenter, newExtent));
+                }
+            });
+        }
+
+        // Planes are a, b, c, d facing inward. The distance of the corner furthest along each
+        // normal, the smallest over all planes is negative once the box is outside one of them.
+        template<typename L>
+        inline void CullAABBs(const float* pPlanes, const float* const* pBoxes, uint8_t* pVisible, size_t count)
+        {
+            typedef typename L::Register R;
+            R planes[6][4], absNormals[6][3];
+            for (int i = 0; i < 6; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                    planes[i][j] = L::Splat(pPlanes[i * 4 + j]);
+                for (int j = 0; j < 3; j++)
+                    absNormals[i][j] = L::Splat(pPlanes[i * 4 + j] < 0.0f ? -pPlanes[i * 4 + j] : pPlanes[i * 4 + j]);
+            }
+
+            RunMask<L, 6>(pBoxes, pVisible, count, [&planes, &absNormals](const float* const* pIn, size_t offset)
+            {
+                R half = L::Splat(0.5f);
+                R center[3], extent[3];
+                for (int i = 0; i < 3; i++)
+                {
+                    R lower = L::Mul(L::Load(pIn[i] + offset), half);
+                    R upper = L::Mul(L::Load(pIn[3 + i] + offset), half);
+                    center[i] = L::Add(upper, lower);
+                    extent[i] = L::Sub(upper, lower);
+                }
+
+                R distance = L::Splat(FLT_MAX);
+                for (int i = 0; i < 6; i++)
+                {
+                    R radius = L::MulAdd(extent[0], absNormals[i][0], L::MulAdd(extent[1], absNormals[i][1], L::Mul(extent[2], absNormals[i][2])));
+                    R plane = L::MulAdd(center[0], planes[i][0], L::MulAdd(center[1], planes[i][1], L::MulAdd(center[2], planes[i][2], planes[i][3])));
+                    distance = L::Min(distance, L::Add(plane, radius));
+                }
+                return distance;
+            });
+        }
+
+        // Spheres are center xyz then radius, planes as in CullAABBs.
+        template<typename L>
+        inline void CullSpheres(const float* pPlanes, const float* const* pSpheres, uint8_t* pVisible, size_t count)
+        {
+            typedef typename L::Register R;
+            R planes[6][4];
+            for (int i = 0; i < 6; i++)
+                for (int j = 0; j < 4; j++)
+                    planes[i][j] = L::Splat(pPlanes[i * 4 + j]);
+
+            RunMask<L, 4>(pSpheres, pVisible, count, [&planes](const float* const* pIn, size_t offset)
+            {
+                R x = L::Load(pIn[0] + offset), y = L::Load(pIn[1] + offset), z = L::Load(pIn[2] + offset);
+                R radius = L::Load(pIn[3] + offset);
+
+                R distance = L::Splat(FLT_MAX);
+                for (int i = 0; i < 6; i++)
+                    distance = L::Min(distance, L::MulAdd(x, planes[i][0], L::MulAdd(y, planes[i][1], L::MulAdd(z, planes[i][2], planes[i][3]))));
+                return L::Add(distance, radius);
+            });
+        }
+
+        // The ray is origin xyz then direction xyz, the slab test of Ray::Intersects. Axes the
+        // ray is parallel to only check that the origin lies between the slab planes.
+        template<typename L>
+        inline void IntersectRay(const float* pRay, const float* const* pBoxes, uint8_t* pHit, size_t count)
+        {
+            typedef typename L::Register R;
+            R origin[3], invDirection[3];
+            bool bParallel[3], bNegative[3];
+            for (int i = 0; i < 3; i++)
+            {
+                origin[i] = L::Splat(pRay[i]);
+                bParallel[i] = pRay[3 + i] == 0.0f;
+                bNegative[i] = pRay[3 + i] < 0.0f;
+                invDirection[i] = L::Splat(bParallel[i] ? 0.0f : 1.0f / pRay[3 + i]);
+            }
+
+            RunMask<L, 6>(pBoxes, pHit, count, [&origin, &invDirection, &bParallel, &bNegative](const float* const* pIn, size_t offset)
+            {
+                R tNear = L::Splat(0.0f);
+                R tFar = L::Splat(FLT_MAX);
+                R inside = L::Splat(FLT_MAX);
+                for (int i = 0; i < 3; i++)
+                {
+                    R lower = L::Sub(L::Load(pIn[i] + offset), origin[i]);
+                    R upper = L::Sub(L::Load(pIn[3 + i] + offset), origin[i]);
+                    if (bParallel[i])
+                    {
+                        // Negative when the origin is below the min or above the max.
+                        inside = L::Min(inside, L::Min(L::Sub(L::Splat(0.0f), lower), upper));
+                        continue;
+                    }
+
+                    R t0 = L::Mul(bNegative[i] ? upper : lower, invDirection[i]);
+                    R t1 = L::Mul(bNegative[i] ? lower : upper, invDirection[i]);
+                    tNear = L::Max(tNear, t0);
+                    tFar = L::Min(tFar, t1);
+                }
+                return L::Min(L::Sub(tFar, tNear), inside);
+            });
+        }
+
+        template<typename L>
+        inline const BatchKernels* GetKernels()
+        {
+            static const BatchKernels kernels = { &TransformPoints<L>, &MulMatrices<L>, &ComposeTRS<L>, &ComputeBounds<L>,
+                &TransformAABBs<L>, &CullAABBs<L>, &CullSpheres<L>, &IntersectRay<L> };
+            return &kernels;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Plane.h"
+#include "AABB3.h"
+#include "Sphere.h"
+
+namespace Engine
+{
+    // Six planes facing inward, a point is inside when it is on the positive side of all of them.
+    class Frustum
+    {
+    public:
+        enum EPlane
+        {
+            ePlane_Left,
+            ePlane_Right,
+            ePlane_Bottom,
+            ePlane_Top,
+            ePlane_Near,
+            ePlane_Far,
+            ePlane_Count,
+        };
+
+        Plane mPlanes[ePlane_Count];
+
+        Frustum() = default;
+
+        // From a row vector view-projection matrix with clip depth 0 to w, as built by
+        // Mat::PerspectiveFovLH or Mat::OrthoLH. Planes are in the space the matrix takes
+        // points from, the world space for view * projection.
+        explicit Frustum(const Mat4x4<float>& viewProj)
+        {
+            auto column = [&viewProj](int j) {
+                return Vec4<float>(viewProj[0][j], viewProj[1][j], viewProj[2][j], viewProj[3][j]);
+            };
+
+            Vec4<float> x = column(0), y = column(1), z = column(2), w = column(3);
+            SetPlane(ePlane_Left, w + x);
+            SetPlane(ePlane_Right, w - x);
+            SetPlane(ePlane_Bottom, w + y);
+            SetPlane(ePlane_Top, w - y);
+            SetPlane(ePlane_Near, z);
+            SetPlane(ePlane_Far, w - z);
+        }
+
+        bool Contains(const Vec3<float>& point) const
+        {
+            for (int i = 0; i < ePlane_Count; i++)
+            {
+                if (mPlanes[i].Distance(point) < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+
+        // Tests the corner furthest along each normal. Conservative, a box just outside an
+        // edge of the frustum can still pass.
+        bool Intersects(const AABB3& box) const
+        {
+            Vec3<float> center = box.Center();
+            Vec3<float> extent = box.Extent();
+            for (int i = 0; i < ePlane_Count; i++)
+            {
+                const Vec3<float>& normal = mPlanes[i].mNormal;
+                float radius = std::abs(normal.x) * extent.x + std::abs(normal.y) * extent.y + std::abs(normal.z) * extent.z;
+                if (mPlanes[i].Distance(center) + radius < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+
+        // Conservative in the same way as the box test.
+        bool Intersects(const Sphere& sphere) const
+        {
+            for (int i = 0; i < ePlane_Count; i++)
+            {
+                if (mPlanes[i].Distance(sphere.mCenter) + sphere.mRadius < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        void SetPlane(EPlane plane, const Vec4<float>& coefficients)
+        {
+            mPlanes[plane] = Plane(coefficients.x, coefficients.y, coefficients.z, coefficients.w);
+            mPlanes[plane].Normalize();
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "SIMD.h"
+
+#if defined(MATH_SIMD)
+
+namespace Engine
+{
+    namespace Simd
+    {
+        // Products of 2x2 matrices packed row by row into one register, # is the adjugate.
+        // A * B
+        inline Register Mat2Mul(Register a, Register b)
+        {
+            return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+
+        // A# * B
+        inline Register Mat2AdjMul(Register a, Register b)
+        {
+            return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+        }
+
+        // A * B#
+        inline Register Mat2MulAdj(Register a, Register b)
+        {
+            return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+
+        // row * mat, the rows of mat in r0 to r3.
+        inline Register MulRow(Register row, Register r0, Register r1, Register r2, Register r3)
+        {
+            Register ret = Mul(Lane<0>(row), r0);
+            ret = MulAdd(Lane<1>(row), r1, ret);
+            ret = MulAdd(Lane<2>(row), r2, ret);
+            return MulAdd(Lane<3>(row), r3, ret);
+        }
+    }
+
+    inline Mat4x4<float> Mat::Mul(const Mat4x4<float>& mat1, const Mat4x4<float>& mat2)
+    {
+#if defined(MATH_SIMD_AVX)
+        Mat4x4<float> ret;
+        // Two rows per register, each half broadcasts its own row's elements.
+        __m256 row01 = _mm256_loadu_ps(mat1.mData[0]);
+        __m256 row23 = _mm256_loadu_ps(mat1.mData[2]);
+        __m256 r0 = _mm256_broadcast_ps(&mat2[0].mVec);
+        __m256 r1 = _mm256_broadcast_ps(&mat2[1].mVec);
+        __m256 r2 = _mm256_broadcast_ps(&mat2[2].mVec);
+        __m256 r3 = _mm256_broadcast_ps(&mat2[3].mVec);
+
+        __m256 ret01 = _mm256_mul_ps(_mm256_permute_ps(row01, 0x00), r0);
+        __m256 ret23 = _mm256_mul_ps(_mm256_permute_ps(row23, 0x00), r0);
+        ret01 = _mm256_add_ps(ret01, _mm256_mul_ps(_mm256_permute_ps(row01, 0x55), r1));
+        ret23 = _mm256_add_ps(ret23, _mm256_mul_ps(_mm256_permute_ps(row23, 0x55), r1));
+        ret01 = _mm256_add_ps(ret01, _mm256_mul_ps(_mm256_permute_ps(row01, 0xAA), r2));
+        ret23 = _mm256_add_ps(ret23, _mm256_mul_ps(_mm256_permute_ps(row23, 0xAA), r2));
+        ret01 = _mm256_add_ps(ret01, _mm256_mul_ps(_mm256_permute_ps(row01, 0xFF), r3));
+        ret23 = _mm256_add_ps(ret23, _mm256_mul_ps(_mm256_permute_ps(row23, 0xFF), r3));
+
+        _mm256_storeu_ps(ret.mData[0], ret01);
+        _mm256_storeu_ps(ret.mData[2], ret23);
+        return ret;
+#else
+        Simd::Register r0 = mat2[0].mVec, r1 = mat2[1].mVec, r2 = mat2[2].mVec, r3 = mat2[3].mVec;
+        return Mat4x4<float>(Vec4<float>(Simd::MulRow(mat1[0].mVec, r0, r1, r2, r3)),
+                             Vec4<float>(Simd::MulRow(mat1[1].mVec, r0, r1, r2, r3)),
+                             Vec4<float>(Simd::MulRow(mat1[2].mVec, r0, r1, r2, r3)),
+                             Vec4<float>(Simd::MulRow(mat1[3].mVec, r0, r1, r2, r3)));
+#endif
+    }
+
+    inline Vec4<float> Mat::Mul(const Vec4<float>& vec, const Mat4x4<float>& mat)
+    {
+        return Vec4<float>(Simd::MulRow(vec.mVec, mat[0].mVec, mat[1].mVec, mat[2].mVec, mat[3].mVec));
+    }
+
+    inline Mat4x4<float> Mat::Transpose(const Mat4x4<float>& mat)
+    {
+        Mat4x4<float> ret = mat;
+        Simd::Transpose(ret[0].mVec, ret[1].mVec, ret[2].mVec, ret[3].mVec);
+        return ret;
+    }
+
+    // Block inverse over the four 2x2 sub matrices A B / C D, see
+    // https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+    inline Mat4x4<float> Mat::Inverse(const Mat4x4<float>& mat)
+    {
+        Simd::Register a = Simd::Shuffle<0, 1, 0, 1>(mat[0].mVec, mat[1].mVec);
+        Simd::Register b = Simd::Shuffle<2, 3, 2, 3>(mat[0].mVec, mat[1].mVec);
+        Simd::Register c = Simd::Shuffle<0, 1, 0, 1>(mat[2].mVec, mat[3].mVec);
+        Simd::Register d = Simd::Shuffle<2, 3, 2, 3>(mat[2].mVec, mat[3].mVec);
+
+        // (|A|, |B|, |C|, |D|)
+        Simd::Register detSub = Simd::Sub(Simd::Mul(Simd::Shuffle<0, 2, 0, 2>(mat[0].mVec, mat[2].mVec), Simd::Shuffle<1, 3, 1, 3>(mat[1].mVec, mat[3].mVec)),
+                                          Simd::Mul(Simd::Shuffle<1, 3, 1, 3>(mat[0].mVec, mat[2].mVec), Simd::Shuffle<0, 2, 0, 2>(mat[1].mVec, mat[3].mVec)));
+        Simd::Register detA = Simd::Lane<0>(detSub);
+        Simd::Register detB = Simd::Lane<1>(detSub);
+        Simd::Register detC = Simd::Lane<2>(detSub);
+        Simd::Register detD = Simd::Lane<3>(detSub);
+
+        Simd::Register dc = Simd::Mat2AdjMul(d, c);
+        Simd::Register ab = Simd::Mat2AdjMul(a, b);
+
+        // Adjugates of the blocks of the inverse: |D|A - B(D#C), |B|C - D(A#B)#, |C|B - A(D#C)#, |A|D - C(A#B)
+        Simd::Register x = Simd::Sub(Simd::Mul(detD, a), Simd::Mat2Mul(b, dc));
+        Simd::Register y = Simd::Sub(Simd::Mul(detB, c), Simd::Mat2MulAdj(d, ab));
+        Simd::Register z = Simd::Sub(Simd::Mul(detC, b), Simd::Mat2MulAdj(a, dc));
+        Simd::Register w = Simd::Sub(Simd::Mul(detA, d), Simd::Mat2Mul(c, ab));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        Simd::Register detM = Simd::Add(Simd::Mul(detA, detD), Simd::Mul(detB, detC));
+        detM = Simd::Sub(detM, Simd::Dot4(ab, Simd::Swizzle<0, 2, 1, 3>(dc)));
+
+        Simd::Register rDetM = Simd::Div(Simd::Set(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        x = Simd::Mul(x, rDetM);
+        y = Simd::Mul(y, rDetM);
+        z = Simd::Mul(z, rDetM);
+        w = Simd::Mul(w, rDetM);
+
+        // Undo the adjugates and interleave the blocks back into rows.
+        return Mat4x4<float>(Vec4<float>(Simd::Shuffle<3, 1, 3, 1>(x, y)),
+                             Vec4<float>(Simd::Shuffle<2, 0, 2, 0>(x, y)),
+                             Vec4<float>(Simd::Shuffle<3, 1, 3, 1>(z, w)),
+                             Vec4<float>(Simd::Shuffle<2, 0, 2, 0>(z, w)));
+    }
+
+    inline Vec3<float> Mat::TransformPoint(const Vec3<float>& point, const Mat4x4<float>& mat)
+    {
+        Vec4<float> ret(Simd::MulAdd(Simd::Splat(point.x), mat[0].mVec,
+                        Simd::MulAdd(Simd::Splat(point.y), mat[1].mVec,
+                        Simd::MulAdd(Simd::Splat(point.z), mat[2].mVec, mat[3].mVec))));
+        return Vec3<float>(ret.x, ret.y, ret.z);
+    }
+
+    inline Vec3<float> Mat::TransformVector(const Vec3<float>& vec, const Mat4x4<float>& mat)
+    {
+        Vec4<float> ret(Simd::MulAdd(Simd::Splat(vec.x), mat[0].mVec,
+                        Simd::MulAdd(Simd::Splat(vec.y), mat[1].mVec,
+                        Simd::Mul(Simd::Splat(vec.z), mat[2].mVec))));
+        return Vec3<float>(ret.x, ret.y, ret.z);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,34 +1,25 @@
 #pragma once
 
-#include "Mat2x2.h"
-#include "Mat3x3.h"
-#include "Mat4x4.h"
+#include "Vector.h"
 
 #include "Utility.h"
 
 namespace Engine
 {
-    typedef Mat2x2<uint32_t> uint2x2;
-    typedef Mat3x3<uint32_t> uint3x3;
-    typedef Mat4x4<uint32_t> uint4x4;
-
-    typedef Mat2x2<int32_t> int2x2;
-    typedef Mat3x3<int32_t> int3x3;
-    typedef Mat4x4<int32_t> int4x4;
-
-    typedef Mat2x2<float> float2x2;
-    typedef Mat3x3<float> float3x3;
-    typedef Mat4x4<float> float4x4;
-
-    typedef Mat2x2<double> double2x2;
-    typedef Mat3x3<double> double3x3;
-    typedef Mat4x4<double> double4x4;
+    template<typename T>
+    class Mat2x2;
+    template<typename T>
+    class Mat3x3;
+    template<typename T>
+    class Mat4x4;
+    template<typename T>
+    class Quaternion;
 
     class Mat
     {
     public:
         template<typename T>
-        static inline typename T Mul(const T& mat1, const T& mat2)
+        static inline T Mul(const T& mat1, const T& mat2)
         {
             static_assert(std::is_base_of<Mat, T>::value, "T must inherit from Mat");
             T ret;
@@ -38,7 +29,7 @@ namespace Engine
 
         template<typename T, typename U> 
 
-        static inline typename T Mul(const T& vec, const U& mat)
+        static inline T Mul(const T& vec, const U& mat)
         {
             static_assert(std::is_base_of<Vec, T>::value, "T must inherit from Vec");
             static_assert(std::is_base_of<Mat, U>::value, "T must inherit from Mat");
@@ -48,7 +39,101 @@ namespace Engine
         }
 
         template<typename T>
-        static inline typename Mat3x3<T> EulerRotateLH(T p, T h, T b)
+        static inline T Transpose(const T& mat)
+        {
+            static_assert(std::is_base_of<Mat, T>::value, "T must inherit from Mat");
+            static_assert(T::ROW == T::COL, "T must be square");
+            T ret;
+            MATH_LOOP_OPERATION(i, T::ROW, MATH_LOOP_OPERATION(j, T::COL, ret[i][j] = mat[j][i]));
+            return ret;
+        }
+
+        // The matrix must be invertible.
+        template<typename T>
+        static inline Mat4x4<T> Inverse(const Mat4x4<T>& mat)
+        {
+            T s0 = mat.x00 * mat.x11 - mat.x10 * mat.x01;
+            T s1 = mat.x00 * mat.x12 - mat.x10 * mat.x02;
+            T s2 = mat.x00 * mat.x13 - mat.x10 * mat.x03;
+            T s3 = mat.x01 * mat.x12 - mat.x11 * mat.x02;
+            T s4 = mat.x01 * mat.x13 - mat.x11 * mat.x03;
+            T s5 = mat.x02 * mat.x13 - mat.x12 * mat.x03;
+
+            T c0 = mat.x20 * mat.x31 - mat.x30 * mat.x21;
+            T c1 = mat.x20 * mat.x32 - mat.x30 * mat.x22;
+            T c2 = mat.x20 * mat.x33 - mat.x30 * mat.x23;
+            T c3 = mat.x21 * mat.x32 - mat.x31 * mat.x22;
+            T c4 = mat.x21 * mat.x33 - mat.x31 * mat.x23;
+            T c5 = mat.x22 * mat.x33 - mat.x32 * mat.x23;
+
+            T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            T invDet = static_cast<T>(1) / det;
+
+            return Mat4x4<T>(( mat.x11 * c5 - mat.x12 * c4 + mat.x13 * c3) * invDet,
+                             (-mat.x01 * c5 + mat.x02 * c4 - mat.x03 * c3) * invDet,
+                             ( mat.x31 * s5 - mat.x32 * s4 + mat.x33 * s3) * invDet,
+                             (-mat.x21 * s5 + mat.x22 * s4 - mat.x23 * s3) * invDet,
+
+                             (-mat.x10 * c5 + mat.x12 * c2 - mat.x13 * c1) * invDet,
+                             ( mat.x00 * c5 - mat.x02 * c2 + mat.x03 * c1) * invDet,
+                             (-mat.x30 * s5 + mat.x32 * s2 - mat.x33 * s1) * invDet,
+                             ( mat.x20 * s5 - mat.x22 * s2 + mat.x23 * s1) * invDet,
+
+                             ( mat.x10 * c4 - mat.x11 * c2 + mat.x13 * c0) * invDet,
+                             (-mat.x00 * c4 + mat.x01 * c2 - mat.x03 * c0) * invDet,
+                             ( mat.x30 * s4 - mat.x31 * s2 + mat.x33 * s0) * invDet,
+                             (-mat.x20 * s4 + mat.x21 * s2 - mat.x23 * s0) * invDet,
+
+                             (-mat.x10 * c3 + mat.x11 * c1 - mat.x12 * c0) * invDet,
+                             ( mat.x00 * c3 - mat.x01 * c1 + mat.x02 * c0) * invDet,
+                             (-mat.x30 * s3 + mat.x31 * s1 - mat.x32 * s0) * invDet,
+                             ( mat.x20 * s3 - mat.x21 * s1 + mat.x22 * s0) * invDet);
+        }
+
+        // Row vector convention, the point takes w = 1 and the result is not divided by w.
+        template<typename T>
+        static inline Vec3<T> TransformPoint(const Vec3<T>& point, const Mat4x4<T>& mat)
+        {
+            Vec3<T> ret;
+            MATH_LOOP_OPERATION(i, 3, ret[i] = point.x * mat[0][i] + point.y * mat[1][i] + point.z * mat[2][i] + mat[3][i]);
+            return ret;
+        }
+
+        // Row vector convention, the vector takes w = 0 so the translation is ignored.
+        template<typename T>
+        static inline Vec3<T> TransformVector(const Vec3<T>& vec, const Mat4x4<T>& mat)
+        {
+            Vec3<T> ret;
+            MATH_LOOP_OPERATION(i, 3, ret[i] = vec.x * mat[0][i] + vec.y * mat[1][i] + vec.z * mat[2][i]);
+            return ret;
+        }
+
+        // Scale, rotate, then translate in one pass, the same matrix as Mul(scale, Mul(rotate, translate)).
+        template<typename T>
+        static inline Mat4x4<T> ComposeTRS(const Vec3<T>& t, const Quaternion<T>& q, const Vec3<T>& s)
+        {
+            T x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+            T xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+            T xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+            T wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+            return Mat4x4<T>(s.x * (1 - yy - zz), s.x * (xy + wz), s.x * (xz - wy), 0,
+                             s.y * (xy - wz), s.y * (1 - xx - zz), s.y * (yz + wx), 0,
+                             s.z * (xz + wy), s.z * (yz - wx), s.z * (1 - xx - yy), 0,
+                             t.x, t.y, t.z, 1);
+        }
+
+#if defined(MATH_SIMD)
+        static inline Mat4x4<float> Mul(const Mat4x4<float>& mat1, const Mat4x4<float>& mat2);
+        static inline Vec4<float> Mul(const Vec4<float>& vec, const Mat4x4<float>& mat);
+        static inline Mat4x4<float> Transpose(const Mat4x4<float>& mat);
+        static inline Mat4x4<float> Inverse(const Mat4x4<float>& mat);
+        static inline Vec3<float> TransformPoint(const Vec3<float>& point, const Mat4x4<float>& mat);
+        static inline Vec3<float> TransformVector(const Vec3<float>& vec, const Mat4x4<float>& mat);
+#endif
+
+        template<typename T>
+        static inline Mat3x3<T> EulerRotateLH(T p, T h, T b)
         {
             T sinp, cosp, sinh, cosh, sinb, cosb;
             MATH_TYPE_DEGREE_FUN(T, p, sin, sinp)
@@ -64,7 +149,7 @@ namespace Engine
         }
 
         template<typename T>
-        static inline typename Mat3x3<T> QuatRotateLH(T x, T y, T z, T w)
+        static inline Mat3x3<T> QuatRotateLH(T x, T y, T z, T w)
         {
             return Mat3x3<T>( 1-2*y*y-2*z*z,    2*x*y+2*w*z,    2*x*z-2*w*y,
                               2*x*y-2*w*z,      1-2*x*x-2*z*z,  2*y*z+2*w*x,
@@ -72,7 +157,7 @@ namespace Engine
         }
 
         template<typename T>
-        static inline typename Mat4x4<T> LookAtLH(const Vec3<T>& eye, const Vec3<T>& at, const Vec3<T>& up)
+        static inline Mat4x4<T> LookAtLH(const Vec3<T>& eye, const Vec3<T>& at, const Vec3<T>& up)
         {
             Vec3<T> z = Vec::Normalize(at - eye);
             Vec3<T> x = Vec::Normalize(Vec::Cross(up, z));
@@ -88,7 +173,7 @@ namespace Engine
         }
 
         template<typename T>
-        static inline typename Mat4x4<T> PerspectiveFovLH(T fovy, T aspect, T zn, T zf)
+        static inline Mat4x4<T> PerspectiveFovLH(T fovy, T aspect, T zn, T zf)
         {
             T f;
             MATH_TYPE_DEGREE_FUN(T, static_cast<T>(fovy / 2.0), tan, f);
@@ -106,7 +191,7 @@ namespace Engine
         }
 
         template<typename T>
-        static inline typename Mat4x4<T> OrthoLH(T w, T h, T zn, T zf)
+        static inline Mat4x4<T> OrthoLH(T w, T h, T zn, T zf)
         {
             Mat4x4<T> ortho = {
                 2 / w, 0, 0, 0,
@@ -121,4 +206,30 @@ namespace Engine
     protected:
         Mat() = default;
     };
-}
\ No newline at end of file
+}
+
+#include "Mat2x2.h"
+#include "Mat3x3.h"
+#include "Mat4x4.h"
+
+namespace Engine
+{
+    typedef Mat2x2<uint32_t> uint2x2;
+    typedef Mat3x3<uint32_t> uint3x3;
+    typedef Mat4x4<uint32_t> uint4x4;
+
+    typedef Mat2x2<int32_t> int2x2;
+    typedef Mat3x3<int32_t> int3x3;
+    typedef Mat4x4<int32_t> int4x4;
+
+    typedef Mat2x2<float> float2x2;
+    typedef Mat3x3<float> float3x3;
+    typedef Mat4x4<float> float4x4;
+
+    typedef Mat2x2<double> double2x2;
+    typedef Mat3x3<double> double3x3;
+    typedef Mat4x4<double> double4x4;
+}
+
+#include "Mat4x4_simd.h"
+#include "Quaternion.h"
\ No newline at end of file
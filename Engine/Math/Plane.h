@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cmath>
+
+#include "Vector.h"
+
+namespace Engine
+{
+    // Points p with Dot(mNormal, p) + mDistance = 0, the normal side is positive.
+    class Plane
+    {
+    public:
+        Vec3<float> mNormal;
+        float mDistance;
+
+        Plane() : mNormal(0.0f, 1.0f, 0.0f), mDistance(0.0f)
+        {
+        }
+
+        Plane(const Vec3<float>& normal, float distance) : mNormal(normal), mDistance(distance)
+        {
+        }
+
+        Plane(float a, float b, float c, float d) : mNormal(a, b, c), mDistance(d)
+        {
+        }
+
+        Plane(const Vec3<float>& normal, const Vec3<float>& point) : mNormal(normal), mDistance(-Vec::Dot(normal, point))
+        {
+        }
+
+        // The normal is Cross(point1 - point0, point2 - point0), normalized.
+        static Plane FromPoints(const Vec3<float>& point0, const Vec3<float>& point1, const Vec3<float>& point2)
+        {
+            Plane plane(Vec::Cross(point1 - point0, point2 - point0), point0);
+            plane.Normalize();
+            return plane;
+        }
+
+        // A zero normal is left alone.
+        void Normalize()
+        {
+            float length = Vec::Length(mNormal);
+            if (length > 0.0f)
+            {
+                mNormal = mNormal / length;
+                mDistance /= length;
+            }
+        }
+
+        // Signed, in units of the normal length.
+        float Distance(const Vec3<float>& point) const
+        {
+            return Vec::Dot(mNormal, point) + mDistance;
+        }
+    };
+}
\ No newline at end of file
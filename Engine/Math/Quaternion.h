@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace Engine
+{
+    // Rotations follow the row vector convention of Mat, ToMatrix() is Mat::QuatRotateLH and
+    // q1 * q2 rotates by q1 first, the same order as Mat::Mul(q1.ToMatrix(), q2.ToMatrix()).
+    // Angles are in degrees, like Mat::EulerRotateLH.
+    template<typename T>
+    class Quaternion
+    {
+    public:
+        typedef Quaternion<T> type;
+        typedef T value_type;
+
+        union
+        {
+            T mData[4];
+            struct{ T x, y, z, w; };
+        };
+
+        Quaternion() : x(0), y(0), z(0), w(1)
+        {
+        }
+
+        Quaternion(const T& valX, const T& valY, const T& valZ, const T& valW) : x(valX), y(valY), z(valZ), w(valW)
+        {
+        }
+
+        explicit Quaternion(const Vec4<T>& vec) : x(vec.x), y(vec.y), z(vec.z), w(vec.w)
+        {
+        }
+
+        static Quaternion Identity()
+        {
+            return Quaternion();
+        }
+
+        // The axis must be unit length.
+        static Quaternion AxisAngle(const Vec3<T>& axis, T degree)
+        {
+            T s, c;
+            MATH_TYPE_DEGREE_FUN(T, degree / 2, sin, s)
+            MATH_TYPE_DEGREE_FUN(T, degree / 2, cos, c)
+            return Quaternion(axis.x * s, axis.y * s, axis.z * s, c);
+        }
+
+        // The same rotation as Mat::EulerRotateLH(p, h, b).
+        static Quaternion EulerAngles(T p, T h, T b)
+        {
+            T sinp, cosp, sinh, cosh, sinb, cosb;
+            MATH_TYPE_DEGREE_FUN(T, p / 2, sin, sinp)
+            MATH_TYPE_DEGREE_FUN(T, p / 2, cos, cosp)
+            MATH_TYPE_DEGREE_FUN(T, h / 2, sin, sinh)
+            MATH_TYPE_DEGREE_FUN(T, h / 2, cos, cosh)
+            MATH_TYPE_DEGREE_FUN(T, b / 2, sin, sinb)
+            MATH_TYPE_DEGREE_FUN(T, b / 2, cos, cosb)
+
+            // Bank, then pitch, then heading.
+            return Quaternion( cosh * sinp * cosb + sinh * cosp * sinb,
+                               sinh * cosp * cosb - cosh * sinp * sinb,
+                               cosh * cosp * sinb - sinh * sinp * cosb,
+                               cosh * cosp * cosb + sinh * sinp * sinb);
+        }
+
+        // The matrix must be a pure rotation, scale divided out.
+        static Quaternion FromMatrix(const Mat3x3<T>& mat)
+        {
+            T trace = mat.x00 + mat.x11 + mat.x22;
+            if (trace > 0)
+            {
+                T s = static_cast<T>(0.5) / std::sqrt(trace + 1);
+                return Quaternion((mat.x12 - mat.x21) * s, (mat.x20 - mat.x02) * s, (mat.x01 - mat.x10) * s, static_cast<T>(0.25) / s);
+            }
+            else if (mat.x00 > mat.x11 && mat.x00 > mat.x22)
+            {
+                T s = 2 * std::sqrt(1 + mat.x00 - mat.x11 - mat.x22);
+                return Quaternion(static_cast<T>(0.25) * s, (mat.x10 + mat.x01) / s, (mat.x20 + mat.x02) / s, (mat.x12 - mat.x21) / s);
+            }
+            else if (mat.x11 > mat.x22)
+            {
+                T s = 2 * std::sqrt(1 + mat.x11 - mat.x00 - mat.x22);
+                return Quaternion((mat.x10 + mat.x01) / s, static_cast<T>(0.25) * s, (mat.x21 + mat.x12) / s, (mat.x20 - mat.x02) / s);
+            }
+            else
+            {
+                T s = 2 * std::sqrt(1 + mat.x22 - mat.x00 - mat.x11);
+                return Quaternion((mat.x20 + mat.x02) / s, (mat.x21 + mat.x12) / s, static_cast<T>(0.25) * s, (mat.x01 - mat.x10) / s);
+            }
+        }
+
+        static Quaternion FromMatrix(const Mat4x4<T>& mat)
+        {
+            return FromMatrix(Mat3x3<T>(mat.x00, mat.x01, mat.x02,
+                                        mat.x10, mat.x11, mat.x12,
+                                        mat.x20, mat.x21, mat.x22));
+        }
+
+        // A unit quaternion gives a unit axis, the identity gives the x axis and 0.
+        void ToAxisAngle(Vec3<T>& axis, T& degree) const
+        {
+            T s = std::sqrt(x * x + y * y + z * z);
+            if (s <= std::numeric_limits<T>::epsilon())
+            {
+                axis = Vec3<T>(1, 0, 0);
+                degree = 0;
+                return;
+            }
+
+            axis = Vec3<T>(x / s, y / s, z / s);
+            degree = static_cast<T>(2 * std::atan2(s, w) * 180 / PI);
+        }
+
+        // The angles EulerAngles takes, pitch within [-90, 90]. Straight up or down the
+        // heading takes all of the yaw and bank is 0.
+        void ToEulerAngles(T& p, T& h, T& b) const
+        {
+            Mat3x3<T> mat = ToMatrix();
+            T sinp = std::max(static_cast<T>(-1), std::min(static_cast<T>(1), -mat.x21));
+            p = static_cast<T>(std::asin(sinp) * 180 / PI);
+            if (std::abs(sinp) < static_cast<T>(0.99999))
+            {
+                h = static_cast<T>(std::atan2(mat.x20, mat.x22) * 180 / PI);
+                b = static_cast<T>(std::atan2(mat.x01, mat.x11) * 180 / PI);
+            }
+            else
+            {
+                h = static_cast<T>(std::atan2(-mat.x02, mat.x00) * 180 / PI);
+                b = 0;
+            }
+        }
+
+        Mat3x3<T> ToMatrix() const
+        {
+            return Mat::QuatRotateLH(x, y, z, w);
+        }
+
+        Vec4<T> ToVec4() const
+        {
+            return Vec4<T>(x, y, z, w);
+        }
+
+        static T Dot(const Quaternion& quat1, const Quaternion& quat2)
+        {
+            return quat1.x * quat2.x + quat1.y * quat2.y + quat1.z * quat2.z + quat1.w * quat2.w;
+        }
+
+        static T Length(const Quaternion& quat)
+        {
+            return std::sqrt(Dot(quat, quat));
+        }
+
+        static Quaternion Normalize(const Quaternion& quat)
+        {
+            T invLength = 1 / Length(quat);
+            return Quaternion(quat.x * invLength, quat.y * invLength, quat.z * invLength, quat.w * invLength);
+        }
+
+        static Quaternion Conjugate(const Quaternion& quat)
+        {
+            return Quaternion(-quat.x, -quat.y, -quat.z, quat.w);
+        }
+
+        static Quaternion Inverse(const Quaternion& quat)
+        {
+            T invLengthSquared = 1 / Dot(quat, quat);
+            return Quaternion(-quat.x * invLengthSquared, -quat.y * invLengthSquared, -quat.z * invLengthSquared, quat.w * invLengthSquared);
+        }
+
+        // quat1 first, then quat2.
+        static Quaternion Mul(const Quaternion& quat1, const Quaternion& quat2)
+        {
+            const Quaternion& a = quat2;
+            const Quaternion& b = quat1;
+            return Quaternion(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                              a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                              a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                              a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+        }
+
+        // vec * ToMatrix() for a unit quaternion.
+        static Vec3<T> Rotate(const Vec3<T>& vec, const Quaternion& quat)
+        {
+            Vec3<T> axis(quat.x, quat.y, quat.z);
+            Vec3<T> t = Vec::Cross(axis, vec) * static_cast<T>(2);
+            return vec + t * quat.w + Vec::Cross(axis, t);
+        }
+
+        // Normalized linear blend along the shorter arc, cheap and close to Slerp for nearby rotations.
+        static Quaternion Nlerp(const Quaternion& quat1, const Quaternion& quat2, T t)
+        {
+            T sign = Dot(quat1, quat2) < 0 ? static_cast<T>(-1) : static_cast<T>(1);
+            T s1 = 1 - t;
+            T s2 = t * sign;
+            return Normalize(Quaternion(quat1.x * s1 + quat2.x * s2, quat1.y * s1 + quat2.y * s2,
+                                        quat1.z * s1 + quat2.z * s2, quat1.w * s1 + quat2.w * s2));
+        }
+
+        // Constant angular speed along the shorter arc, inputs must be unit length.
+        static Quaternion Slerp(const Quaternion& quat1, const Quaternion& quat2, T t)
+        {
+            T cosTheta = Dot(quat1, quat2);
+            T sign = 1;
+            if (cosTheta < 0)
+            {
+                cosTheta = -cosTheta;
+                sign = -1;
+            }
+
+            // Nearly parallel, sin(theta) would lose all precision.
+            if (cosTheta > static_cast<T>(0.9995))
+                return Nlerp(quat1, quat2, t);
+
+            T theta = std::acos(cosTheta);
+            T invSinTheta = 1 / std::sin(theta);
+            T s1 = std::sin((1 - t) * theta) * invSinTheta;
+            T s2 = std::sin(t * theta) * invSinTheta * sign;
+            return Quaternion(quat1.x * s1 + quat2.x * s2, quat1.y * s1 + quat2.y * s2,
+                              quat1.z * s1 + quat2.z * s2, quat1.w * s1 + quat2.w * s2);
+        }
+    };
+
+    template<typename T>
+    Quaternion<T> operator* (const Quaternion<T>& quat1, const Quaternion<T>& quat2)
+    {
+        return Quaternion<T>::Mul(quat1, quat2);
+    }
+
+    template<typename T>
+    bool operator== (const Quaternion<T>& quat1, const Quaternion<T>& quat2)
+    {
+        return quat1.x == quat2.x && quat1.y == quat2.y && quat1.z == quat2.z && quat1.w == quat2.w;
+    }
+
+    template<typename T>
+    bool operator!= (const Quaternion<T>& quat1, const Quaternion<T>& quat2)
+    {
+        return !(quat1 == quat2);
+    }
+
+    typedef Quaternion<float> quat;
+    typedef Quaternion<double> dquat;
+}
\ No newline at end of file
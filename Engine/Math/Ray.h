@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cmath>
+#include <float.h>
+#include <utility>
+
+#include "AABB3.h"
+#include "Sphere.h"
+
+namespace Engine
+{
+    // Points mOrigin + mDirection * t for t >= 0. The direction need not be unit length,
+    // distances are in units of it.
+    class Ray
+    {
+    public:
+        Vec3<float> mOrigin;
+        Vec3<float> mDirection;
+
+        Ray() : mOrigin(0.0f, 0.0f, 0.0f), mDirection(0.0f, 0.0f, 1.0f)
+        {
+        }
+
+        Ray(const Vec3<float>& origin, const Vec3<float>& direction) : mOrigin(origin), mDirection(direction)
+        {
+        }
+
+        Vec3<float> GetPoint(float t) const
+        {
+            return mOrigin + mDirection * t;
+        }
+
+        // Slab test. The distance is 0 when the origin is inside, boundaries count as hits.
+        bool Intersects(const AABB3& box, float& distance) const
+        {
+            float tNear = 0.0f;
+            float tFar = FLT_MAX;
+            for (int i = 0; i < 3; i++)
+            {
+                // Parallel to the slab, no division by zero, just inside or out.
+                if (mDirection[i] == 0.0f)
+                {
+                    if (mOrigin[i] < box.mMin[i] || mOrigin[i] > box.mMax[i])
+                        return false;
+                    continue;
+                }
+
+                float invDirection = 1.0f / mDirection[i];
+                float t0 = (box.mMin[i] - mOrigin[i]) * invDirection;
+                float t1 = (box.mMax[i] - mOrigin[i]) * invDirection;
+                // By the direction rather than the values, so an empty box never passes.
+                if (invDirection < 0.0f)
+                    std::swap(t0, t1);
+                tNear = t0 > tNear ? t0 : tNear;
+                tFar = t1 < tFar ? t1 : tFar;
+            }
+
+            distance = tNear;
+            return tNear <= tFar;
+        }
+
+        bool Intersects(const Sphere& sphere, float& distance) const
+        {
+            Vec3<float> offset = mOrigin - sphere.mCenter;
+            float c = Vec::LengthSquared(offset) - sphere.mRadius * sphere.mRadius;
+            if (c <= 0.0f)
+            {
+                distance = 0.0f;
+                return true;
+            }
+
+            // Outside and moving away, or a zero direction.
+            float b = Vec::Dot(offset, mDirection);
+            float a = Vec::LengthSquared(mDirection);
+            if (b >= 0.0f || a == 0.0f)
+                return false;
+
+            float discriminant = b * b - a * c;
+            if (discriminant < 0.0f)
+                return false;
+
+            distance = (-b - std::sqrt(discriminant)) / a;
+            return true;
+        }
+    };
+}
\ No newline at end of file
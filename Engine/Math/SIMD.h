@@ -0,0 +1,135 @@
+#pragma once
+
+// Define MATH_NO_SIMD to build the math library with the scalar templates only.
+#if !defined(MATH_NO_SIMD)
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <immintrin.h>
+#define MATH_SIMD
+#define MATH_SIMD_SSE
+#if defined(__AVX__)
+#define MATH_SIMD_AVX
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MATH_SIMD
+#define MATH_SIMD_NEON
+#endif
+#endif
+
+#if defined(MATH_SIMD)
+
+namespace Engine
+{
+    // Thin wrappers over four float lanes, so the specializations read the same for every instruction set.
+    namespace Simd
+    {
+#if defined(MATH_SIMD_SSE)
+        typedef __m128 Register;
+
+        inline Register Load(const float* pData)                        { return _mm_loadu_ps(pData); }
+        inline void Store(float* pData, Register v)                     { _mm_storeu_ps(pData, v); }
+        inline Register Set(float x, float y, float z, float w)         { return _mm_setr_ps(x, y, z, w); }
+        inline Register Splat(float value)                              { return _mm_set1_ps(value); }
+        inline Register Zero()                                          { return _mm_setzero_ps(); }
+        inline float GetX(Register v)                                   { return _mm_cvtss_f32(v); }
+
+        inline Register Add(Register a, Register b)                     { return _mm_add_ps(a, b); }
+        inline Register Sub(Register a, Register b)                     { return _mm_sub_ps(a, b); }
+        inline Register Mul(Register a, Register b)                     { return _mm_mul_ps(a, b); }
+        inline Register Div(Register a, Register b)                     { return _mm_div_ps(a, b); }
+        inline Register Min(Register a, Register b)                     { return _mm_min_ps(a, b); }
+        inline Register Max(Register a, Register b)                     { return _mm_max_ps(a, b); }
+        inline Register Negate(Register v)                              { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+
+        // a * b + c
+        inline Register MulAdd(Register a, Register b, Register c)
+        {
+#if defined(__FMA__) || defined(__AVX2__)
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        // (v[X], v[Y], v[Z], v[W])
+        template<int X, int Y, int Z, int W>
+        inline Register Swizzle(Register v)                             { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+        // (a[X], a[Y], b[Z], b[W])
+        template<int X, int Y, int Z, int W>
+        inline Register Shuffle(Register a, Register b)                 { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+
+        // The dot product in every lane.
+        inline Register Dot4(Register a, Register b)
+        {
+            Register m = _mm_mul_ps(a, b);
+            m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        inline void Transpose(Register& r0, Register& r1, Register& r2, Register& r3)
+        {
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        }
+#elif defined(MATH_SIMD_NEON)
+        typedef float32x4_t Register;
+
+        inline Register Load(const float* pData)                        { return vld1q_f32(pData); }
+        inline void Store(float* pData, Register v)                     { vst1q_f32(pData, v); }
+        inline Register Set(float x, float y, float z, float w)         { const float data[4] = { x, y, z, w }; return vld1q_f32(data); }
+        inline Register Splat(float value)                              { return vdupq_n_f32(value); }
+        inline Register Zero()                                          { return vdupq_n_f32(0.0f); }
+        inline float GetX(Register v)                                   { return vgetq_lane_f32(v, 0); }
+
+        inline Register Add(Register a, Register b)                     { return vaddq_f32(a, b); }
+        inline Register Sub(Register a, Register b)                     { return vsubq_f32(a, b); }
+        inline Register Mul(Register a, Register b)                     { return vmulq_f32(a, b); }
+        inline Register Div(Register a, Register b)                     { return vdivq_f32(a, b); }
+        inline Register Min(Register a, Register b)                     { return vminq_f32(a, b); }
+        inline Register Max(Register a, Register b)                     { return vmaxq_f32(a, b); }
+        inline Register Negate(Register v)                              { return vnegq_f32(v); }
+
+        // a * b + c
+        inline Register MulAdd(Register a, Register b, Register c)      { return vfmaq_f32(c, a, b); }
+
+        // (v[X], v[Y], v[Z], v[W])
+        template<int X, int Y, int Z, int W>
+        inline Register Swizzle(Register v)
+        {
+            Register r = vdupq_n_f32(vgetq_lane_f32(v, X));
+            r = vsetq_lane_f32(vgetq_lane_f32(v, Y), r, 1);
+            r = vsetq_lane_f32(vgetq_lane_f32(v, Z), r, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(v, W), r, 3);
+        }
+
+        // (a[X], a[Y], b[Z], b[W])
+        template<int X, int Y, int Z, int W>
+        inline Register Shuffle(Register a, Register b)
+        {
+            Register r = vdupq_n_f32(vgetq_lane_f32(a, X));
+            r = vsetq_lane_f32(vgetq_lane_f32(a, Y), r, 1);
+            r = vsetq_lane_f32(vgetq_lane_f32(b, Z), r, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(b, W), r, 3);
+        }
+
+        // The dot product in every lane.
+        inline Register Dot4(Register a, Register b)                    { return vdupq_n_f32(vaddvq_f32(vmulq_f32(a, b))); }
+
+        inline void Transpose(Register& r0, Register& r1, Register& r2, Register& r3)
+        {
+            float32x4x2_t t01 = vtrnq_f32(r0, r1);
+            float32x4x2_t t23 = vtrnq_f32(r2, r3);
+            r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+            r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+            r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+            r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+        }
+#endif
+
+        // v[I] in every lane.
+        template<int I>
+        inline Register Lane(Register v)                                { return Swizzle<I, I, I, I>(v); }
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <new>
+#include <stddef.h>
+#include <string.h>
+#include <utility>
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "AABB3.h"
+#include "Sphere.h"
+
+namespace Engine
+{
+    // N float streams of the same length. Every stream starts on a cache line and is padded to
+    // a whole number of the widest batch, so kernels can use aligned full width loads.
+    template<int N>
+    class FloatSoA
+    {
+    public:
+        constexpr static int COMPONENTS = N;
+        constexpr static size_t ALIGNMENT = 64;
+        constexpr static size_t LANES = ALIGNMENT / sizeof(float);
+
+        FloatSoA() : m_pData(nullptr), m_count(0), m_stride(0)
+        {
+            UpdateComponents();
+        }
+
+        explicit FloatSoA(size_t count) : FloatSoA()
+        {
+            Resize(count);
+        }
+
+        FloatSoA(const FloatSoA& soa) : FloatSoA()
+        {
+            *this = soa;
+        }
+
+        FloatSoA(FloatSoA&& soa) : FloatSoA()
+        {
+            Swap(soa);
+        }
+
+        ~FloatSoA()
+        {
+            Release();
+        }
+
+        FloatSoA& operator= (const FloatSoA& soa)
+        {
+            if (this != &soa)
+            {
+                Resize(soa.m_count);
+                if (m_pData != nullptr)
+                    memcpy(m_pData, soa.m_pData, sizeof(float) * N * m_stride);
+            }
+            return *this;
+        }
+
+        FloatSoA& operator= (FloatSoA&& soa)
+        {
+            Swap(soa);
+            return *this;
+        }
+
+        // Keeps the first min(count, Size()) elements.
+        void Resize(size_t count)
+        {
+            size_t stride = (count + LANES - 1) / LANES * LANES;
+            if (stride != m_stride)
+            {
+                float* pData = nullptr;
+                if (stride > 0)
+                {
+                    pData = static_cast<float*>(::operator new(sizeof(float) * N * stride, std::align_val_t(ALIGNMENT)));
+                    memset(pData, 0, sizeof(float) * N * stride);
+                    size_t keepCount = count < m_count ? count : m_count;
+                    for (int i = 0; i < N && keepCount > 0; i++)
+                        memcpy(pData + i * stride, m_pComponents[i], sizeof(float) * keepCount);
+                }
+                Release();
+                m_pData = pData;
+                m_stride = stride;
+            }
+            m_count = count;
+            UpdateComponents();
+        }
+
+        void Clear()
+        {
+            Resize(0);
+        }
+
+        size_t Size() const
+        {
+            return m_count;
+        }
+
+        const float* operator[] (int component) const
+        {
+            return m_pComponents[component];
+        }
+
+        float* operator[] (int component)
+        {
+            return m_pComponents[component];
+        }
+
+        const float* const* GetComponents() const
+        {
+            return m_pComponents;
+        }
+
+        float* const* GetComponents()
+        {
+            return m_pComponents;
+        }
+
+    private:
+        void Release()
+        {
+            if (m_pData != nullptr)
+                ::operator delete(m_pData, std::align_val_t(ALIGNMENT));
+            m_pData = nullptr;
+        }
+
+        void Swap(FloatSoA& soa)
+        {
+            std::swap(m_pData, soa.m_pData);
+            std::swap(m_count, soa.m_count);
+            std::swap(m_stride, soa.m_stride);
+            UpdateComponents();
+            soa.UpdateComponents();
+        }
+
+        void UpdateComponents()
+        {
+            for (int i = 0; i < N; i++)
+                m_pComponents[i] = m_pData != nullptr ? m_pData + i * m_stride : nullptr;
+        }
+
+    private:
+        float* m_pData;
+        float* m_pComponents[N];
+        size_t m_count;
+        size_t m_stride;
+    };
+
+    class Vec3SoA : public FloatSoA<3>
+    {
+    public:
+        using FloatSoA<3>::FloatSoA;
+
+        float3 Get(size_t index) const
+        {
+            return float3((*this)[0][index], (*this)[1][index], (*this)[2][index]);
+        }
+
+        void Set(size_t index, const float3& vec)
+        {
+            MATH_LOOP_OPERATION(i, 3, (*this)[i][index] = vec[i]);
+        }
+    };
+
+    class Vec4SoA : public FloatSoA<4>
+    {
+    public:
+        using FloatSoA<4>::FloatSoA;
+
+        float4 Get(size_t index) const
+        {
+            return float4((*this)[0][index], (*this)[1][index], (*this)[2][index], (*this)[3][index]);
+        }
+
+        void Set(size_t index, const float4& vec)
+        {
+            MATH_LOOP_OPERATION(i, 4, (*this)[i][index] = vec[i]);
+        }
+    };
+
+    // Component i * 4 + j holds element [i][j] of every matrix.
+    class Mat4SoA : public FloatSoA<16>
+    {
+    public:
+        using FloatSoA<16>::FloatSoA;
+
+        float4x4 Get(size_t index) const
+        {
+            float4x4 ret;
+            MATH_LOOP_OPERATION(i, 4, MATH_LOOP_OPERATION(j, 4, ret[i][j] = (*this)[i * 4 + j][index]));
+            return ret;
+        }
+
+        void Set(size_t index, const float4x4& mat)
+        {
+            MATH_LOOP_OPERATION(i, 4, MATH_LOOP_OPERATION(j, 4, (*this)[i * 4 + j][index] = mat[i][j]));
+        }
+    };
+
+    // Components 0 to 2 hold the min corners, 3 to 5 the max corners.
+    class AABB3SoA : public FloatSoA<6>
+    {
+    public:
+        using FloatSoA<6>::FloatSoA;
+
+        AABB3 Get(size_t index) const
+        {
+            AABB3 ret;
+            MATH_LOOP_OPERATION(i, 3, ret.mMin[i] = (*this)[i][index]);
+            MATH_LOOP_OPERATION(i, 3, ret.mMax[i] = (*this)[3 + i][index]);
+            return ret;
+        }
+
+        void Set(size_t index, const AABB3& box)
+        {
+            MATH_LOOP_OPERATION(i, 3, (*this)[i][index] = box.mMin[i]);
+            MATH_LOOP_OPERATION(i, 3, (*this)[3 + i][index] = box.mMax[i]);
+        }
+    };
+
+    // Components 0 to 2 hold the centers, 3 the radii.
+    class SphereSoA : public FloatSoA<4>
+    {
+    public:
+        using FloatSoA<4>::FloatSoA;
+
+        Sphere Get(size_t index) const
+        {
+            return Sphere(float3((*this)[0][index], (*this)[1][index], (*this)[2][index]), (*this)[3][index]);
+        }
+
+        void Set(size_t index, const Sphere& sphere)
+        {
+            MATH_LOOP_OPERATION(i, 3, (*this)[i][index] = sphere.mCenter[i]);
+            (*this)[3][index] = sphere.mRadius;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AABB3.h"
+
+namespace Engine
+{
+    class Sphere
+    {
+    public:
+        Vec3<float> mCenter;
+        float mRadius;
+
+        Sphere() : mCenter(0.0f, 0.0f, 0.0f), mRadius(0.0f)
+        {
+        }
+
+        Sphere(const Vec3<float>& center, float radius) : mCenter(center), mRadius(radius)
+        {
+        }
+
+        // Encloses a non empty box, touching its corners.
+        static Sphere FromAABB(const AABB3& box)
+        {
+            return Sphere(box.Center(), Vec::Length(box.Extent()));
+        }
+
+        bool Contains(const Vec3<float>& point) const
+        {
+            Vec3<float> offset = point - mCenter;
+            return Vec::LengthSquared(offset) <= mRadius * mRadius;
+        }
+
+        bool Intersects(const Sphere& sphere) const
+        {
+            Vec3<float> offset = sphere.mCenter - mCenter;
+            float radius = mRadius + sphere.mRadius;
+            return Vec::LengthSquared(offset) <= radius * radius;
+        }
+
+        // Distance from the center to the closest point of the box.
+        bool Intersects(const AABB3& box) const
+        {
+            float distanceSquared = 0.0f;
+            for (int i = 0; i < 3; i++)
+            {
+                float outside = mCenter[i] < box.mMin[i] ? box.mMin[i] - mCenter[i] : (mCenter[i] > box.mMax[i] ? mCenter[i] - box.mMax[i] : 0.0f);
+                distanceSquared += outside * outside;
+            }
+            return distanceSquared <= mRadius * mRadius;
+        }
+    };
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <type_traits>
+
 #include "Algorithm.h"
 
 namespace Engine
@@ -14,5 +17,5 @@ namespace Engine
     if (std::is_same<T, double>::value)                                             \
         ret = static_cast<T>(std::func(degree*PI/180.0));                           \
     else                                                                            \
-        ret = static_cast<T>(std::func##f(degree*PI_F/180.f));
+        ret = static_cast<T>(std::func(degree*PI_F/180.f));
 }
\ No newline at end of file
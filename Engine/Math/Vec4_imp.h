@@ -75,7 +75,7 @@ namespace Engine
         mArray[0] += static_cast<T>(scalar);
         mArray[1] += static_cast<T>(scalar);
         mArray[2] += static_cast<T>(scalar);
-        mArray[2] += static_cast<T>(scalar);
+        mArray[3] += static_cast<T>(scalar);
         return *this;
     }
 
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+
+#include "SIMD.h"
+
+#if defined(MATH_SIMD)
+
+namespace Engine
+{
+    template<typename T>
+    class Vec4;
+
+    // Same interface as the generic Vec4, kept in one 16 byte aligned register.
+    template<>
+    class Vec4<float> : public Vec
+    {
+    public:
+        typedef Vec4<float> type;
+        typedef float value_type;
+        typedef size_t size_type;
+
+        constexpr static int DIMS = 4;
+        union
+        {
+            Simd::Register mVec;
+            float mData[DIMS];
+            std::array<float, DIMS> mArray;
+            struct{ float x, y, z, w; };
+        };
+
+        Vec4() : mVec(Simd::Zero()) {}
+        Vec4(const Vec4& vec) : mVec(vec.mVec) {}
+        Vec4(Vec4&& vec) : mVec(vec.mVec) {}
+        Vec4(const float& val) : mVec(Simd::Splat(val)) {}
+        Vec4(const float (&val)[4]) : mVec(Simd::Load(val)) {}
+        Vec4(const float& val1, const float& val2, const float& val3, const float& val4) : mVec(Simd::Set(val1, val2, val3, val4)) {}
+        explicit Vec4(Simd::Register vec) : mVec(vec) {}
+
+        size_type Size() const { return DIMS; }
+
+        const float& operator[] (size_type index) const { return mData[index]; }
+        float& operator[](size_type index) { return mData[index]; }
+
+        Vec4& operator= (const Vec4& vec)
+        {
+            mVec = vec.mVec;
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator= (const Vec4<U>& vec)
+        {
+            mVec = Simd::Set(static_cast<float>(vec[0]), static_cast<float>(vec[1]), static_cast<float>(vec[2]), static_cast<float>(vec[3]));
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator+= (const U& scalar)
+        {
+            mVec = Simd::Add(mVec, Simd::Splat(static_cast<float>(scalar)));
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator+= (const Vec4<U>& vec)
+        {
+            mVec = Simd::Add(mVec, Simd::Set(static_cast<float>(vec[0]), static_cast<float>(vec[1]), static_cast<float>(vec[2]), static_cast<float>(vec[3])));
+            return *this;
+        }
+
+        Vec4& operator+= (const Vec4& vec)
+        {
+            mVec = Simd::Add(mVec, vec.mVec);
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator-= (const U& scalar)
+        {
+            mVec = Simd::Sub(mVec, Simd::Splat(static_cast<float>(scalar)));
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator-= (const Vec4<U>& vec)
+        {
+            mVec = Simd::Sub(mVec, Simd::Set(static_cast<float>(vec[0]), static_cast<float>(vec[1]), static_cast<float>(vec[2]), static_cast<float>(vec[3])));
+            return *this;
+        }
+
+        Vec4& operator-= (const Vec4& vec)
+        {
+            mVec = Simd::Sub(mVec, vec.mVec);
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator*= (const U& scalar)
+        {
+            mVec = Simd::Mul(mVec, Simd::Splat(static_cast<float>(scalar)));
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator*= (const Vec4<U>& vec)
+        {
+            mVec = Simd::Mul(mVec, Simd::Set(static_cast<float>(vec[0]), static_cast<float>(vec[1]), static_cast<float>(vec[2]), static_cast<float>(vec[3])));
+            return *this;
+        }
+
+        Vec4& operator*= (const Vec4& vec)
+        {
+            mVec = Simd::Mul(mVec, vec.mVec);
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator/= (const U& scalar)
+        {
+            mVec = Simd::Div(mVec, Simd::Splat(static_cast<float>(scalar)));
+            return *this;
+        }
+
+        template<typename U>
+        Vec4& operator/= (const Vec4<U>& vec)
+        {
+            mVec = Simd::Div(mVec, Simd::Set(static_cast<float>(vec[0]), static_cast<float>(vec[1]), static_cast<float>(vec[2]), static_cast<float>(vec[3])));
+            return *this;
+        }
+
+        Vec4& operator/= (const Vec4& vec)
+        {
+            mVec = Simd::Div(mVec, vec.mVec);
+            return *this;
+        }
+    };
+
+    inline Vec4<float> operator+ (const Vec4<float>& vec, const float& scalar)
+    {
+        return Vec4<float>(Simd::Add(vec.mVec, Simd::Splat(scalar)));
+    }
+
+    inline Vec4<float> operator+ (const float& scalar, const Vec4<float>& vec)
+    {
+        return Vec4<float>(Simd::Add(Simd::Splat(scalar), vec.mVec));
+    }
+
+    inline Vec4<float> operator+ (const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        return Vec4<float>(Simd::Add(vec1.mVec, vec2.mVec));
+    }
+
+    inline Vec4<float> operator- (const Vec4<float>& vec, const float& scalar)
+    {
+        return Vec4<float>(Simd::Sub(vec.mVec, Simd::Splat(scalar)));
+    }
+
+    inline Vec4<float> operator- (const float& scalar, const Vec4<float>& vec)
+    {
+        return Vec4<float>(Simd::Sub(Simd::Splat(scalar), vec.mVec));
+    }
+
+    inline Vec4<float> operator- (const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        return Vec4<float>(Simd::Sub(vec1.mVec, vec2.mVec));
+    }
+
+    inline Vec4<float> operator* (const Vec4<float>& vec, const float& scalar)
+    {
+        return Vec4<float>(Simd::Mul(vec.mVec, Simd::Splat(scalar)));
+    }
+
+    inline Vec4<float> operator* (const float& scalar, const Vec4<float>& vec)
+    {
+        return Vec4<float>(Simd::Mul(Simd::Splat(scalar), vec.mVec));
+    }
+
+    inline Vec4<float> operator* (const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        return Vec4<float>(Simd::Mul(vec1.mVec, vec2.mVec));
+    }
+
+    inline Vec4<float> operator/ (const Vec4<float>& vec, const float& scalar)
+    {
+        return Vec4<float>(Simd::Div(vec.mVec, Simd::Splat(scalar)));
+    }
+
+    inline Vec4<float> operator/ (const float& scalar, const Vec4<float>& vec)
+    {
+        return Vec4<float>(Simd::Div(Simd::Splat(scalar), vec.mVec));
+    }
+
+    inline Vec4<float> operator/ (const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        return Vec4<float>(Simd::Div(vec1.mVec, vec2.mVec));
+    }
+
+    inline Vec4<float> operator- (const Vec4<float>& vec)
+    {
+        return Vec4<float>(Simd::Negate(vec.mVec));
+    }
+
+    inline float Vec::Dot(const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        return Simd::GetX(Simd::Dot4(vec1.mVec, vec2.mVec));
+    }
+
+    inline Vec4<float> Vec::Cross(const Vec4<float>& vec1, const Vec4<float>& vec2)
+    {
+        auto ret = Simd::Sub(Simd::Mul(vec1.mVec, Simd::Swizzle<1, 2, 0, 3>(vec2.mVec)), Simd::Mul(Simd::Swizzle<1, 2, 0, 3>(vec1.mVec), vec2.mVec));
+        return Vec4<float>(Simd::Swizzle<1, 2, 0, 3>(ret));
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,32 +1,16 @@
 #pragma once
 
-#include "Vec2.h"
-#include "Vec3.h"
-#include "Vec4.h"
-
 #include "Utility.h"
+#include "SIMD.h"
 
 namespace Engine
 {
-    typedef Vec2<bool> bool2;
-    typedef Vec3<bool> bool3;
-    typedef Vec4<bool> bool4;
-
-    typedef Vec2<uint32_t> uint2;
-    typedef Vec3<uint32_t> uint3;
-    typedef Vec4<uint32_t> uint4;
-
-    typedef Vec2<int32_t> int2;
-    typedef Vec3<int32_t> int3;
-    typedef Vec4<int32_t> int4;
-
-    typedef Vec2<float> float2;
-    typedef Vec3<float> float3;
-    typedef Vec4<float> float4;
-
-    typedef Vec2<double> double2;
-    typedef Vec3<double> double3;
-    typedef Vec4<double> double4;
+    template<typename T>
+    class Vec2;
+    template<typename T>
+    class Vec3;
+    template<typename T>
+    class Vec4;
 
     class Vec
     {
@@ -35,7 +19,7 @@ namespace Engine
         static inline typename T::value_type Dot(const T& vec1, const T& vec2)
         {
             static_assert(std::is_base_of<Vec, T>::value, "T must inherit from Vec");
-            T::value_type ret = 0;
+            typename T::value_type ret = 0;
             MATH_LOOP_OPERATION(i, T::DIMS, ret += vec1[i] * vec2[i]);
             return ret;
         }
@@ -75,7 +59,53 @@ namespace Engine
             return ret;
         }
 
+        // The cross product of the xyz parts, w is 0.
+        template<typename T>
+        static inline Vec4<T> Cross(const Vec4<T>& vec1, const Vec4<T>& vec2)
+        {
+            Vec4<T> ret;
+            ret.x = vec1.y * vec2.z - vec1.z * vec2.y;
+            ret.y = vec1.z * vec2.x - vec1.x * vec2.z;
+            ret.z = vec1.x * vec2.y - vec1.y * vec2.x;
+            ret.w = 0;
+            return ret;
+        }
+
+#if defined(MATH_SIMD)
+        static inline float Dot(const Vec4<float>& vec1, const Vec4<float>& vec2);
+        static inline Vec4<float> Cross(const Vec4<float>& vec1, const Vec4<float>& vec2);
+#endif
+
     protected:
         Vec() = default;
     };
-}
\ No newline at end of file
+}
+
+#include "Vec2.h"
+#include "Vec3.h"
+#include "Vec4.h"
+
+namespace Engine
+{
+    typedef Vec2<bool> bool2;
+    typedef Vec3<bool> bool3;
+    typedef Vec4<bool> bool4;
+
+    typedef Vec2<uint32_t> uint2;
+    typedef Vec3<uint32_t> uint3;
+    typedef Vec4<uint32_t> uint4;
+
+    typedef Vec2<int32_t> int2;
+    typedef Vec3<int32_t> int3;
+    typedef Vec4<int32_t> int4;
+
+    typedef Vec2<float> float2;
+    typedef Vec3<float> float3;
+    typedef Vec4<float> float4;
+
+    typedef Vec2<double> double2;
+    typedef Vec3<double> double3;
+    typedef Vec4<double> double4;
+}
+
+#include "Vec4_simd.h"
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <stdio.h>
+
+#include "AsyncLogger.h"
+
+namespace
+{
+    const char* LEVEL_NAMES[eLog_Count] = { "Trace", "Debug", "Info", "Warning", "Error" };
+
+    // Hands the ring back when its thread exits, so the next new thread reuses it.
+    struct ThreadRing
+    {
+        ~ThreadRing()
+        {
+            if (pFlag != nullptr)
+                pFlag->store(false, std::memory_order_release);
+        }
+
+        void* pRing = nullptr;
+        std::atomic<bool>* pFlag = nullptr;
+    };
+
+    thread_local ThreadRing s_threadRing;
+}
+
+AsyncLogger& AsyncLogger::Get()
+{
+    static AsyncLogger logger;
+    return logger;
+}
+
+uint32_t AsyncLogger::RegisterFormat(ELogLevel level, const char* format)
+{
+    auto& logger = Get();
+    std::lock_guard<std::mutex> lock(logger.m_mutex);
+
+    auto id = logger.m_formatCount.load(std::memory_order_relaxed);
+    if (id == MAX_FORMATS)
+        return INVALID_FORMAT;
+
+    logger.m_formats[id] = { level, format };
+    logger.m_formatCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+AsyncLogger::AsyncLogger() :
+    m_startTime(Clock::now()),
+    m_formatCount(0),
+    m_ringCount(0),
+    m_unownedDropCount(0),
+    m_pStream(&std::cout),
+    m_writtenCount(0),
+    m_bShutdown(false)
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    Stop();
+}
+
+void AsyncLogger::Start(std::ostream& stream)
+{
+    // A running writer flushes to its old stream first, records queued before any Start go to the new one.
+    if (m_thread.joinable())
+        Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        m_pStream = &stream;
+    }
+
+    m_bShutdown = false;
+    m_thread = std::thread(&AsyncLogger::WriterThread, this);
+}
+
+void AsyncLogger::Stop()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bShutdown = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    Drain();
+}
+
+void AsyncLogger::Flush()
+{
+    Drain();
+}
+
+LogStats AsyncLogger::GetStats() const
+{
+    LogStats stats = { m_writtenCount.load(std::memory_order_relaxed), m_unownedDropCount.load(std::memory_order_relaxed) };
+
+    auto ringCount = m_ringCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < ringCount; i++)
+        stats.droppedCount += m_pRings[i]->droppedCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+AsyncLogger::LogRing* AsyncLogger::GetThreadRing()
+{
+    if (s_threadRing.pRing != nullptr)
+        return static_cast<LogRing*>(s_threadRing.pRing);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Rings of finished threads may still hold records, the new owner simply appends after them.
+    LogRing* pRing = nullptr;
+    auto ringCount = m_ringCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < ringCount && pRing == nullptr; i++)
+    {
+        bool bOwned = false;
+        if (m_pRings[i]->bOwned.compare_exchange_strong(bOwned, true, std::memory_order_acquire))
+            pRing = m_pRings[i].get();
+    }
+
+    if (pRing == nullptr)
+    {
+        if (ringCount == MAX_THREADS)
+            return nullptr;
+
+        m_pRings[ringCount].reset(new LogRing());
+        pRing = m_pRings[ringCount].get();
+        m_ringCount.store(ringCount + 1, std::memory_order_release);
+    }
+
+    s_threadRing.pRing = pRing;
+    s_threadRing.pFlag = &pRing->bOwned;
+    return pRing;
+}
+
+void AsyncLogger::WriterThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_bShutdown)
+    {
+        lock.unlock();
+        Drain();
+        lock.lock();
+
+        m_condition.wait_for(lock, FLUSH_INTERVAL, [this] { return m_bShutdown; });
+    }
+}
+
+void AsyncLogger::Drain()
+{
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+
+    uint64_t recordCount = 0;
+    auto ringCount = m_ringCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < ringCount; i++)
+    {
+        auto& ring = *m_pRings[i];
+        auto head = ring.head.load(std::memory_order_relaxed);
+        auto tail = ring.tail.load(std::memory_order_acquire);
+        for (; head != tail; head++, recordCount++)
+            Format(ring.pRecords[head & (RING_CAPACITY - 1)]);
+        ring.head.store(tail, std::memory_order_release);
+
+        auto droppedCount = ring.droppedCount.load(std::memory_order_relaxed);
+        if (droppedCount != ring.reportedDropCount)
+        {
+            m_batch += "[Log] " + std::to_string(droppedCount - ring.reportedDropCount) + " messages dropped\n";
+            ring.reportedDropCount = droppedCount;
+        }
+    }
+
+    if (m_batch.empty())
+        return;
+
+    m_pStream->write(m_batch.data(), m_batch.size());
+    m_pStream->flush();
+    m_batch.clear();
+    m_writtenCount.fetch_add(recordCount, std::memory_order_relaxed);
+}
+
+void AsyncLogger::Format(const LogRecord& record)
+{
+    char prefix[64];
+    auto seconds = std::chrono::duration<double>(Clock::duration(record.timestamp)).count();
+    if (record.formatId >= m_formatCount.load(std::memory_order_acquire))
+    {
+        snprintf(prefix, sizeof(prefix), "[%.6f] [Log] unknown format\n", seconds);
+        m_batch += prefix;
+        return;
+    }
+
+    auto& format = m_formats[record.formatId];
+    snprintf(prefix, sizeof(prefix), "[%.6f] [%s] ", seconds, LEVEL_NAMES[format.level]);
+    m_batch += prefix;
+
+    uint32_t index = 0;
+    for (auto p = format.format; *p != '\0'; p++)
+    {
+        if (p[0] == '{' && p[1] == '}' && index < record.argCount)
+        {
+            FormatArg(record, index++);
+            p++;
+        }
+        else
+            m_batch += *p;
+    }
+    m_batch += '\n';
+}
+
+void AsyncLogger::FormatArg(const LogRecord& record, uint32_t index)
+{
+    char buffer[32];
+    auto& arg = record.args[index];
+    switch (record.argTypes[index])
+    {
+        case eLogArg_Int:
+            snprintf(buffer, sizeof(buffer), "%lld", (long long)arg.i);
+            break;
+        case eLogArg_UInt:
+            snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)arg.u);
+            break;
+        case eLogArg_Float:
+            snprintf(buffer, sizeof(buffer), "%g", arg.f);
+            break;
+        case eLogArg_Text:
+            m_batch.append(record.text + arg.text.offset, arg.text.size);
+            return;
+    }
+    m_batch += buffer;
+}
+
+void AsyncLogger::EncodeText(LogRecord& record, const char* pText, size_t size)
+{
+    auto& arg = record.args[record.argCount];
+    arg.text.offset = record.textSize;
+    arg.text.size = (uint16_t)std::min<size_t>(size, LogRecord::TEXT_SIZE - record.textSize);
+
+    memcpy(record.text + record.textSize, pText, arg.text.size);
+    record.textSize += arg.text.size;
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <string.h>
+#include <stdint.h>
+
+enum ELogLevel
+{
+    eLog_Trace = 0,
+    eLog_Debug,
+    eLog_Info,
+    eLog_Warning,
+    eLog_Error,
+    eLog_Count,
+};
+
+// Levels below this are compiled out, arguments included.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL eLog_Info
+#else
+#define LOG_MIN_LEVEL eLog_Debug
+#endif
+#endif
+
+enum ELogArg : uint8_t
+{
+    eLogArg_Int = 0,
+    eLogArg_UInt,
+    eLogArg_Float,
+    eLogArg_Text,
+};
+
+union LogArg
+{
+    struct Text
+    {
+        uint16_t offset;
+        uint16_t size;
+    };
+
+    int64_t i;
+    uint64_t u;
+    double f;
+    Text text;
+};
+
+// One log call: the format is referenced by ID, arguments are kept raw and strings are
+// copied into the trailing text buffer, truncated if they do not fit.
+struct LogRecord
+{
+    constexpr static uint32_t MAX_ARGS = 6;
+    constexpr static uint32_t TEXT_SIZE = 184;
+
+    int64_t timestamp;
+    uint32_t formatId;
+    uint16_t textSize;
+    uint8_t argCount;
+    ELogArg argTypes[MAX_ARGS];
+    LogArg args[MAX_ARGS];
+    char text[TEXT_SIZE];
+};
+
+static_assert(sizeof(LogRecord) == 256, "LogRecord should fill exactly four cache lines");
+
+struct LogStats
+{
+    uint64_t writtenCount;
+    uint64_t droppedCount;
+};
+
+// Log calls only copy a fixed-size record into a ring owned by the calling thread, the
+// formatting and the stream writes happen in batches on a background thread. A full ring
+// drops the record and counts it rather than blocking the caller.
+class AsyncLogger
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    constexpr static uint32_t INVALID_FORMAT = static_cast<uint32_t>(-1);
+    constexpr static uint32_t MAX_FORMATS = 1024;
+    constexpr static uint32_t MAX_THREADS = 64;
+    constexpr static uint32_t RING_CAPACITY = 1024;
+    constexpr static auto FLUSH_INTERVAL = std::chrono::milliseconds(2);
+
+    static AsyncLogger& Get();
+
+    // Called once per call site through the LOG_ macros, "{}" in the format takes the next argument.
+    static uint32_t RegisterFormat(ELogLevel level, const char* format);
+
+    AsyncLogger(const AsyncLogger& copy) = delete;
+    AsyncLogger& operator=(const AsyncLogger& copy) = delete;
+    virtual ~AsyncLogger();
+
+    // Starts the background writer. Without it records stay queued until Flush.
+    void Start(std::ostream& stream = std::cout);
+    void Stop();
+
+    // Formats and writes everything queued so far on the calling thread.
+    void Flush();
+
+    template<typename... Args>
+    void Write(uint32_t formatId, const Args&... args);
+
+    LogStats GetStats() const;
+
+private:
+    struct LogFormat
+    {
+        ELogLevel level;
+        const char* format;
+    };
+
+    // Single producer, the background writer is the only consumer.
+    struct LogRing
+    {
+        LogRing();
+
+        LogRecord* BeginWrite();
+        void EndWrite();
+
+        std::unique_ptr<LogRecord[]> pRecords;
+        alignas(64) std::atomic<uint32_t> head;
+        alignas(64) std::atomic<uint32_t> tail;
+        std::atomic<uint64_t> droppedCount;
+        std::atomic<bool> bOwned;
+        uint64_t reportedDropCount;
+    };
+
+    AsyncLogger();
+
+    LogRing* GetThreadRing();
+    void WriterThread();
+    void Drain();
+    void Format(const LogRecord& record);
+    void FormatArg(const LogRecord& record, uint32_t index);
+
+    template<typename T>
+    static void Encode(LogRecord& record, const T& value);
+    static void EncodeText(LogRecord& record, const char* pText, size_t size);
+
+private:
+    Clock::time_point m_startTime;
+
+    LogFormat m_formats[MAX_FORMATS];
+    std::atomic<uint32_t> m_formatCount;
+
+    std::unique_ptr<LogRing> m_pRings[MAX_THREADS];
+    std::atomic<uint32_t> m_ringCount;
+    std::atomic<uint64_t> m_unownedDropCount;
+
+    std::ostream* m_pStream;
+    std::string m_batch;
+    std::atomic<uint64_t> m_writtenCount;
+    std::mutex m_drainMutex;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_bShutdown;
+};
+
+template<typename... Args>
+inline void AsyncLogger::Write(uint32_t formatId, const Args&... args)
+{
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+
+    auto pRing = GetThreadRing();
+    auto pRecord = pRing != nullptr ? pRing->BeginWrite() : nullptr;
+    if (pRecord == nullptr)
+    {
+        auto& droppedCount = pRing != nullptr ? pRing->droppedCount : m_unownedDropCount;
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    pRecord->timestamp = (Clock::now() - m_startTime).count();
+    pRecord->formatId = formatId;
+    pRecord->textSize = 0;
+    pRecord->argCount = 0;
+
+    int expand[] = { 0, (Encode(*pRecord, args), 0)... };
+    (void)expand;
+
+    pRing->EndWrite();
+}
+
+template<typename T>
+inline void AsyncLogger::Encode(LogRecord& record, const T& value)
+{
+    auto& arg = record.args[record.argCount];
+    auto& type = record.argTypes[record.argCount];
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        type = eLogArg_Float;
+        arg.f = value;
+    }
+    else if constexpr (std::is_enum<T>::value || std::is_signed<T>::value)
+    {
+        type = eLogArg_Int;
+        arg.i = static_cast<int64_t>(value);
+    }
+    else if constexpr (std::is_unsigned<T>::value)
+    {
+        type = eLogArg_UInt;
+        arg.u = value;
+    }
+    else if constexpr (std::is_same<T, std::string>::value)
+    {
+        type = eLogArg_Text;
+        EncodeText(record, value.data(), value.size());
+    }
+    else
+    {
+        static_assert(std::is_convertible<const T&, const char*>::value, "Unsupported log argument");
+        const char* pText = value;
+        type = eLogArg_Text;
+        EncodeText(record, pText != nullptr ? pText : "(null)", pText != nullptr ? strlen(pText) : 6);
+    }
+    record.argCount++;
+}
+
+inline AsyncLogger::LogRing::LogRing() :
+    pRecords(new LogRecord[RING_CAPACITY]),
+    head(0),
+    tail(0),
+    droppedCount(0),
+    bOwned(true),
+    reportedDropCount(0)
+{}
+
+inline LogRecord* AsyncLogger::LogRing::BeginWrite()
+{
+    auto position = tail.load(std::memory_order_relaxed);
+    if (position - head.load(std::memory_order_acquire) >= RING_CAPACITY)
+        return nullptr;
+    return &pRecords[position & (RING_CAPACITY - 1)];
+}
+
+inline void AsyncLogger::LogRing::EndWrite()
+{
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+#define LOG_MESSAGE(level, format, ...)                                                         \
+    do                                                                                          \
+    {                                                                                           \
+        if constexpr ((level) >= LOG_MIN_LEVEL)                                                 \
+        {                                                                                       \
+            static const uint32_t logFormatId = AsyncLogger::RegisterFormat(level, format);     \
+            AsyncLogger::Get().Write(logFormatId, ##__VA_ARGS__);                               \
+        }                                                                                       \
+    } while (0)
+
+#define LOG_TRACE(format, ...) LOG_MESSAGE(eLog_Trace, format, ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_MESSAGE(eLog_Debug, format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_MESSAGE(eLog_Info, format, ##__VA_ARGS__)
+#define LOG_WARNING(format, ...) LOG_MESSAGE(eLog_Warning, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG_MESSAGE(eLog_Error, format, ##__VA_ARGS__)
\ No newline at end of file
@@ -5,7 +5,7 @@
 class FPSCounter
 {
 public:
-    typedef std::chrono::time_point<std::chrono::system_clock> time;
+    typedef std::chrono::time_point<std::chrono::steady_clock> time;
     typedef std::chrono::duration<float, std::milli> ms;
     typedef std::chrono::duration<float> second;
 
@@ -17,12 +17,12 @@ public:
 
     void BeginTick()
     {
-        m_tickBeginTime = std::chrono::system_clock::now();
+        m_tickBeginTime = std::chrono::steady_clock::now();
     }
 
     void EndTick()
     {
-        m_tickEndTime = std::chrono::system_clock::now();
+        m_tickEndTime = std::chrono::steady_clock::now();
 
         m_oneTickDuration = std::chrono::duration_cast<ms>(m_tickEndTime - m_tickBeginTime);
         m_oneSecDuration += m_oneTickDuration;
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+// Accumulates variable frame times and hands them out as whole steps of a fixed size.
+// What is left over, as a fraction of a step, blends the last two simulated states.
+class FixedTimestep
+{
+public:
+    constexpr static float DEFAULT_STEP = 1000.0f / 60.0f;
+    constexpr static uint32_t DEFAULT_MAX_STEPS = 5;
+
+    FixedTimestep() : m_step(DEFAULT_STEP), m_maxSteps(DEFAULT_MAX_STEPS), m_accumulator(0), m_stepCount(0), m_droppedCount(0) {}
+    ~FixedTimestep() = default;
+
+    void SetStep(float step) { m_step = step; }
+    float GetStep() const { return m_step; }
+
+    void SetMaxSteps(uint32_t maxSteps) { m_maxSteps = maxSteps; }
+    uint32_t GetMaxSteps() const { return m_maxSteps; }
+
+    // Returns how many steps to simulate for this frame. Time past maxSteps is dropped, so
+    // a frame that was slow does not make the next one slower still.
+    uint32_t Advance(float elapsedTime)
+    {
+        m_accumulator += elapsedTime;
+
+        auto count = (uint32_t)(m_accumulator / m_step);
+        m_accumulator -= (double)count * m_step;
+        if (count > m_maxSteps)
+        {
+            m_droppedCount += count - m_maxSteps;
+            count = m_maxSteps;
+        }
+
+        m_stepCount += count;
+        return count;
+    }
+
+    // In [0, 1), how far the current frame is past the last simulated step.
+    float GetAlpha() const
+    {
+        return (float)(m_accumulator / m_step);
+    }
+
+    uint64_t GetStepCount() const { return m_stepCount; }
+    uint64_t GetDroppedCount() const { return m_droppedCount; }
+
+    void Reset()
+    {
+        m_accumulator = 0;
+        m_stepCount = 0;
+        m_droppedCount = 0;
+    }
+
+private:
+    float m_step;
+    uint32_t m_maxSteps;
+
+    double m_accumulator;
+    uint64_t m_stepCount;
+    uint64_t m_droppedCount;
+};
\ No newline at end of file
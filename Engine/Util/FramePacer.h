@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <stdint.h>
+
+enum EFramePacing
+{
+    ePacing_None = 0,
+    ePacing_Yield,
+    ePacing_Sleep,
+};
+
+// Holds the main loop to a target frame rate. Sleeping leaves the core idle, which is what
+// a headless server wants, yielding keeps tighter timing at the cost of a busy core.
+class FramePacer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::duration<float, std::milli> ms;
+
+    // sleep_for may overshoot by a scheduler quantum, the last stretch is spent yielding.
+    constexpr static auto SLEEP_SLACK = std::chrono::milliseconds(2);
+
+    FramePacer() : m_pacing(ePacing_None), m_targetFrameTime(Clock::duration::zero()), m_bStarted(false) {}
+    ~FramePacer() = default;
+
+    // 0 leaves the frame rate unlimited.
+    void SetTargetFrameRate(uint32_t frameRate)
+    {
+        m_targetFrameTime = frameRate > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate)) : Clock::duration::zero();
+    }
+
+    void SetPacing(EFramePacing pacing)
+    {
+        m_pacing = pacing;
+    }
+
+    // Waits out the rest of the target frame time, then returns the wall time since the
+    // previous frame began in milliseconds. The first call returns 0.
+    float BeginFrame()
+    {
+        auto now = Clock::now();
+        if (!m_bStarted)
+        {
+            m_bStarted = true;
+            m_frameBeginTime = now;
+            m_nextFrameTime = now + m_targetFrameTime;
+            return 0.0f;
+        }
+
+        if (m_pacing != ePacing_None && m_targetFrameTime > Clock::duration::zero())
+        {
+            if (m_pacing == ePacing_Sleep && m_nextFrameTime - now > SLEEP_SLACK)
+                std::this_thread::sleep_for(m_nextFrameTime - now - SLEEP_SLACK);
+
+            while ((now = Clock::now()) < m_nextFrameTime)
+                std::this_thread::yield();
+
+            // Missing a frame starts a new schedule rather than rushing the next ones to catch up.
+            m_nextFrameTime += m_targetFrameTime;
+            if (m_nextFrameTime < now)
+                m_nextFrameTime = now + m_targetFrameTime;
+        }
+
+        ms elapsedTime = now - m_frameBeginTime;
+        m_frameBeginTime = now;
+        return elapsedTime.count();
+    }
+
+private:
+    EFramePacing m_pacing;
+    Clock::duration m_targetFrameTime;
+
+    Clock::time_point m_frameBeginTime;
+    Clock::time_point m_nextFrameTime;
+    bool m_bStarted;
+};
\ No newline at end of file
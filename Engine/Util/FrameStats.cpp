@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <vector>
+
+#include "FrameStats.h"
+
+FrameStats::FrameStats() : m_phaseCount(0), m_pWindow(new float[WINDOW_SIZE * COLUMN_COUNT])
+{
+    for (auto& phaseTime : m_phaseTimes)
+        phaseTime.store(0, std::memory_order_relaxed);
+    Reset();
+}
+
+uint32_t FrameStats::RegisterPhase(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto count = m_phaseCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (m_phaseNames[i] == name)
+            return i;
+    }
+
+    if (count == MAX_PHASES)
+        return INVALID_PHASE;
+
+    m_phaseNames[count] = name;
+    m_phaseCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+uint32_t FrameStats::GetPhaseCount() const
+{
+    return m_phaseCount.load(std::memory_order_acquire);
+}
+
+const std::string& FrameStats::GetPhaseName(uint32_t phase) const
+{
+    return m_phaseNames[phase];
+}
+
+void FrameStats::AddPhaseTime(uint32_t phase, Clock::duration time)
+{
+    if (phase >= MAX_PHASES)
+        return;
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    m_phaseTimes[phase].fetch_add(ns, std::memory_order_relaxed);
+}
+
+void FrameStats::EndFrame()
+{
+    auto now = Clock::now();
+    if (!m_bStarted)
+    {
+        m_bStarted = true;
+        m_lastFrameTime = now;
+
+        for (auto& phaseTime : m_phaseTimes)
+            phaseTime.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    ms frameTime = now - m_lastFrameTime;
+    m_lastFrameTime = now;
+    EndFrame(frameTime.count());
+}
+
+void FrameStats::EndFrame(float frameTime)
+{
+    auto pRow = &m_pWindow[(m_frameCount % WINDOW_SIZE) * COLUMN_COUNT];
+    pRow[0] = frameTime;
+    for (uint32_t i = 0; i < MAX_PHASES; i++)
+        pRow[i + 1] = m_phaseTimes[i].exchange(0, std::memory_order_relaxed) / 1000000.0f;
+
+    auto bucket = (uint32_t)std::max(frameTime / BUCKET_WIDTH, 0.0f);
+    m_histogram[std::min(bucket, BUCKET_COUNT - 1)]++;
+    m_frameCount++;
+}
+
+uint64_t FrameStats::GetFrameCount() const
+{
+    return m_frameCount;
+}
+
+FrameStats::Summary FrameStats::GetFrameSummary() const
+{
+    return Summarize(0);
+}
+
+FrameStats::Summary FrameStats::GetPhaseSummary(uint32_t phase) const
+{
+    if (phase >= MAX_PHASES)
+        return Summary();
+    return Summarize(phase + 1);
+}
+
+const uint64_t* FrameStats::GetHistogram() const
+{
+    return m_histogram;
+}
+
+void FrameStats::WriteCSV(std::ostream& stream) const
+{
+    auto phaseCount = GetPhaseCount();
+
+    stream << "frame,frame time";
+    for (uint32_t i = 0; i < phaseCount; i++)
+        stream << "," << m_phaseNames[i];
+    stream << "\n";
+
+    auto count = (uint32_t)std::min<uint64_t>(m_frameCount, WINDOW_SIZE);
+    for (auto frame = m_frameCount - count; frame < m_frameCount; frame++)
+    {
+        auto pRow = &m_pWindow[(frame % WINDOW_SIZE) * COLUMN_COUNT];
+        stream << frame << "," << pRow[0];
+        for (uint32_t i = 0; i < phaseCount; i++)
+            stream << "," << pRow[i + 1];
+        stream << "\n";
+    }
+    stream.flush();
+}
+
+void FrameStats::Reset()
+{
+    std::fill(m_histogram, m_histogram + BUCKET_COUNT, 0);
+    m_frameCount = 0;
+    m_bStarted = false;
+}
+
+FrameStats::Summary FrameStats::Summarize(uint32_t column) const
+{
+    Summary summary = {};
+    auto count = (uint32_t)std::min<uint64_t>(m_frameCount, WINDOW_SIZE);
+    if (count == 0)
+        return summary;
+
+    std::vector<float> times(count);
+    for (uint32_t i = 0; i < count; i++)
+        times[i] = m_pWindow[i * COLUMN_COUNT + column];
+    std::sort(times.begin(), times.end());
+
+    // Nearest rank, so every percentile is a frame that actually happened.
+    auto percentile = [&](uint32_t percent) {
+        auto rank = (count * percent + 99) / 100;
+        return times[std::max(rank, 1u) - 1];
+    };
+
+    double total = 0;
+    for (auto time : times)
+        total += time;
+
+    summary.count = count;
+    summary.average = (float)(total / count);
+    summary.p50 = percentile(50);
+    summary.p95 = percentile(95);
+    summary.p99 = percentile(99);
+    summary.max = times.back();
+    return summary;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <stdint.h>
+
+// Frame times over a rolling window, with the time spent in each named phase of those
+// frames. Percentiles and the histogram show the hitches an average smooths away.
+class FrameStats
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::duration<float, std::milli> ms;
+
+    constexpr static uint32_t INVALID_PHASE = static_cast<uint32_t>(-1);
+    constexpr static uint32_t MAX_PHASES = 63;
+    constexpr static uint32_t WINDOW_SIZE = 512;
+
+    // Milliseconds per histogram bucket, the last bucket also takes everything longer.
+    constexpr static float BUCKET_WIDTH = 0.5f;
+    constexpr static uint32_t BUCKET_COUNT = 100;
+
+    struct Summary
+    {
+        uint32_t count;
+        float average;
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+    // Adds the lifetime of the scope to a phase, a null FrameStats makes it a no-op.
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(FrameStats* pStats, uint32_t phase) : m_pStats(pStats), m_phase(phase)
+        {
+            if (m_pStats != nullptr)
+                m_beginTime = Clock::now();
+        }
+
+        ~ScopedPhase()
+        {
+            if (m_pStats != nullptr)
+                m_pStats->AddPhaseTime(m_phase, Clock::now() - m_beginTime);
+        }
+
+    private:
+        FrameStats* m_pStats;
+        uint32_t m_phase;
+        Clock::time_point m_beginTime;
+    };
+
+    FrameStats();
+    FrameStats(const FrameStats& copy) = delete;
+    FrameStats& operator=(const FrameStats& copy) = delete;
+    virtual ~FrameStats() = default;
+
+    // Registering a name twice returns the same phase. INVALID_PHASE once MAX_PHASES are taken.
+    uint32_t RegisterPhase(const std::string& name);
+    uint32_t GetPhaseCount() const;
+    const std::string& GetPhaseName(uint32_t phase) const;
+
+    // Any thread, summed into the frame in progress.
+    void AddPhaseTime(uint32_t phase, Clock::duration time);
+
+    // Closes the frame in progress, timed from the previous EndFrame. The first call only starts the clock.
+    void EndFrame();
+
+    // Closes the frame in progress with an explicit frame time in milliseconds.
+    void EndFrame(float frameTime);
+
+    uint64_t GetFrameCount() const;
+    Summary GetFrameSummary() const;
+    Summary GetPhaseSummary(uint32_t phase) const;
+
+    // BUCKET_COUNT counts of every frame since the last Reset.
+    const uint64_t* GetHistogram() const;
+
+    // One row per frame in the window, oldest first, times in milliseconds.
+    void WriteCSV(std::ostream& stream) const;
+
+    void Reset();
+
+private:
+    constexpr static uint32_t COLUMN_COUNT = MAX_PHASES + 1;
+
+    Summary Summarize(uint32_t column) const;
+
+private:
+    std::string m_phaseNames[MAX_PHASES];
+    std::atomic<uint32_t> m_phaseCount;
+    std::mutex m_mutex;
+
+    std::atomic<int64_t> m_phaseTimes[MAX_PHASES];
+
+    // WINDOW_SIZE rows of the frame time followed by every phase time.
+    std::unique_ptr<float[]> m_pWindow;
+    uint64_t m_frameCount;
+    uint64_t m_histogram[BUCKET_COUNT];
+
+    Clock::time_point m_lastFrameTime;
+    bool m_bStarted;
+};
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "JobSystem.h"
+
+namespace
+{
+    constexpr uint32_t INVALID_THREAD_INDEX = static_cast<uint32_t>(-1);
+    constexpr uint32_t SPIN_COUNT = 64;
+
+    thread_local uint32_t s_threadIndex = INVALID_THREAD_INDEX;
+}
+
+bool JobDeque::Push(Job* pJob)
+{
+    auto bottom = m_bottom.load(std::memory_order_relaxed);
+    auto top = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= CAPACITY)
+        return false;
+
+    m_slots[bottom & (CAPACITY - 1)].store(pJob, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+Job* JobDeque::Pop()
+{
+    auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    auto top = m_top.load(std::memory_order_seq_cst);
+
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto pJob = m_slots[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // Last job, race the thieves for it.
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            pJob = nullptr;
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return pJob;
+}
+
+Job* JobDeque::Steal()
+{
+    auto top = m_top.load(std::memory_order_seq_cst);
+    auto bottom = m_bottom.load(std::memory_order_seq_cst);
+
+    if (top >= bottom)
+        return nullptr;
+
+    auto pJob = m_slots[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return pJob;
+}
+
+JobSystem::JobSystem() : m_pendingCount(0), m_sleepingCount(0), m_bShutdown(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+    Shutdown();
+    m_bShutdown = false;
+
+    for (uint32_t i = 0; i <= workerCount; i++)
+    {
+        auto pWorker = std::make_unique<Worker>();
+        pWorker->pSlots = std::make_unique<JobSlot[]>(JobDeque::CAPACITY);
+        for (int64_t j = 0; j < JobDeque::CAPACITY; j++)
+            pWorker->pSlots[j].bBusy.store(false, std::memory_order_relaxed);
+        pWorker->nextSlot = 0;
+        pWorker->random = i * 2654435761u + 1;
+        m_pWorkers.emplace_back(std::move(pWorker));
+    }
+
+    s_threadIndex = 0;
+    for (uint32_t i = 1; i <= workerCount; i++)
+        m_threads.emplace_back(&JobSystem::WorkerThread, this, i);
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bShutdown = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+
+    m_threads.clear();
+    m_pWorkers.clear();
+    m_pendingCount = 0;
+    s_threadIndex = INVALID_THREAD_INDEX;
+}
+
+uint32_t JobSystem::GetThreadCount() const
+{
+    return std::max((uint32_t)m_pWorkers.size(), 1u);
+}
+
+uint32_t JobSystem::GetThreadIndex() const
+{
+    return s_threadIndex;
+}
+
+void JobSystem::Run(JobFunc func, void* pData, JobCounter* pCounter)
+{
+    if (pCounter != nullptr)
+        pCounter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+    Job job = { func, pData, pCounter };
+
+    // Threads outside the system have no deque, they run their jobs inline.
+    if (s_threadIndex >= m_pWorkers.size())
+    {
+        Execute(&job);
+        return;
+    }
+
+    auto& worker = *m_pWorkers[s_threadIndex];
+    auto& slot = worker.pSlots[worker.nextSlot];
+    if (slot.bBusy.load(std::memory_order_acquire))
+    {
+        Execute(&job);
+        return;
+    }
+
+    static_cast<Job&>(slot) = job;
+    slot.bBusy.store(true, std::memory_order_relaxed);
+
+    m_pendingCount.fetch_add(1, std::memory_order_seq_cst);
+    if (!worker.deque.Push(&slot))
+    {
+        m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+        slot.bBusy.store(false, std::memory_order_relaxed);
+        Execute(&job);
+        return;
+    }
+    worker.nextSlot = (worker.nextSlot + 1) & (JobDeque::CAPACITY - 1);
+
+    if (m_sleepingCount.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condition.notify_one();
+    }
+}
+
+void JobSystem::Wait(JobCounter* pCounter)
+{
+    auto index = s_threadIndex;
+    while (!pCounter->IsDone())
+    {
+        if (index >= m_pWorkers.size() || !TryRunJob(index))
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::TryRunJob()
+{
+    if (s_threadIndex >= m_pWorkers.size())
+        return false;
+
+    return TryRunJob(s_threadIndex);
+}
+
+void JobSystem::WorkerThread(uint32_t index)
+{
+    s_threadIndex = index;
+
+    uint32_t spin = 0;
+    while (!m_bShutdown.load(std::memory_order_relaxed))
+    {
+        if (TryRunJob(index))
+        {
+            spin = 0;
+            continue;
+        }
+
+        if (++spin < SPIN_COUNT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        Sleep();
+        spin = 0;
+    }
+}
+
+bool JobSystem::TryRunJob(uint32_t index)
+{
+    auto& worker = *m_pWorkers[index];
+
+    auto pJob = worker.deque.Pop();
+    if (pJob == nullptr)
+    {
+        auto count = (uint32_t)m_pWorkers.size();
+        worker.random ^= worker.random << 13;
+        worker.random ^= worker.random >> 17;
+        worker.random ^= worker.random << 5;
+
+        for (uint32_t i = 0, start = worker.random % count; i < count && pJob == nullptr; i++)
+        {
+            auto victim = (start + i) % count;
+            if (victim != index)
+                pJob = m_pWorkers[victim]->deque.Steal();
+        }
+    }
+
+    if (pJob == nullptr)
+        return false;
+
+    m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+
+    // Release the slot before running so the owner can reuse it while this job runs.
+    Job job = *pJob;
+    static_cast<JobSlot*>(pJob)->bBusy.store(false, std::memory_order_release);
+
+    Execute(&job);
+    return true;
+}
+
+void JobSystem::Execute(Job* pJob)
+{
+    pJob->func(pJob->pData);
+    if (pJob->pCounter != nullptr)
+        pJob->pCounter->m_count.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::Sleep()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+    m_condition.wait(lock, [&]() {
+        return m_bShutdown.load(std::memory_order_relaxed) || m_pendingCount.load(std::memory_order_seq_cst) > 0;
+    });
+    m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+}
\ No newline at end of file
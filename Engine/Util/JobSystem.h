@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdint.h>
+
+class JobCounter
+{
+public:
+    JobCounter() : m_count(0) {}
+
+    bool IsDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_count;
+};
+
+typedef void(*JobFunc)(void* pData);
+
+struct Job
+{
+    JobFunc func;
+    void* pData;
+    JobCounter* pCounter;
+};
+
+// Chase-Lev work-stealing deque: the owner pushes and pops at the bottom,
+// other workers steal from the top.
+class JobDeque
+{
+public:
+    constexpr static int64_t CAPACITY = 4096;
+
+    JobDeque() : m_top(0), m_bottom(0)
+    {
+        for (auto& slot : m_slots)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    bool Push(Job* pJob);
+    Job* Pop();
+    Job* Steal();
+
+private:
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<Job*> m_slots[CAPACITY];
+};
+
+class JobSystem
+{
+public:
+    JobSystem();
+    virtual ~JobSystem();
+
+    // Spawns workerCount threads, the calling thread becomes worker 0.
+    void Initialize(uint32_t workerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    void Shutdown();
+
+    uint32_t GetThreadCount() const;
+    uint32_t GetThreadIndex() const;
+
+    void Run(JobFunc func, void* pData, JobCounter* pCounter = nullptr);
+
+    template<typename Func>
+    void Run(Func& func, JobCounter* pCounter = nullptr);
+
+    // Runs other jobs on the calling thread until the counter drops to zero.
+    void Wait(JobCounter* pCounter);
+
+    // Runs at most one queued job on the calling thread, for callers that wait on their own condition.
+    bool TryRunJob();
+
+    // Splits [begin, end) into batches of at least minBatch indices and calls func(i) for each.
+    template<typename Func>
+    void ParallelFor(uint32_t begin, uint32_t end, Func func, uint32_t minBatch = 1);
+
+private:
+    struct JobSlot : public Job
+    {
+        std::atomic<bool> bBusy;
+    };
+
+    struct Worker
+    {
+        JobDeque deque;
+        std::unique_ptr<JobSlot[]> pSlots;
+        uint32_t nextSlot;
+        uint32_t random;
+    };
+
+    void WorkerThread(uint32_t index);
+    bool TryRunJob(uint32_t index);
+    void Execute(Job* pJob);
+    void Sleep();
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_pWorkers;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<int32_t> m_pendingCount;
+    std::atomic<int32_t> m_sleepingCount;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<bool> m_bShutdown;
+};
+
+template<typename Func>
+inline void JobSystem::Run(Func& func, JobCounter* pCounter)
+{
+    Run([](void* pData) { (*static_cast<Func*>(pData))(); }, &func, pCounter);
+}
+
+template<typename Func>
+inline void JobSystem::ParallelFor(uint32_t begin, uint32_t end, Func func, uint32_t minBatch)
+{
+    if (begin >= end)
+        return;
+
+    struct Batch
+    {
+        Func* pFunc;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    // Aim for a few batches per thread so stealing can even out the load.
+    uint32_t count = end - begin;
+    uint32_t batchSize = std::max(minBatch, (count + GetThreadCount() * 4 - 1) / (GetThreadCount() * 4));
+    uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+    if (batchCount == 1)
+    {
+        for (uint32_t i = begin; i < end; i++)
+            func(i);
+        return;
+    }
+
+    std::vector<Batch> batches(batchCount);
+    JobCounter counter;
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        batches[i].pFunc = &func;
+        batches[i].begin = begin + i * batchSize;
+        batches[i].end = std::min(end, batches[i].begin + batchSize);
+
+        Run([](void* pData) {
+            auto pBatch = static_cast<Batch*>(pData);
+            for (uint32_t j = pBatch->begin; j < pBatch->end; j++)
+                (*pBatch->pFunc)(j);
+        }, &batches[i], &counter);
+    }
+
+    Wait(&counter);
+}
\ No newline at end of file
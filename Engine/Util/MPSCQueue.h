@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <stdint.h>
+
+// Bounded lock-free queue for many producers and one consumer. Each cell carries a
+// sequence number telling producers whether it is free and the consumer whether it is
+// filled, so neither side ever waits on the other.
+template<typename T>
+class MPSCQueue
+{
+public:
+    MPSCQueue(uint32_t capacity);
+    MPSCQueue(const MPSCQueue& copy) = delete;
+    MPSCQueue& operator=(const MPSCQueue& copy) = delete;
+    virtual ~MPSCQueue();
+
+    // Any thread. Returns false when the queue is full.
+    bool TryPush(const T& value);
+
+    // Consumer thread only. Hands the oldest value to func before releasing its cell.
+    template<typename Func>
+    bool TryPop(Func func);
+
+    uint32_t Capacity() const;
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    struct Cell
+    {
+        std::atomic<uint32_t> sequence;
+        Slot value;
+    };
+
+private:
+    std::unique_ptr<Cell[]> m_pCells;
+    uint32_t m_mask;
+
+    alignas(64) std::atomic<uint32_t> m_tail;
+    alignas(64) uint32_t m_head;
+};
+
+template<typename T>
+MPSCQueue<T>::MPSCQueue(uint32_t capacity) : m_tail(0), m_head(0)
+{
+    uint32_t size = 2;
+    while (size < capacity)
+        size *= 2;
+
+    m_pCells.reset(new Cell[size]);
+    m_mask = size - 1;
+    for (uint32_t i = 0; i < size; i++)
+        m_pCells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+MPSCQueue<T>::~MPSCQueue()
+{
+    while (TryPop([](T&) {}));
+}
+
+template<typename T>
+bool MPSCQueue<T>::TryPush(const T& value)
+{
+    auto pos = m_tail.load(std::memory_order_relaxed);
+    Cell* pCell = nullptr;
+    for (;;)
+    {
+        pCell = &m_pCells[pos & m_mask];
+        auto sequence = pCell->sequence.load(std::memory_order_acquire);
+        auto diff = (int32_t)(sequence - pos);
+        if (diff == 0)
+        {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false;
+        else
+            pos = m_tail.load(std::memory_order_relaxed);
+    }
+
+    new (&pCell->value) T(value);
+    pCell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename Func>
+bool MPSCQueue<T>::TryPop(Func func)
+{
+    auto& cell = m_pCells[m_head & m_mask];
+    if ((int32_t)(cell.sequence.load(std::memory_order_acquire) - (m_head + 1)) < 0)
+        return false;
+
+    auto pValue = reinterpret_cast<T*>(&cell.value);
+    func(*pValue);
+    pValue->~T();
+
+    // Free again once the producers have wrapped around the whole ring.
+    cell.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    m_head++;
+    return true;
+}
+
+template<typename T>
+uint32_t MPSCQueue<T>::Capacity() const
+{
+    return m_mask + 1;
+}
\ No newline at end of file
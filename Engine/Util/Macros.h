@@ -1,4 +1,3 @@
 #pragma once
 
-#define strPtr(str)                                         \
-    std::make_shared<std::string>(str)
\ No newline at end of file
+#define strPtr(str) std::make_shared<std::string>(str)
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <stdint.h>
+
+// FIFO over a power-of-two array of raw slots. Capacity only ever doubles, so once
+// it has grown to the steady-state depth pushes and pops no longer allocate.
+template<typename T>
+class RingBuffer
+{
+public:
+    constexpr static uint32_t MIN_CAPACITY = 16;
+
+    RingBuffer();
+    RingBuffer(const RingBuffer& copy) = delete;
+    RingBuffer& operator=(const RingBuffer& copy) = delete;
+    virtual ~RingBuffer();
+
+    void Push(const T& value);
+    void Push(T&& value);
+    void Pop();
+
+    T& Front();
+    const T& Front() const;
+
+    bool Empty() const;
+    uint32_t Size() const;
+    uint32_t Capacity() const;
+
+    void Reserve(uint32_t capacity);
+    void Clear();
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    T* GetSlot(uint32_t index) const;
+
+private:
+    std::unique_ptr<Slot[]> m_pSlots;
+    uint32_t m_capacity;
+    uint32_t m_head;
+    uint32_t m_count;
+};
+
+template<typename T>
+RingBuffer<T>::RingBuffer() : m_capacity(0), m_head(0), m_count(0)
+{}
+
+template<typename T>
+RingBuffer<T>::~RingBuffer()
+{
+    Clear();
+}
+
+template<typename T>
+void RingBuffer<T>::Push(const T& value)
+{
+    if (m_count == m_capacity)
+        Reserve(m_capacity == 0 ? MIN_CAPACITY : m_capacity * 2);
+
+    new (GetSlot(m_head + m_count)) T(value);
+    m_count++;
+}
+
+template<typename T>
+void RingBuffer<T>::Push(T&& value)
+{
+    if (m_count == m_capacity)
+        Reserve(m_capacity == 0 ? MIN_CAPACITY : m_capacity * 2);
+
+    new (GetSlot(m_head + m_count)) T(std::move(value));
+    m_count++;
+}
+
+template<typename T>
+void RingBuffer<T>::Pop()
+{
+    GetSlot(m_head)->~T();
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_count--;
+}
+
+template<typename T>
+T& RingBuffer<T>::Front()
+{
+    return *GetSlot(m_head);
+}
+
+template<typename T>
+const T& RingBuffer<T>::Front() const
+{
+    return *GetSlot(m_head);
+}
+
+template<typename T>
+bool RingBuffer<T>::Empty() const
+{
+    return m_count == 0;
+}
+
+template<typename T>
+uint32_t RingBuffer<T>::Size() const
+{
+    return m_count;
+}
+
+template<typename T>
+uint32_t RingBuffer<T>::Capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T>
+void RingBuffer<T>::Reserve(uint32_t capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+
+    auto newCapacity = MIN_CAPACITY;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+
+    // Unwrapped on the way, the oldest element lands in slot 0.
+    std::unique_ptr<Slot[]> pSlots(new Slot[newCapacity]);
+    for (uint32_t i = 0; i < m_count; i++)
+    {
+        auto pValue = GetSlot(m_head + i);
+        new (&pSlots[i]) T(std::move(*pValue));
+        pValue->~T();
+    }
+
+    m_pSlots.swap(pSlots);
+    m_capacity = newCapacity;
+    m_head = 0;
+}
+
+template<typename T>
+void RingBuffer<T>::Clear()
+{
+    while (m_count > 0)
+        Pop();
+    m_head = 0;
+}
+
+template<typename T>
+T* RingBuffer<T>::GetSlot(uint32_t index) const
+{
+    return reinterpret_cast<T*>(&m_pSlots[index & (m_capacity - 1)]);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Hands whole values from one writer thread to one reader thread without either waiting.
+// The writer fills the back buffer and publishes it, the reader takes the newest published
+// buffer, a value published twice before the reader looks is simply replaced. Buffers are
+// reused, so values that own containers keep their capacity from frame to frame.
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : m_state(1), m_back(0), m_front(2) {}
+    TripleBuffer(const TripleBuffer& copy) = delete;
+    TripleBuffer& operator=(const TripleBuffer& copy) = delete;
+    virtual ~TripleBuffer() = default;
+
+    // Writer only.
+    T& GetBack()
+    {
+        return m_buffers[m_back];
+    }
+
+    // Writer only. Returns false when the previously published value was never acquired.
+    bool Publish()
+    {
+        auto state = m_state.exchange(m_back | DIRTY_BIT, std::memory_order_acq_rel);
+        m_back = state & INDEX_MASK;
+        return (state & DIRTY_BIT) == 0;
+    }
+
+    // Reader only. Swaps in the newest published value, false if nothing new was published.
+    bool Acquire()
+    {
+        if ((m_state.load(std::memory_order_relaxed) & DIRTY_BIT) == 0)
+            return false;
+
+        auto state = m_state.exchange(m_front, std::memory_order_acq_rel);
+        m_front = state & INDEX_MASK;
+        return true;
+    }
+
+    // Reader only, stays valid until the next Acquire.
+    T& GetFront()
+    {
+        return m_buffers[m_front];
+    }
+
+    const T& GetFront() const
+    {
+        return m_buffers[m_front];
+    }
+
+    bool HasPublished() const
+    {
+        return (m_state.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+    }
+
+private:
+    constexpr static uint32_t INDEX_MASK = 0x3;
+    constexpr static uint32_t DIRTY_BIT = 0x4;
+
+    T m_buffers[3];
+
+    // Index of the middle buffer, with DIRTY_BIT set while it holds an unread value.
+    std::atomic<uint32_t> m_state;
+
+    alignas(64) uint32_t m_back;
+    alignas(64) uint32_t m_front;
+};
\ No newline at end of file
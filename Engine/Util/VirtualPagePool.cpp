@@ -0,0 +1,131 @@
+#include <assert.h>
+
+#include "VirtualPagePool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+VirtualPagePool::VirtualPagePool(uint32_t pageSize, uint64_t reserveSize) :
+    m_pBase(nullptr),
+    m_pageSize(pageSize),
+    m_reservedSize(reserveSize / pageSize * pageSize),
+    m_committedSize(0),
+    m_allocatedSize(0),
+    m_usedPageCount(0)
+{
+    assert(COMMIT_SIZE % pageSize == 0);
+    m_pBase = static_cast<uint8_t*>(Reserve(m_reservedSize));
+    if (m_pBase == nullptr)
+        m_reservedSize = 0;
+}
+
+VirtualPagePool::~VirtualPagePool()
+{
+    if (m_pBase != nullptr)
+        Release(m_pBase, m_reservedSize);
+}
+
+void* VirtualPagePool::AllocatePage()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_pFreePages.empty())
+    {
+        auto pPage = m_pFreePages.back();
+        m_pFreePages.pop_back();
+        m_usedPageCount++;
+        return pPage;
+    }
+
+    if (m_allocatedSize + m_pageSize > m_reservedSize)
+        return nullptr;
+
+    if (m_allocatedSize + m_pageSize > m_committedSize)
+    {
+        auto size = m_reservedSize - m_committedSize;
+        if (size > COMMIT_SIZE)
+            size = COMMIT_SIZE;
+
+        if (!Commit(m_pBase + m_committedSize, size))
+            return nullptr;
+        m_committedSize += size;
+    }
+
+    auto pPage = m_pBase + m_allocatedSize;
+    m_allocatedSize += m_pageSize;
+    m_usedPageCount++;
+    return pPage;
+}
+
+void VirtualPagePool::FreePage(void* pPage)
+{
+    assert(IsOwned(pPage));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pFreePages.emplace_back(pPage);
+    m_usedPageCount--;
+}
+
+bool VirtualPagePool::IsOwned(const void* pPage) const
+{
+    auto pAddress = static_cast<const uint8_t*>(pPage);
+    return pAddress >= m_pBase && pAddress < m_pBase + m_reservedSize;
+}
+
+uint32_t VirtualPagePool::GetPageSize() const
+{
+    return m_pageSize;
+}
+
+uint64_t VirtualPagePool::GetReservedSize() const
+{
+    return m_reservedSize;
+}
+
+uint64_t VirtualPagePool::GetCommittedSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_committedSize;
+}
+
+uint64_t VirtualPagePool::GetUsedPageCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usedPageCount;
+}
+
+#ifdef _WIN32
+void* VirtualPagePool::Reserve(uint64_t size)
+{
+    return VirtualAlloc(nullptr, (SIZE_T)size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool VirtualPagePool::Commit(void* pAddress, uint64_t size)
+{
+    return VirtualAlloc(pAddress, (SIZE_T)size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void VirtualPagePool::Release(void* pAddress, uint64_t size)
+{
+    VirtualFree(pAddress, 0, MEM_RELEASE);
+}
+#else
+void* VirtualPagePool::Reserve(uint64_t size)
+{
+    auto pAddress = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return pAddress == MAP_FAILED ? nullptr : pAddress;
+}
+
+bool VirtualPagePool::Commit(void* pAddress, uint64_t size)
+{
+    return mprotect(pAddress, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void VirtualPagePool::Release(void* pAddress, uint64_t size)
+{
+    munmap(pAddress, size);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+// Hands out fixed-size pages from one reserved virtual address range. Memory is
+// committed in steps as the pool grows, so pages never move and growth never copies.
+class VirtualPagePool
+{
+public:
+    constexpr static uint64_t COMMIT_SIZE = 1024 * 1024;
+    constexpr static uint64_t DEFAULT_RESERVE_SIZE = sizeof(void*) == 8 ? (1ull << 36) : (256ull << 20);
+
+    VirtualPagePool(uint32_t pageSize, uint64_t reserveSize = DEFAULT_RESERVE_SIZE);
+    virtual ~VirtualPagePool();
+
+    // Returns nullptr once the reserved range is exhausted.
+    void* AllocatePage();
+    void FreePage(void* pPage);
+
+    bool IsOwned(const void* pPage) const;
+
+    uint32_t GetPageSize() const;
+    uint64_t GetReservedSize() const;
+    uint64_t GetCommittedSize() const;
+    uint64_t GetUsedPageCount() const;
+
+private:
+    static void* Reserve(uint64_t size);
+    static bool Commit(void* pAddress, uint64_t size);
+    static void Release(void* pAddress, uint64_t size);
+
+private:
+    uint8_t* m_pBase;
+    uint32_t m_pageSize;
+    uint64_t m_reservedSize;
+    uint64_t m_committedSize;
+    uint64_t m_allocatedSize;
+    uint64_t m_usedPageCount;
+
+    std::vector<void*> m_pFreePages;
+    mutable std::mutex m_mutex;
+};
\ No newline at end of file
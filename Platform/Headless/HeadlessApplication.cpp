@@ -0,0 +1,63 @@
+#include "AsyncLogger.h"
+#include "Global.h"
+#include "IInputSystem.h"
+#include "HeadlessApplication.h"
+
+using namespace Platform;
+using namespace Engine;
+
+void HeadlessApplication::Initialize()
+{
+    auto& headlessConfig = gpGlobal->GetConfiguration<HeadlessConfiguration>();
+    m_input = HeadlessInput(headlessConfig.GetInputSeed(), headlessConfig.GetInputEventsPerFrame());
+    m_frameIndex = 0;
+    m_frameCount = headlessConfig.GetFrameCount();
+    m_frameTime = headlessConfig.GetFrameTime();
+
+    gpGlobal->GetConfiguration<AppConfiguration>().SetAppHandle(nullptr);
+
+    BaseApplication::Initialize();
+}
+
+void HeadlessApplication::Shutdown()
+{
+    ReportFrameStats();
+
+    BaseApplication::Shutdown();
+}
+
+void HeadlessApplication::Tick(float elapsedTime)
+{
+    // A replay brings its own input and frame times.
+    auto pInputSystem = gpGlobal->Get<IInputSystem>();
+    bool bReplay = pInputSystem != nullptr && pInputSystem->IsReplaying();
+    if (!bReplay)
+        m_input.Generate(pInputSystem);
+
+    BaseApplication::Tick(m_frameTime > 0.0f && !bReplay ? m_frameTime : elapsedTime);
+
+    m_frameIndex++;
+    if (m_frameCount > 0 && m_frameIndex >= m_frameCount)
+        m_bQuit = true;
+}
+
+uint32_t HeadlessApplication::GetFrameIndex() const
+{
+    return m_frameIndex;
+}
+
+void HeadlessApplication::ReportFrameStats() const
+{
+    auto& frameStats = gpGlobal->GetFrameStats();
+    auto frameSummary = frameStats.GetFrameSummary();
+
+    LOG_INFO("Headless: {} frames, {} input events", m_frameIndex, m_input.GetEventCount());
+    LOG_INFO("Last {} frames ms avg: {}, p50: {}, p95: {}, p99: {}, max: {}", frameSummary.count, frameSummary.average, frameSummary.p50,
+             frameSummary.p95, frameSummary.p99, frameSummary.max);
+
+    for (uint32_t phase = 0; phase < frameStats.GetPhaseCount(); phase++)
+    {
+        auto summary = frameStats.GetPhaseSummary(phase);
+        LOG_INFO("    {} ms avg: {}, p99: {}, max: {}", frameStats.GetPhaseName(phase), summary.average, summary.p99, summary.max);
+    }
+}
\ No newline at end of file
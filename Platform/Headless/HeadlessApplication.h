@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+
+#include "HeadlessInput.h"
+#include "BaseApplication.h"
+
+namespace Platform
+{
+    // Runs the engine without a window or device, driven by synthetic input for a configured
+    // number of frames, and prints the frame statistics on shutdown.
+    class HeadlessApplication : public Engine::BaseApplication
+    {
+    public:
+        HeadlessApplication() : m_frameIndex(0), m_frameCount(0), m_frameTime(0.0f) {}
+        virtual ~HeadlessApplication() {}
+
+        void Initialize() override;
+        void Shutdown() override;
+
+        void Tick(float elapsedTime) override;
+
+        uint32_t GetFrameIndex() const;
+
+    private:
+        void ReportFrameStats() const;
+
+    protected:
+        HeadlessInput m_input;
+        uint32_t m_frameIndex;
+        uint32_t m_frameCount;
+        float m_frameTime;
+    };
+}
\ No newline at end of file
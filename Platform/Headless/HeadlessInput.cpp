@@ -0,0 +1,54 @@
+#include "Global.h"
+#include "HeadlessInput.h"
+
+using namespace Engine;
+using namespace Platform;
+
+HeadlessInput::HeadlessInput(uint32_t seed, uint32_t eventsPerFrame) :
+    m_state(seed != 0 ? seed : 1), m_eventsPerFrame(eventsPerFrame), m_eventCount(0), m_pressedKey(0)
+{
+}
+
+void HeadlessInput::Generate(IInputSystem* pInputSystem)
+{
+    if (pInputSystem == nullptr)
+        return;
+
+    auto width = gpGlobal->GetConfiguration<AppConfiguration>().GetWidth();
+    auto height = gpGlobal->GetConfiguration<AppConfiguration>().GetHeight();
+
+    // Key chars are left out, LogSystem takes some of them as commands.
+    for (uint32_t i = 0; i < m_eventsPerFrame; i++)
+    {
+        auto value = Next();
+        if (value % 4 != 0)
+        {
+            pInputSystem->DispatchInputEvent(eEv_Input_ControlMove, InputMsg(0, Next() % width, Next() % height));
+        }
+        else if (m_pressedKey == 0)
+        {
+            m_pressedKey = 'a' + (value >> 8) % 26;
+            pInputSystem->DispatchInputEvent(eEv_Input_KeyDown, InputMsg(0, m_pressedKey));
+        }
+        else
+        {
+            pInputSystem->DispatchInputEvent(eEv_Input_KeyUp, InputMsg(0, m_pressedKey));
+            m_pressedKey = 0;
+        }
+        m_eventCount++;
+    }
+}
+
+uint64_t HeadlessInput::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+uint32_t HeadlessInput::Next()
+{
+    // xorshift32
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+    return m_state;
+}
\ No newline at end of file
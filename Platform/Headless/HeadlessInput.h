@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "IInputSystem.h"
+
+namespace Platform
+{
+    // Stands in for a keyboard and pointer. The same seed always produces the same events,
+    // so load test runs stay comparable.
+    class HeadlessInput
+    {
+    public:
+        HeadlessInput(uint32_t seed = 1, uint32_t eventsPerFrame = 0);
+        virtual ~HeadlessInput() {}
+
+        // Queues one frame of events on the input system.
+        void Generate(Engine::IInputSystem* pInputSystem);
+
+        uint64_t GetEventCount() const;
+
+    private:
+        uint32_t Next();
+
+    private:
+        uint32_t m_state;
+        uint32_t m_eventsPerFrame;
+        uint64_t m_eventCount;
+
+        int64_t m_pressedKey;
+    };
+}
\ No newline at end of file
@@ -21,7 +21,7 @@ void WindowsInput::Tick(float elapsedTime)
 
 void WindowsInput::PeekWindowsInputMessage(UINT message, WPARAM wParam, LPARAM lParam)
 {
-    auto pInputSystem = gpGlobal->GetInputSystem();
+    auto pInputSystem = gpGlobal->Get<IInputSystem>();
     InputMsg msg;
     switch (message)
     {
@@ -0,0 +1,217 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <float.h>
+
+#include "Batch.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+static bool Near(float a, float b)
+{
+    return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b));
+}
+
+static bool Near(const float3& a, const float3& b)
+{
+    return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+}
+
+static bool Near(const float4x4& a, const float4x4& b)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (!Near(a[i][j], b[i][j]))
+                return false;
+    return true;
+}
+
+static float4 RandomRotation(std::mt19937& random)
+{
+    std::normal_distribution<float> value;
+    float4 q(value(random), value(random), value(random), value(random));
+    return Vec::Normalize(q);
+}
+
+// The one element at a time path the kernels replace.
+static float4x4 ComposeTRS(const float3& translation, const float4& rotation, const float3& scale)
+{
+    const float3x3 rotate = Mat::QuatRotateLH(rotation.x, rotation.y, rotation.z, rotation.w);
+    float4x4 scaleMatrix(scale.x, 0, 0, 0,
+                         0, scale.y, 0, 0,
+                         0, 0, scale.z, 0,
+                         0, 0, 0, 1);
+    float4x4 rotateMatrix(rotate[0][0], rotate[0][1], rotate[0][2], 0,
+                          rotate[1][0], rotate[1][1], rotate[1][2], 0,
+                          rotate[2][0], rotate[2][1], rotate[2][2], 0,
+                          0, 0, 0, 1);
+    float4x4 translateMatrix(1, 0, 0, 0,
+                             0, 1, 0, 0,
+                             0, 0, 1, 0,
+                             translation.x, translation.y, translation.z, 1);
+    return Mat::Mul(scaleMatrix, Mat::Mul(rotateMatrix, translateMatrix));
+}
+
+struct Data
+{
+    std::vector<float3> translations, scales;
+    std::vector<float4> rotations;
+    std::vector<float4x4> matrices;
+    Vec3SoA translationSoA, scaleSoA;
+    Vec4SoA rotationSoA;
+    Mat4SoA matrixSoA;
+
+    Data(size_t count, std::mt19937& random) : translations(count), scales(count), rotations(count), matrices(count),
+        translationSoA(count), scaleSoA(count), rotationSoA(count), matrixSoA(count)
+    {
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+        for (size_t i = 0; i < count; i++)
+        {
+            translations[i] = float3(position(random), position(random), position(random));
+            scales[i] = float3(scale(random), scale(random), scale(random));
+            rotations[i] = RandomRotation(random);
+            matrices[i] = ComposeTRS(translations[i], rotations[i], scales[i]);
+
+            translationSoA.Set(i, translations[i]);
+            scaleSoA.Set(i, scales[i]);
+            rotationSoA.Set(i, rotations[i]);
+            matrixSoA.Set(i, matrices[i]);
+        }
+    }
+};
+
+static void Verify(size_t count, std::mt19937& random)
+{
+    Data data(count, random);
+    float4x4 mat = data.matrices.empty() ? float4x4() : data.matrices[0];
+
+    Vec3SoA points;
+    Batch::TransformPoints(data.translationSoA, mat, points);
+    CHECK(points.Size() == count);
+    for (size_t i = 0; i < count; i++)
+        CHECK(Near(points.Get(i), Mat::TransformPoint(data.translations[i], mat)));
+
+    Mat4SoA composed;
+    Batch::ComposeTRS(data.translationSoA, data.rotationSoA, data.scaleSoA, composed);
+    CHECK(composed.Size() == count);
+    for (size_t i = 0; i < count; i++)
+        CHECK(Near(composed.Get(i), data.matrices[i]));
+
+    Mat4SoA product;
+    Batch::MulMatrices(data.matrixSoA, composed, product);
+    for (size_t i = 0; i < count; i++)
+        CHECK(Near(product.Get(i), Mat::Mul(data.matrices[i], data.matrices[i])));
+
+    // In place, the result is also the first input.
+    Batch::MulMatrices(composed, data.matrixSoA, composed);
+    for (size_t i = 0; i < count; i++)
+        CHECK(Near(composed.Get(i), product.Get(i)));
+
+    float3 min, max;
+    Batch::ComputeBounds(data.translationSoA, min, max);
+    float3 refMin(FLT_MAX, FLT_MAX, FLT_MAX), refMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (auto& point : data.translations)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            refMin[i] = std::min(refMin[i], point[i]);
+            refMax[i] = std::max(refMax[i], point[i]);
+        }
+    }
+    CHECK(min == refMin && max == refMax);
+}
+
+template<typename Func>
+static double Time(int passCount, Func func)
+{
+    auto beginTime = Clock::now();
+    for (int pass = 0; pass < passCount; pass++)
+        func();
+    ms elapsedTime = Clock::now() - beginTime;
+    return elapsedTime.count() / passCount;
+}
+
+int main()
+{
+    auto supportedLevel = Batch::GetSupportedLevel();
+    std::cout << "Supported: " << Batch::GetLevelName(supportedLevel) << std::endl;
+
+    // Every level against the scalar math, with counts that leave a tail for each width.
+    std::mt19937 random(3);
+    for (int level = Batch::eLevel_Scalar; level <= supportedLevel; level++)
+    {
+        Batch::SetLevel(static_cast<Batch::ELevel>(level));
+        CHECK(Batch::GetLevel() == level);
+        for (size_t count : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100, 1000 })
+            Verify(count, random);
+    }
+
+    Batch::SetLevel(Batch::eLevel_AVX512);
+    CHECK(Batch::GetLevel() == supportedLevel);
+
+    const size_t count = 100000;
+    const int passCount = 20;
+    Data data(count, random);
+    float4x4 mat = data.matrices[0];
+    float checksum = 0.0f;
+
+    std::vector<float3> points(count);
+    std::vector<float4x4> matrices(count);
+    float3 min, max;
+
+    double transformTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            points[i] = Mat::TransformPoint(data.translations[i], mat);
+    });
+    double mulTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            matrices[i] = Mat::Mul(data.matrices[i], data.matrices[i]);
+    });
+    double composeTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            matrices[i] = ComposeTRS(data.translations[i], data.rotations[i], data.scales[i]);
+    });
+    double boundsTime = Time(passCount, [&] {
+        min = float3(FLT_MAX, FLT_MAX, FLT_MAX);
+        max = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (auto& point : data.translations)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                min[i] = std::min(min[i], point[i]);
+                max[i] = std::max(max[i], point[i]);
+            }
+        }
+    });
+    checksum += points[count - 1].x + matrices[count - 1][3][3] + min.x + max.x;
+
+    std::cout << count << " elements, ms per pass" << std::endl;
+    std::cout << "Per element: TransformPoints " << transformTime << ", MulMatrices " << mulTime
+              << ", ComposeTRS " << composeTime << ", ComputeBounds " << boundsTime << std::endl;
+
+    Vec3SoA pointSoA(count);
+    Mat4SoA matrixSoA(count);
+    for (int level = Batch::eLevel_Scalar; level <= supportedLevel; level++)
+    {
+        Batch::SetLevel(static_cast<Batch::ELevel>(level));
+        double batchTransformTime = Time(passCount, [&] { Batch::TransformPoints(data.translationSoA, mat, pointSoA); });
+        double batchMulTime = Time(passCount, [&] { Batch::MulMatrices(data.matrixSoA, data.matrixSoA, matrixSoA); });
+        double batchComposeTime = Time(passCount, [&] { Batch::ComposeTRS(data.translationSoA, data.rotationSoA, data.scaleSoA, matrixSoA); });
+        double batchBoundsTime = Time(passCount, [&] { Batch::ComputeBounds(data.translationSoA, min, max); });
+        checksum += pointSoA[0][count - 1] + matrixSoA[15][count - 1] + min.x + max.x;
+
+        std::cout << Batch::GetLevelName(static_cast<Batch::ELevel>(level)) << ": TransformPoints " << batchTransformTime
+                  << ", MulMatrices " << batchMulTime << ", ComposeTRS " << batchComposeTime << ", ComputeBounds " << batchBoundsTime << std::endl;
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
\ No newline at end of file
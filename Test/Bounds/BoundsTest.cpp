@@ -0,0 +1,363 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <float.h>
+
+#include "Batch.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+static bool Near(float a, float b, float tolerance = 1e-3f)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0f, std::abs(b));
+}
+
+static bool Near(const AABB3& a, const AABB3& b)
+{
+    for (int i = 0; i < 3; i++)
+        if (!Near(a.mMin[i], b.mMin[i]) || !Near(a.mMax[i], b.mMax[i]))
+            return false;
+    return true;
+}
+
+// Clip space test of the matrix the frustum came from, depth 0 to w.
+static bool InsideClip(const float3& point, const float4x4& viewProj, float tolerance)
+{
+    float clip[4];
+    for (int i = 0; i < 4; i++)
+        clip[i] = point.x * viewProj[0][i] + point.y * viewProj[1][i] + point.z * viewProj[2][i] + viewProj[3][i];
+    float w = clip[3] + tolerance;
+    return clip[0] >= -w && clip[0] <= w && clip[1] >= -w && clip[1] <= w && clip[2] >= -tolerance && clip[2] <= w;
+}
+
+// The smallest plane distance the scalar test compares against 0, close to 0 the batch kernels
+// may round the other way.
+static float CullMargin(const Frustum& frustum, const AABB3& box)
+{
+    float margin = FLT_MAX;
+    for (auto& plane : frustum.mPlanes)
+    {
+        float3 extent = box.Extent();
+        float radius = std::abs(plane.mNormal.x) * extent.x + std::abs(plane.mNormal.y) * extent.y + std::abs(plane.mNormal.z) * extent.z;
+        margin = std::min(margin, plane.Distance(box.Center()) + radius);
+    }
+    return margin;
+}
+
+static float CullMargin(const Frustum& frustum, const Sphere& sphere)
+{
+    float margin = FLT_MAX;
+    for (auto& plane : frustum.mPlanes)
+        margin = std::min(margin, plane.Distance(sphere.mCenter) + sphere.mRadius);
+    return margin;
+}
+
+struct Scene
+{
+    std::mt19937& random;
+    std::uniform_real_distribution<float> position;
+    std::uniform_real_distribution<float> size;
+
+    Scene(std::mt19937& random) : random(random), position(-100.0f, 100.0f), size(0.0f, 10.0f)
+    {
+    }
+
+    float3 Point()
+    {
+        return float3(position(random), position(random), position(random));
+    }
+
+    // One in eight is a point and one in sixteen is empty, corners snap to whole numbers
+    // now and then so rays and planes land exactly on faces.
+    AABB3 Box()
+    {
+        uint32_t kind = random() % 16;
+        if (kind == 0)
+            return AABB3();
+
+        float3 min = Point();
+        if (kind < 4)
+            min = float3(std::floor(min.x), std::floor(min.y), std::floor(min.z));
+        if (kind < 3)
+            return AABB3(min, min);
+        return AABB3(min, min + float3(size(random), size(random), size(random)));
+    }
+
+    Sphere Ball()
+    {
+        return Sphere(Point(), random() % 8 == 0 ? 0.0f : size(random));
+    }
+
+    // Axis aligned and zero directions, and origins on whole numbers.
+    Ray Line()
+    {
+        std::normal_distribution<float> value;
+        float3 origin = random() % 4 == 0 ? float3(std::floor(position(random)), std::floor(position(random)), std::floor(position(random))) : Point();
+        float3 direction(value(random), value(random), value(random));
+        for (int i = 0; i < 3; i++)
+            if (random() % 3 == 0)
+                direction[i] = 0.0f;
+        return Ray(origin, direction);
+    }
+
+    float4x4 Camera()
+    {
+        std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+        float3 eye = Point();
+        float3 at = eye + float3(std::normal_distribution<float>()(random), 0.1f, 1.0f);
+        float4x4 view = Mat::LookAtLH(eye, at, float3(0.0f, 1.0f, 0.0f));
+        float4x4 proj = random() % 4 == 0 ? Mat::OrthoLH(100.0f, 60.0f, 0.1f, 200.0f) : Mat::PerspectiveFovLH(45.0f + angle(random) / 8, 16.0f / 9.0f, 0.1f, 200.0f);
+        return Mat::Mul(view, proj);
+    }
+};
+
+static void TestScalar(std::mt19937& random)
+{
+    Scene scene(random);
+
+    // Planes against the clip space of the matrix, away from the boundaries.
+    for (int i = 0; i < 100; i++)
+    {
+        float4x4 viewProj = scene.Camera();
+        Frustum frustum(viewProj);
+        for (int j = 0; j < 100; j++)
+        {
+            float3 point = scene.Point();
+            if (InsideClip(point, viewProj, -1e-2f))
+                CHECK(frustum.Contains(point));
+            else if (!InsideClip(point, viewProj, 1e-2f))
+                CHECK(!frustum.Contains(point));
+        }
+
+        // Conservative, every box or sphere with a point inside passes.
+        for (int j = 0; j < 100; j++)
+        {
+            AABB3 box = scene.Box();
+            if (box.IsEmpty())
+            {
+                CHECK(!frustum.Intersects(box));
+                continue;
+            }
+            for (int k = 0; k < 8; k++)
+            {
+                float3 corner(k & 1 ? box.mMax.x : box.mMin.x, k & 2 ? box.mMax.y : box.mMin.y, k & 4 ? box.mMax.z : box.mMin.z);
+                if (frustum.Contains(corner))
+                    CHECK(frustum.Intersects(box) && frustum.Intersects(Sphere::FromAABB(box)));
+            }
+        }
+    }
+
+    // A zero matrix gives zero planes, nothing is rejected.
+    Frustum zero(float4x4(0.0f));
+    CHECK(zero.Contains(scene.Point()) && zero.Intersects(scene.Box()) && zero.Intersects(scene.Ball()));
+
+    // Transformed boxes hold every transformed corner, mirrored and flattened too.
+    for (int i = 0; i < 1000; i++)
+    {
+        AABB3 box = scene.Box();
+        float4x4 mat = Mat::Mul(float4x4(i % 3 == 0 ? -1.0f : 1.0f, 0, 0, 0, 0, i % 5 == 0 ? 0.0f : 2.0f, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1), scene.Camera());
+        AABB3 result = box.Transform(mat);
+        if (box.IsEmpty())
+        {
+            CHECK(result.IsEmpty());
+            continue;
+        }
+
+        AABB3 corners;
+        for (int k = 0; k < 8; k++)
+            corners.Expand(Mat::TransformPoint(float3(k & 1 ? box.mMax.x : box.mMin.x, k & 2 ? box.mMax.y : box.mMin.y, k & 4 ? box.mMax.z : box.mMin.z), mat));
+        CHECK(Near(result, corners));
+    }
+
+    // A ray aimed at a point of a box hits it, and hit points lie on the box.
+    for (int i = 0; i < 1000; i++)
+    {
+        AABB3 box = scene.Box();
+        Ray ray = scene.Line();
+        float distance = -1.0f;
+        if (box.IsEmpty())
+        {
+            CHECK(!ray.Intersects(box, distance));
+            continue;
+        }
+
+        if (ray.Intersects(box, distance))
+        {
+            AABB3 expanded(box.mMin - float3(1e-2f), box.mMax + float3(1e-2f));
+            CHECK(distance >= 0.0f && expanded.Contains(ray.GetPoint(distance)));
+        }
+
+        // A point box is only hit when the rounding happens to agree.
+        if (box.mMin != box.mMax)
+            CHECK(Ray(ray.mOrigin, box.Center() - ray.mOrigin).Intersects(box, distance) && distance <= 1.0f);
+        if (ray.mDirection == float3(0.0f))
+            CHECK(ray.Intersects(box, distance) == box.Contains(ray.mOrigin));
+
+        Sphere sphere = scene.Ball();
+        CHECK(Ray(ray.mOrigin, sphere.mCenter - ray.mOrigin).Intersects(sphere, distance) && distance <= 1.0f + 1e-4f);
+        if (ray.Intersects(sphere, distance))
+            CHECK(Vec::Length(ray.GetPoint(distance) - sphere.mCenter) <= sphere.mRadius * (1.0f + 1e-3f) + 1e-3f);
+    }
+
+    // Touching counts, a point box on a face, a ray along a face.
+    AABB3 unit(float3(0.0f), float3(1.0f));
+    float distance;
+    CHECK(unit.Intersects(AABB3(float3(1.0f, 0.5f, 0.5f), float3(1.0f, 0.5f, 0.5f))));
+    CHECK(Ray(float3(-1.0f, 1.0f, 0.5f), float3(1.0f, 0.0f, 0.0f)).Intersects(unit, distance) && distance == 1.0f);
+    CHECK(!Ray(float3(-1.0f, 1.5f, 0.5f), float3(1.0f, 0.0f, 0.0f)).Intersects(unit, distance));
+    CHECK(!Ray(float3(2.0f, 0.5f, 0.5f), float3(1.0f, 0.0f, 0.0f)).Intersects(unit, distance));
+    CHECK(Sphere(float3(2.0f, 0.5f, 0.5f), 1.0f).Intersects(unit) && !Sphere(float3(2.0f, 2.0f, 0.5f), 1.0f).Intersects(unit));
+    CHECK(Plane::FromPoints(float3(0.0f), float3(0.0f, 0.0f, 1.0f), float3(1.0f, 0.0f, 0.0f)).Distance(float3(0.0f, 2.0f, 0.0f)) == 2.0f);
+}
+
+// Every level against the scalar classes, with counts that leave a tail for each width.
+static void TestBatch(std::mt19937& random)
+{
+    Scene scene(random);
+    for (size_t count : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100, 1000 })
+    {
+        std::vector<AABB3> boxes(count);
+        std::vector<Sphere> spheres(count);
+        AABB3SoA boxSoA(count);
+        SphereSoA sphereSoA(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            boxes[i] = scene.Box();
+            spheres[i] = scene.Ball();
+            boxSoA.Set(i, boxes[i]);
+            sphereSoA.Set(i, spheres[i]);
+        }
+
+        float4x4 viewProj = scene.Camera();
+        Frustum frustum(viewProj);
+        Ray ray = scene.Line();
+
+        AABB3SoA transformed;
+        std::vector<uint8_t> visible, hit;
+
+        Batch::TransformAABBs(boxSoA, viewProj, transformed);
+        CHECK(transformed.Size() == count);
+        for (size_t i = 0; i < count; i++)
+        {
+            AABB3 ref = boxes[i].Transform(viewProj);
+            CHECK(boxes[i].IsEmpty() ? transformed.Get(i).IsEmpty() : Near(transformed.Get(i), ref));
+        }
+
+        Batch::CullAABBs(frustum, boxSoA, visible);
+        CHECK(visible.size() == count);
+        for (size_t i = 0; i < count; i++)
+            CHECK((visible[i] != 0) == frustum.Intersects(boxes[i]) || std::abs(CullMargin(frustum, boxes[i])) < 1e-3f);
+
+        Batch::CullSpheres(frustum, sphereSoA, visible);
+        CHECK(visible.size() == count);
+        for (size_t i = 0; i < count; i++)
+            CHECK((visible[i] != 0) == frustum.Intersects(spheres[i]) || std::abs(CullMargin(frustum, spheres[i])) < 1e-3f);
+
+        // The same operations in the same order, so the same answer even on the faces.
+        Batch::IntersectRay(ray, boxSoA, hit);
+        CHECK(hit.size() == count);
+        float distance;
+        for (size_t i = 0; i < count; i++)
+            CHECK((hit[i] != 0) == ray.Intersects(boxes[i], distance));
+
+        // In place.
+        Batch::TransformAABBs(boxSoA, viewProj, boxSoA);
+        for (size_t i = 0; i < count; i++)
+            CHECK(boxSoA.Get(i).IsEmpty() == transformed.Get(i).IsEmpty() && (boxSoA.Get(i).IsEmpty() || Near(boxSoA.Get(i), transformed.Get(i))));
+    }
+}
+
+template<typename Func>
+static double Time(int passCount, Func func)
+{
+    auto beginTime = Clock::now();
+    for (int pass = 0; pass < passCount; pass++)
+        func();
+    ms elapsedTime = Clock::now() - beginTime;
+    return elapsedTime.count() / passCount;
+}
+
+int main()
+{
+    std::mt19937 random(7);
+    TestScalar(random);
+
+    auto supportedLevel = Batch::GetSupportedLevel();
+    for (int level = Batch::eLevel_Scalar; level <= supportedLevel; level++)
+    {
+        Batch::SetLevel(static_cast<Batch::ELevel>(level));
+        for (int pass = 0; pass < 20; pass++)
+            TestBatch(random);
+    }
+
+    const size_t count = 100000;
+    const int passCount = 20;
+    Scene scene(random);
+    std::vector<AABB3> boxes(count), transformed(count);
+    std::vector<Sphere> spheres(count);
+    AABB3SoA boxSoA(count), transformedSoA(count);
+    SphereSoA sphereSoA(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        boxes[i] = scene.Box();
+        spheres[i] = scene.Ball();
+        boxSoA.Set(i, boxes[i]);
+        sphereSoA.Set(i, spheres[i]);
+    }
+
+    float4x4 viewProj = scene.Camera();
+    Frustum frustum(viewProj);
+    Ray ray = scene.Line();
+    std::vector<uint8_t> visible(count);
+    float checksum = 0.0f;
+    float distance;
+
+    double transformTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            transformed[i] = boxes[i].Transform(viewProj);
+    });
+    double cullTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            visible[i] = frustum.Intersects(boxes[i]);
+    });
+    checksum += visible[count - 1];
+    double sphereTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            visible[i] = frustum.Intersects(spheres[i]);
+    });
+    checksum += visible[count - 1];
+    double rayTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            visible[i] = ray.Intersects(boxes[i], distance);
+    });
+    checksum += visible[count - 1] + transformed[count - 1].mMin.x;
+
+    std::cout << count << " elements, ms per pass" << std::endl;
+    std::cout << "Per element: TransformAABBs " << transformTime << ", CullAABBs " << cullTime
+              << ", CullSpheres " << sphereTime << ", IntersectRay " << rayTime << std::endl;
+
+    for (int level = Batch::eLevel_Scalar; level <= supportedLevel; level++)
+    {
+        Batch::SetLevel(static_cast<Batch::ELevel>(level));
+        double batchTransformTime = Time(passCount, [&] { Batch::TransformAABBs(boxSoA, viewProj, transformedSoA); });
+        double batchCullTime = Time(passCount, [&] { Batch::CullAABBs(frustum, boxSoA, visible); });
+        checksum += visible[count - 1];
+        double batchSphereTime = Time(passCount, [&] { Batch::CullSpheres(frustum, sphereSoA, visible); });
+        checksum += visible[count - 1];
+        double batchRayTime = Time(passCount, [&] { Batch::IntersectRay(ray, boxSoA, visible); });
+        checksum += visible[count - 1] + transformedSoA[0][count - 1];
+
+        std::cout << Batch::GetLevelName(static_cast<Batch::ELevel>(level)) << ": TransformAABBs " << batchTransformTime
+                  << ", CullAABBs " << batchCullTime << ", CullSpheres " << batchSphereTime << ", IntersectRay " << batchRayTime << std::endl;
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
\ No newline at end of file
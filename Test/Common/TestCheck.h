@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+inline void CheckFailed(const char* file, int line, const char* condition)
+{
+    std::cerr << file << ":" << line << ": " << condition << std::endl;
+    std::exit(1);
+}
+
+// Unlike assert, still checked in release builds, where the timings the tests print are meaningful.
+#define CHECK(condition) do { if (!(condition)) CheckFailed(__FILE__, __LINE__, #condition); } while (0)
\ No newline at end of file
@@ -0,0 +1,311 @@
+#define PREDEFINE_SETUP
+
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "Setup.h"
+#include "Component.h"
+#include "ECSQuery.h"
+#include "ECSSystem.h"
+#include "ECSScheduler.h"
+#include "EntityCommandBuffer.h"
+#include "TransformHierarchy.h"
+#include "VirtualPagePool.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+class ValueComponent : public ComponentBase<ValueComponent>
+{
+public:
+    ValueComponent() : ComponentBase<ValueComponent>() {}
+    ValueComponent(int value) : ComponentBase<ValueComponent>(), m_value(value) {}
+    virtual ~ValueComponent() = default;
+
+    int m_value = 0;
+    std::string m_name = "value";
+};
+
+class SharedComponent : public ComponentBase<SharedComponent>
+{
+public:
+    SharedComponent() : ComponentBase<SharedComponent>() {}
+    virtual ~SharedComponent() = default;
+
+    std::shared_ptr<int> m_pData = std::make_shared<int>(42);
+};
+
+// A single row is larger than a chunk page.
+class LargeComponent : public ComponentBase<LargeComponent>
+{
+public:
+    LargeComponent() : ComponentBase<LargeComponent>() {}
+    virtual ~LargeComponent() = default;
+
+    uint8_t m_data[ECSArchetype::CHUNK_SIZE + 1] = {};
+};
+
+template<uint32_t N>
+class CountComponent : public ComponentBase<CountComponent<N>>
+{
+};
+
+template<uint32_t... N>
+static void RegisterCountComponents(std::integer_sequence<uint32_t, N...>)
+{
+    (CountComponent<N>::GetCompID(), ...);
+}
+
+template<typename... ReqComps>
+class TestSystem : public ECSSystemBase<ReqComps...>
+{
+public:
+    void Initialize() override {}
+    void Shutdown() override {}
+    void Tick(float) override {}
+    void FlushEntity(Entity) override {}
+    const char* GetName() const override { return "TestSystem"; }
+};
+
+int main()
+{
+    if (gpGlobal == nullptr)
+        gpGlobal = new Global();
+
+    gpGlobal->RegisterApp<BaseApplication>();
+    auto pWorld = gpGlobal->GetECSWorld();
+
+    const int count = 10000;
+    std::vector<Entity> entities;
+    for (int i = 0; i < count; i++)
+        entities.emplace_back(pWorld->CreateEntity<ValueComponent>(ValueComponent(i)));
+
+    for (int i = 0; i < count; i += 2)
+        pWorld->AttachComponent<SharedComponent>(entities[i], SharedComponent());
+
+    for (int i = 0; i < count; i += 4)
+        pWorld->DetachComponent<ValueComponent>(entities[i]);
+
+    for (int i = 0; i < count; i++)
+    {
+        auto pValue = pWorld->GetComponent<ValueComponent>(entities[i]);
+        auto pShared = pWorld->GetComponent<SharedComponent>(entities[i]);
+
+        CHECK((pValue != nullptr) == (i % 4 != 0));
+        CHECK((pShared != nullptr) == (i % 2 == 0));
+        CHECK(pValue == nullptr || (pValue->m_value == i && pValue->m_name == "value"));
+        CHECK(pShared == nullptr || *pShared->m_pData == 42);
+    }
+
+    auto query = pWorld->Query<ValueComponent, SharedComponent>();
+    CHECK(query.GetEntityCount() == count / 4);
+
+    int visited = 0;
+    query.ForEachEntity([&](Entity entity, ValueComponent& value, SharedComponent&) {
+        CHECK(pWorld->GetComponent<ValueComponent>(entity) == &value);
+        CHECK(value.m_entity == entity);
+        CHECK(value.m_value % 4 == 2);
+        visited++;
+    });
+    CHECK(visited == count / 4);
+
+    for (int i = 0; i < count; i += 4)
+        pWorld->AttachComponent<ValueComponent>(entities[i], ValueComponent(i));
+    CHECK(query.GetEntityCount() == count / 2);
+
+    // A thread keeps one buffer per world, switching between worlds reuses them.
+    ECSWorld otherWorld;
+    auto pBuffer = pWorld->GetCommandBuffer();
+    auto pOtherBuffer = otherWorld.GetCommandBuffer();
+    CHECK(pBuffer != pOtherBuffer);
+    CHECK(pWorld->GetCommandBuffer() == pBuffer && otherWorld.GetCommandBuffer() == pOtherBuffer);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        pBuffer->SetSortKey(i);
+        pBuffer->DestroyEntity(entities[i]);
+
+        auto spawned = pBuffer->CreateEntity<ValueComponent>(ValueComponent(count + i));
+        pBuffer->AttachComponent<SharedComponent>(spawned, SharedComponent());
+    }
+    CHECK(pWorld->IsAlive(entities[0]));
+
+    pWorld->Tick(0.0f);
+    CHECK(!pWorld->IsAlive(entities[0]) && pWorld->GetComponent<ValueComponent>(entities[0]) == nullptr);
+    CHECK(query.GetEntityCount() == count / 2);
+
+    auto spawned = pWorld->CreateEntities<ValueComponent>(count, ValueComponent(-1));
+    for (auto entity : spawned)
+        CHECK(pWorld->GetComponent<ValueComponent>(entity)->m_value == -1);
+
+    for (auto entity : spawned)
+        pWorld->DestroyEntity(entity);
+
+    // Destroyed slots are recycled, the old handles stay dead.
+    auto recycled = pWorld->CreateEntities<ValueComponent>(count, ValueComponent(-2));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        CHECK(!pWorld->IsAlive(spawned[i]));
+        CHECK(recycled[i].index < spawned.back().index + 1);
+    }
+
+    // Chunks of destroyed rows go back to the page pool and are handed out again.
+    auto& pagePool = ECSChunk::GetPagePool();
+    auto committedSize = pagePool.GetCommittedSize();
+    for (auto entity : recycled)
+        pWorld->DestroyEntity(entity);
+    recycled = pWorld->CreateEntities<ValueComponent>(count, ValueComponent(-3));
+    CHECK(pagePool.GetCommittedSize() == committedSize);
+
+    // Writes through a non-const query stamp only the columns it hands out.
+    auto since = IECSWorld::AdvanceGlobalVersion();
+    auto valueQuery = pWorld->Query<const ValueComponent>();
+    CHECK(!valueQuery.HasChanged(since));
+
+    pWorld->Query<const ValueComponent, SharedComponent>().ForEach([](const ValueComponent&, SharedComponent&) {});
+    CHECK(!valueQuery.HasChanged(since));
+
+    pWorld->Query<ValueComponent>().ForEach([](ValueComponent&) {});
+    CHECK(valueQuery.HasChanged(since));
+
+    // Reading through a const component leaves the chunk alone, parallel readers never write.
+    since = IECSWorld::AdvanceGlobalVersion();
+    CHECK(pWorld->GetComponent<const ValueComponent>(recycled[0])->m_value == -3);
+    CHECK(!valueQuery.HasChanged(since));
+
+    pWorld->GetComponent<ValueComponent>(recycled[0])->MarkChanged();
+    CHECK(pWorld->GetComponent<const ValueComponent>(recycled[0])->IsChangedSince(since));
+    CHECK(!pWorld->GetComponent<const ValueComponent>(recycled[1])->IsChangedSince(since));
+
+    visited = 0;
+    valueQuery.ForEachChanged(since, [&](const ValueComponent&) {
+        visited++;
+    });
+    CHECK(visited > 0 && visited < (int)valueQuery.GetEntityCount());
+
+    TestSystem<const ValueComponent> valueReader;
+    TestSystem<const ValueComponent, SharedComponent> sharedWriter;
+    TestSystem<ValueComponent> valueWriter;
+    TestSystem<> exclusive;
+    CHECK(!ECSScheduler::IsConflict(&valueReader, &sharedWriter));
+    CHECK(ECSScheduler::IsConflict(&valueReader, &valueWriter));
+    CHECK(ECSScheduler::IsConflict(&sharedWriter, &valueWriter));
+    CHECK(ECSScheduler::IsConflict(&valueReader, &exclusive));
+
+    // Translations along x add up along the parent chain, so each world x tells where a node hangs.
+    TransformHierarchy hierarchy;
+    auto translate = [](float x) { return float4x4(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, x, 0, 0, 1); };
+    auto worldX = [&](Entity entity) { return hierarchy.GetWorldMatrix(entity)->x30; };
+    auto nodes = pWorld->CreateEntities<ValueComponent>(4, ValueComponent(0));
+    Entity a = nodes[0], b = nodes[1], c = nodes[2], d = nodes[3];
+
+    // Children may come before their parents, the sort puts parents first.
+    hierarchy.SetNode(c, b, translate(100));
+    hierarchy.SetNode(b, a, translate(10));
+    hierarchy.SetNode(a, INVALID_ENTITY, translate(1));
+    hierarchy.SetNode(d, INVALID_ENTITY, translate(1000));
+    hierarchy.Update();
+    CHECK(hierarchy.GetNodeCount() == 4);
+    CHECK(worldX(a) == 1 && worldX(b) == 11 && worldX(c) == 111 && worldX(d) == 1000);
+
+    auto order = [&](Entity entity) {
+        auto pNodes = hierarchy.GetEntities();
+        return std::find(pNodes, pNodes + hierarchy.GetNodeCount(), entity) - pNodes;
+    };
+    CHECK(order(a) < order(b) && order(b) < order(c));
+
+    // A dirty parent recomputes its subtree and nothing else.
+    hierarchy.SetNode(b, a, translate(20));
+    hierarchy.Update();
+    CHECK(hierarchy.GetMovedNodeCount() == 2);
+    CHECK(worldX(b) == 21 && worldX(c) == 121 && worldX(d) == 1000);
+    hierarchy.Interpolate(0.5f);
+    CHECK(hierarchy.GetInterpolatedMatrix(c)->x30 == 116);
+
+    hierarchy.Update();
+    CHECK(hierarchy.GetMovedNodeCount() == 0);
+
+    // Reparenting moves the whole subtree.
+    hierarchy.SetNode(b, d, translate(20));
+    hierarchy.Update();
+    CHECK(worldX(b) == 1020 && worldX(c) == 1120);
+    CHECK(order(d) < order(b));
+
+    // d under c closes the loop d, b, c. One link is dropped, so one of them becomes a root
+    // and the other two still hang off it.
+    hierarchy.SetNode(d, c, translate(1000));
+    hierarchy.Update();
+    CHECK(hierarchy.GetNodeCount() == 4);
+    bool bRootD = worldX(d) == 1000 && worldX(b) == 1020 && worldX(c) == 1120;
+    bool bRootB = worldX(b) == 20 && worldX(c) == 120 && worldX(d) == 1120;
+    bool bRootC = worldX(c) == 100 && worldX(d) == 1100 && worldX(b) == 1120;
+    CHECK(bRootD || bRootB || bRootC);
+
+    // Removing a parent makes its children roots.
+    hierarchy.SetNode(d, INVALID_ENTITY, translate(1000));
+    hierarchy.SetNode(b, a, translate(20));
+    hierarchy.Update();
+    CHECK(worldX(b) == 21 && worldX(c) == 121);
+
+    hierarchy.RemoveNode(a);
+    hierarchy.Update();
+    CHECK(!hierarchy.HasNode(a) && hierarchy.GetWorldMatrix(a) == nullptr);
+    CHECK(hierarchy.GetNodeCount() == 3);
+    CHECK(worldX(b) == 20 && worldX(c) == 120);
+
+    // A recycled index is a different entity, children of the old handle stay roots.
+    pWorld->DestroyEntity(a);
+    auto reused = pWorld->CreateEntity<ValueComponent>(ValueComponent(0));
+    CHECK(reused.index == a.index && reused != a);
+    hierarchy.SetNode(reused, INVALID_ENTITY, translate(5));
+    hierarchy.Update();
+    CHECK(hierarchy.HasNode(reused) && !hierarchy.HasNode(a));
+    CHECK(worldX(reused) == 5 && worldX(b) == 20 && worldX(c) == 120);
+
+    // Oversized rows still get one per chunk.
+    auto large = pWorld->CreateEntities<LargeComponent>(3, LargeComponent());
+    for (uint32_t i = 0; i < large.size(); i++)
+    {
+        auto pLarge = pWorld->GetComponent<LargeComponent>(large[i]);
+        pLarge->m_data[0] = (uint8_t)i;
+        pLarge->m_data[ECSArchetype::CHUNK_SIZE] = (uint8_t)i;
+    }
+    pWorld->DestroyEntity(large[0]);
+    for (uint32_t i = 1; i < large.size(); i++)
+    {
+        auto pLarge = pWorld->GetComponent<LargeComponent>(large[i]);
+        CHECK(pLarge->m_data[0] == i && pLarge->m_data[ECSArchetype::CHUNK_SIZE] == i);
+    }
+    uint32_t largeChunks = 0;
+    pWorld->Query<LargeComponent>().ForEachChunk([&](uint32_t count, Entity*, LargeComponent*) {
+        CHECK(count == 1);
+        largeChunks++;
+    });
+    CHECK(largeChunks == 2);
+
+    for (auto& pArchetype : pWorld->GetArchetypes())
+    {
+        std::cout << "Archetype " << pArchetype->GetBitset() << ": "
+                  << pArchetype->GetEntityCount() << " entities, "
+                  << pArchetype->GetCapacity() << " per chunk, "
+                  << pArchetype->GetChunkCount() << " chunks" << std::endl;
+    }
+
+    // Past the bits of CompBitset registration fails loudly instead of reusing a bit.
+    bool bThrown = false;
+    try
+    {
+        RegisterCountComponents(std::make_integer_sequence<uint32_t, ECSArchetype::MAX_COMPONENTS>());
+    }
+    catch (const std::runtime_error&)
+    {
+        bThrown = true;
+    }
+    CHECK(bThrown);
+
+    return 0;
+}
\ No newline at end of file
@@ -1,10 +1,15 @@
+#include <atomic>
 #include <string>
 #include <memory>
 #include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "Global.h"
 #include "IEventSystem.h"
 #include "EventSystem.h"
+#include "TestCheck.h"
 
 using namespace Engine;
 
@@ -12,7 +17,11 @@ enum ETestEvent
 {
     eTestEvent_1 = 1,
     eTestEvent_2 = 2,
-    eTestEvent_3 = 3
+    eTestEvent_3 = 3,
+    eTestEvent_4 = 4,
+    eTestEvent_5 = 5,
+    eTestEvent_6 = 6,
+    eTestEvent_7 = 7
 };
 
 struct EventData
@@ -28,6 +37,17 @@ struct EventData
     }
 };
 
+// Only there to use up event type IDs.
+enum ECountEvent : uint32_t
+{
+};
+
+template<uint32_t... N>
+static void RegisterCountEvents(std::integer_sequence<uint32_t, N...>)
+{
+    (Event<int, ECountEvent, (ECountEvent)N>::GetID(), ...);
+}
+
 int main()
 {
     if (gpGlobal == nullptr)
@@ -37,14 +57,14 @@ int main()
 
     DECLARE_LISTENER();
     {
-        LISTEN_EVENT(eTestEvent_1, [&](std::shared_ptr<Event<std::string, ETestEvent, eTestEvent_1>> data){
-            std::cout << "Listen 1: " << data->GetMsg() << std::endl;
+        LISTEN_EVENT(eTestEvent_1, [&](const Event<std::string, ETestEvent, eTestEvent_1>& data){
+            std::cout << "Listen 1: " << data.GetMsg() << std::endl;
         });
-        LISTEN_EVENT(eTestEvent_2, [&](std::shared_ptr<Event<EventData, ETestEvent, eTestEvent_2>> data){
-            std::cout << "Listen 2: " << data->GetMsg() << std::endl;
+        LISTEN_EVENT(eTestEvent_2, [&](const Event<EventData, ETestEvent, eTestEvent_2>& data){
+            std::cout << "Listen 2: " << data.GetMsg() << std::endl;
         });
-        LISTEN_EVENT(eTestEvent_3, [&](std::shared_ptr<Event<EventData, ETestEvent, eTestEvent_3>> data){
-            std::cout << "Listen 3: " << data->GetMsg() << std::endl;
+        LISTEN_EVENT(eTestEvent_3, [&](const Event<EventData, ETestEvent, eTestEvent_3>& data){
+            std::cout << "Listen 3: " << data.GetMsg() << std::endl;
         });
     }
 
@@ -68,5 +88,165 @@ int main()
 
     gpGlobal->GetEventSystem()->ProcessEvents();
 
+    // Workers post through the lock-free mailboxes, delivery still happens on this thread
+    // and on the thread draining the worker context.
+    const int producerCount = 4;
+    const int eventCount = 10000;
+    const EventContext workerContext = 1;
+
+    int received = 0;
+    std::atomic<int> receivedOnWorker(0);
+    typedef Event<int, ETestEvent, eTestEvent_4> CompletionEvent;
+    {
+        LISTEN_EVENT(eTestEvent_4, [&](const CompletionEvent& ){
+            received++;
+        });
+        LISTEN_EVENT_ON(eTestEvent_4, workerContext, [&](const CompletionEvent& ){
+            receivedOnWorker++;
+        });
+    }
+
+    std::atomic<bool> bDone(false);
+    std::thread worker([&](){
+        while (!bDone)
+            gpGlobal->GetEventSystem()->ProcessEvents(workerContext);
+        gpGlobal->GetEventSystem()->ProcessEvents(workerContext);
+    });
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producerCount; i++)
+    {
+        producers.emplace_back([&](){
+            for (int j = 0; j < eventCount; j++)
+            {
+                DECLARE_EVENT(eTestEvent_4, Completion_Ev, j);
+                EMITTER_EVENT(Completion_Ev);
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+    gpGlobal->GetEventSystem()->ProcessEvents();
+
+    bDone = true;
+    worker.join();
+
+    CHECK(received == producerCount * eventCount);
+    CHECK(receivedOnWorker == producerCount * eventCount);
+
+    auto stats = gpGlobal->GetEventSystem()->GetEventStats<CompletionEvent>();
+    std::cout << "Completion events: " << stats.pushedCount << " pushed, "
+              << stats.overflowCount << " overflowed, "
+              << stats.peakCount << " peak" << std::endl;
+
+    // Immediate events skip the queue, prioritized channels deliver highest first and the
+    // time slice carries what does not fit into the next tick.
+    std::vector<int> order;
+    typedef Event<int, ETestEvent, eTestEvent_5> GameplayEvent;
+    {
+        LISTEN_EVENT(eTestEvent_5, [&](const GameplayEvent& data){
+            order.push_back(data.GetMsg());
+        });
+    }
+
+    auto pEventSystem = gpGlobal->GetEventSystem();
+    pEventSystem->SetTimeSliceBudget(0);
+    for (int priority : { 1, 5, 3 })
+    {
+        DECLARE_EVENT(eTestEvent_5, Sliced_Ev, priority);
+        EMITTER_EVENT_TO(Sliced_Ev, eEventChannel_TimeSliced, priority);
+    }
+
+    DECLARE_EVENT(eTestEvent_5, Immediate_Ev, 100);
+    EMITTER_EVENT_TO(Immediate_Ev, eEventChannel_Immediate, 0);
+    CHECK(order.size() == 1 && order[0] == 100);
+
+    pEventSystem->ProcessEvents();
+    CHECK(order.size() == 2 && order[1] == 5);
+    CHECK(pEventSystem->GetPendingCount(eEventChannel_TimeSliced) == 2);
+
+    for (int priority : { 2, 7 })
+    {
+        DECLARE_EVENT(eTestEvent_5, EndOfFrame_Ev, 10 + priority);
+        EMITTER_EVENT_TO(EndOfFrame_Ev, eEventChannel_EndOfFrame, priority);
+    }
+    pEventSystem->ProcessEndOfFrame();
+    CHECK(order.size() == 4 && order[2] == 17 && order[3] == 12);
+
+    pEventSystem->SetTimeSliceBudget(IEventSystem::DEFAULT_TIME_SLICE_BUDGET);
+    pEventSystem->ProcessEvents();
+    CHECK(order.size() == 6 && order[4] == 3 && order[5] == 1);
+
+    // Subscriptions removed from inside a dispatch, including the running one, stop
+    // receiving right away and their handles go stale.
+    typedef Event<int, ETestEvent, eTestEvent_6> RemovalEvent;
+    int calls[3] = { 0, 0, 0 };
+    EventSubscription subscriptions[3];
+    subscriptions[0] = listener.OnEvent<RemovalEvent>([&](const RemovalEvent& ){
+        calls[0]++;
+        bool bRemovedSelf = listener.Remove(subscriptions[0]);
+        bool bRemovedOther = listener.Remove(subscriptions[2]);
+        CHECK(bRemovedSelf && bRemovedOther);
+    });
+    subscriptions[1] = listener.OnEvent<RemovalEvent>([&](const RemovalEvent& ){
+        calls[1]++;
+    });
+    subscriptions[2] = listener.OnEvent<RemovalEvent>([&](const RemovalEvent& ){
+        calls[2]++;
+    });
+
+    for (int i = 0; i < 2; i++)
+    {
+        DECLARE_EVENT(eTestEvent_6, Removal_Ev, i);
+        EMITTER_EVENT_TO(Removal_Ev, eEventChannel_Immediate, 0);
+    }
+    CHECK(calls[0] == 1 && calls[1] == 2 && calls[2] == 0);
+    bool bRemoved = pEventSystem->RemoveListener(subscriptions[0]);
+    CHECK(!bRemoved);
+
+    auto recycled = listener.OnEvent<RemovalEvent>([&](const RemovalEvent& ){});
+    CHECK(recycled.slot == subscriptions[2].slot && recycled != subscriptions[2]);
+    bRemoved = pEventSystem->RemoveListener(subscriptions[2]);
+    CHECK(!bRemoved);
+    bRemoved = listener.Remove(recycled);
+    CHECK(bRemoved);
+
+    // The same from a worker context, its listeners run without the listener lock held.
+    typedef Event<int, ETestEvent, eTestEvent_7> WorkerRemovalEvent;
+    int workerCalls[2] = { 0, 0 };
+    EventSubscription workerSubscription;
+    workerSubscription = listener.OnEvent<WorkerRemovalEvent>([&](const WorkerRemovalEvent& ){
+        workerCalls[0]++;
+        bool bRemovedSelf = listener.Remove(workerSubscription);
+        CHECK(bRemovedSelf);
+    }, workerContext);
+    listener.OnEvent<WorkerRemovalEvent>([&](const WorkerRemovalEvent& ){
+        workerCalls[1]++;
+    }, workerContext);
+
+    for (int i = 0; i < 2; i++)
+    {
+        DECLARE_EVENT(eTestEvent_7, WorkerRemoval_Ev, i);
+        EMITTER_EVENT_TO(WorkerRemoval_Ev, eEventChannel_Immediate, 0);
+    }
+    std::thread removalWorker([&](){
+        pEventSystem->ProcessEvents(workerContext);
+    });
+    removalWorker.join();
+    CHECK(workerCalls[0] == 1 && workerCalls[1] == 2);
+    bRemoved = pEventSystem->RemoveListener(workerSubscription);
+    CHECK(!bRemoved);
+
+    // Types past the queue table are refused, not written past its end.
+    RegisterCountEvents(std::make_integer_sequence<uint32_t, IEventSystem::MAX_EVENT_TYPES>());
+    typedef Event<int, ECountEvent, (ECountEvent)IEventSystem::MAX_EVENT_TYPES> OverflowEvent;
+    CHECK(OverflowEvent::GetID() >= IEventSystem::MAX_EVENT_TYPES);
+    bool bQueued = pEventSystem->QueueEvent(OverflowEvent(0));
+    CHECK(!bQueued);
+    auto overflowSubscription = listener.OnEvent<OverflowEvent>([](const OverflowEvent&){});
+    CHECK(overflowSubscription == INVALID_SUBSCRIPTION);
+    CHECK(pEventSystem->GetEventStats<OverflowEvent>().pushedCount == 0);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameStats.h"
+#include "TestCheck.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::nano> ns;
+
+int main()
+{
+    FrameStats stats;
+
+    auto updatePhase = stats.RegisterPhase("Update");
+    auto renderPhase = stats.RegisterPhase("Render");
+    CHECK(updatePhase == 0 && renderPhase == 1);
+    CHECK(stats.RegisterPhase("Update") == updatePhase);
+    CHECK(stats.GetPhaseCount() == 2);
+
+    // 1..100 ms, shuffled so the summary can't rely on the order frames arrive in.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        auto frameTime = (float)((i * 37) % 100 + 1);
+        stats.AddPhaseTime(updatePhase, std::chrono::milliseconds(1));
+        stats.EndFrame(frameTime);
+    }
+
+    auto summary = stats.GetFrameSummary();
+    CHECK(summary.count == 100);
+    CHECK(summary.average == 50.5f);
+    CHECK(summary.p50 == 50.0f);
+    CHECK(summary.p95 == 95.0f);
+    CHECK(summary.p99 == 99.0f);
+    CHECK(summary.max == 100.0f);
+
+    auto updateSummary = stats.GetPhaseSummary(updatePhase);
+    CHECK(updateSummary.p50 == 1.0f && updateSummary.max == 1.0f);
+    CHECK(stats.GetPhaseSummary(renderPhase).max == 0.0f);
+    CHECK(stats.GetPhaseSummary(FrameStats::INVALID_PHASE).count == 0);
+
+    // Every frame from 50 ms up lands in the last bucket.
+    auto pHistogram = stats.GetHistogram();
+    CHECK(pHistogram[2] == 1 && pHistogram[3] == 0 && pHistogram[4] == 1);
+    CHECK(pHistogram[FrameStats::BUCKET_COUNT - 1] == 51);
+
+    uint64_t bucketTotal = 0;
+    for (uint32_t i = 0; i < FrameStats::BUCKET_COUNT; i++)
+        bucketTotal += pHistogram[i];
+    CHECK(bucketTotal == stats.GetFrameCount());
+
+    // The window keeps the last WINDOW_SIZE frames, the histogram keeps them all.
+    for (uint32_t i = 0; i < FrameStats::WINDOW_SIZE; i++)
+        stats.EndFrame(2.0f);
+    summary = stats.GetFrameSummary();
+    CHECK(summary.count == FrameStats::WINDOW_SIZE);
+    CHECK(summary.p99 == 2.0f && summary.max == 2.0f);
+    CHECK(pHistogram[4] == FrameStats::WINDOW_SIZE + 1);
+
+    std::ostringstream csv;
+    stats.WriteCSV(csv);
+    auto text = csv.str();
+    CHECK(text.find("frame,frame time,Update,Render\n") == 0);
+    CHECK(text.find("\n100,2,0,0\n") != std::string::npos);
+    CHECK(text.find("\n99,") == std::string::npos);
+
+    // Phases are summed from any thread into the frame in progress.
+    const uint32_t threadCount = 4;
+    const uint32_t scopeCount = 1000;
+
+    stats.Reset();
+    auto jobPhase = stats.RegisterPhase("Job");
+
+    std::vector<std::thread> threads;
+    auto beginTime = Clock::now();
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&stats, jobPhase, scopeCount] {
+            for (uint32_t i = 0; i < scopeCount; i++)
+            {
+                FrameStats::ScopedPhase phase(&stats, jobPhase);
+                stats.AddPhaseTime(FrameStats::INVALID_PHASE, std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+    ns scopeTime = Clock::now() - beginTime;
+
+    stats.EndFrame(1.0f);
+    CHECK(stats.GetFrameCount() == 1);
+    CHECK(stats.GetPhaseSummary(jobPhase).max > 0.0f);
+    CHECK(stats.GetPhaseSummary(jobPhase).max <= (float)(scopeTime.count() * threadCount / 1000000.0));
+
+    // A null FrameStats costs nothing but the branch.
+    {
+        FrameStats::ScopedPhase phase(nullptr, jobPhase);
+    }
+
+    beginTime = Clock::now();
+    for (uint32_t i = 0; i < 1000000; i++)
+    {
+        FrameStats::ScopedPhase phase(&stats, jobPhase);
+    }
+    ns phaseTime = Clock::now() - beginTime;
+
+    std::cout << "ScopedPhase: " << phaseTime.count() / 1000000 << " ns" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
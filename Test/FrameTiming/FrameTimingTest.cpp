@@ -0,0 +1,102 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "FixedTimestep.h"
+#include "FramePacer.h"
+#include "TestCheck.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<float, std::milli> ms;
+
+static void TestFixedTimestep()
+{
+    FixedTimestep timestep;
+    CHECK(timestep.GetStep() == FixedTimestep::DEFAULT_STEP);
+    CHECK(timestep.GetMaxSteps() == FixedTimestep::DEFAULT_MAX_STEPS);
+    CHECK(timestep.GetAlpha() == 0.0f);
+
+    // The remainder carries over and blends as a fraction of a step.
+    timestep.SetStep(10.0f);
+    CHECK(timestep.Advance(25.0f) == 2);
+    CHECK(timestep.GetAlpha() == 0.5f);
+    CHECK(timestep.Advance(4.0f) == 0);
+    CHECK(timestep.GetAlpha() == 0.9f);
+    CHECK(timestep.Advance(1.0f) == 1);
+    CHECK(timestep.GetAlpha() == 0.0f);
+    CHECK(timestep.GetStepCount() == 3);
+    CHECK(timestep.GetDroppedCount() == 0);
+
+    // A long frame runs at most maxSteps, the rest is dropped rather than owed.
+    timestep.SetMaxSteps(3);
+    CHECK(timestep.Advance(100.0f) == 3);
+    CHECK(timestep.GetDroppedCount() == 7);
+    CHECK(timestep.GetAlpha() == 0.0f);
+    CHECK(timestep.Advance(35.0f) == 3);
+    CHECK(timestep.GetAlpha() == 0.5f);
+    CHECK(timestep.GetStepCount() == 9);
+    CHECK(timestep.GetDroppedCount() == 7);
+
+    timestep.Reset();
+    CHECK(timestep.GetStepCount() == 0 && timestep.GetDroppedCount() == 0 && timestep.GetAlpha() == 0.0f);
+
+    // Frames shorter than a step add up without losing time.
+    timestep.SetStep(8.0f);
+    uint32_t stepCount = 0;
+    for (int i = 0; i < 64; i++)
+        stepCount += timestep.Advance(0.5f);
+    CHECK(stepCount == 4 && timestep.GetAlpha() == 0.0f);
+}
+
+static void TestFramePacer()
+{
+    const uint32_t frameRate = 100;
+    const float frameTime = 1000.0f / frameRate;
+    const float tolerance = 0.1f;
+
+    // Unpaced frames return the wall time between them, the first one has nothing to measure.
+    FramePacer unpaced;
+    CHECK(unpaced.BeginFrame() == 0.0f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(unpaced.BeginFrame() >= 5.0f - tolerance);
+
+    for (auto pacing : { ePacing_Yield, ePacing_Sleep })
+    {
+        FramePacer pacer;
+        pacer.SetTargetFrameRate(frameRate);
+        pacer.SetPacing(pacing);
+        CHECK(pacer.BeginFrame() == 0.0f);
+
+        // Frames keep to a fixed schedule, one that overshot is followed by a shorter one.
+        auto beginTime = Clock::now();
+        const int frameCount = 10;
+        float totalTime = 0.0f;
+        for (int i = 0; i < frameCount; i++)
+            totalTime += pacer.BeginFrame();
+        ms pacedTime = Clock::now() - beginTime;
+        CHECK(totalTime >= frameCount * frameTime - tolerance);
+
+        // A missed frame starts a new schedule, the next one still waits a whole frame.
+        std::this_thread::sleep_for(std::chrono::milliseconds(35));
+        CHECK(pacer.BeginFrame() >= 35.0f - tolerance);
+        CHECK(pacer.BeginFrame() >= frameTime - tolerance);
+
+        std::cout << (pacing == ePacing_Yield ? "Yield" : "Sleep") << ": " << frameCount << " frames at "
+                  << frameRate << " fps in " << pacedTime.count() << " ms" << std::endl;
+    }
+
+    // A target of 0 turns pacing off.
+    FramePacer unlimited;
+    unlimited.SetTargetFrameRate(0);
+    unlimited.SetPacing(ePacing_Sleep);
+    unlimited.BeginFrame();
+    CHECK(unlimited.BeginFrame() < frameTime);
+}
+
+int main()
+{
+    TestFixedTimestep();
+    TestFramePacer();
+
+    return 0;
+}
\ No newline at end of file
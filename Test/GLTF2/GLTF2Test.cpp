@@ -1,7 +1,94 @@
+#define PREDEFINE_SETUP
+
+#include <map>
+
 #include <glTF2.hpp>
 
+#include "Setup.h"
+#include "GLTF2Loader.h"
+#include "TransformComponent.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+static gltf2::Node CreateNode(float x, std::vector<int> children)
+{
+    gltf2::Node node;
+    node.translation[0] = x;
+    node.children = children;
+    return node;
+}
+
+// Entities keyed by their x translation, which is unique per node in the test assets.
+static std::map<float, const TransformComponent*> GetTransforms(std::shared_ptr<IECSWorld> pWorld)
+{
+    std::map<float, const TransformComponent*> transforms;
+    pWorld->Query<const TransformComponent>().ForEach([&](const TransformComponent& transform) {
+        transforms[transform.GetPosition().x] = &transform;
+    });
+    return transforms;
+}
+
 int main()
 {
     gltf2::Asset asset = gltf2::load("Test/TriangleWithoutIndices.gltf");
+
+    if (gpGlobal == nullptr)
+        gpGlobal = new Global();
+
+    gpGlobal->RegisterApp<BaseApplication>();
+    auto pWorld = gpGlobal->GetECSWorld();
+
+    // 1 -> 10 -> 100 and 1 -> 20 -> 200, the last one given as a matrix. 300 is outside
+    // the scene.
+    gltf2::Asset graph;
+    graph.nodes.push_back(CreateNode(1, { 1, 2 }));
+    graph.nodes.push_back(CreateNode(10, { 3 }));
+    graph.nodes.push_back(CreateNode(20, { 4 }));
+    graph.nodes.push_back(CreateNode(100, {}));
+    graph.nodes.push_back(CreateNode(0, {}));
+    graph.nodes.push_back(CreateNode(300, {}));
+
+    float matrix[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 200, 0, 0, 1 };
+    memcpy(graph.nodes[4].matrix, matrix, sizeof(matrix));
+
+    gltf2::Scene scene;
+    scene.nodes = { 0 };
+    graph.scenes.push_back(scene);
+    graph.scene = 0;
+
+    GLTF2Loader loader;
+    loader.Load(graph);
+    loader.ApplyToWorld();
+
+    auto transforms = GetTransforms(pWorld);
+    CHECK(transforms.size() == 5 && transforms.count(300) == 0);
+    CHECK(!transforms[1]->GetParent().IsValid());
+    CHECK(transforms[10]->GetParent() == transforms[1]->m_entity);
+    CHECK(transforms[20]->GetParent() == transforms[1]->m_entity);
+    CHECK(transforms[100]->GetParent() == transforms[10]->m_entity);
+    CHECK(transforms[200]->GetParent() == transforms[20]->m_entity);
+
+    auto scale = transforms[200]->GetScale();
+    CHECK(scale.x == 2 && scale.y == 2 && scale.z == 2);
+    CHECK(transforms[200]->GetQuaternion() == quat::Identity());
+
+    // Without scenes every node that is nobody's child is a root.
+    for (auto& node : graph.nodes)
+        node.translation[0] += 1000;
+    memcpy(graph.nodes[4].matrix, matrix, sizeof(matrix));
+    graph.nodes[4].matrix[12] += 1000;
+    graph.scenes.clear();
+    graph.scene = -1;
+
+    loader.Load(graph);
+    loader.ApplyToWorld();
+
+    transforms = GetTransforms(pWorld);
+    CHECK(transforms.size() == 11);
+    CHECK(!transforms[1001]->GetParent().IsValid() && !transforms[1300]->GetParent().IsValid());
+    CHECK(transforms[1100]->GetParent() == transforms[1010]->m_entity);
+    CHECK(transforms[1200]->GetParent() == transforms[1020]->m_entity);
+
     return 0;
 }
\ No newline at end of file
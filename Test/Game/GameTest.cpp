@@ -18,7 +18,7 @@ public:
         gpGlobal->GetConfiguration<GraphicsConfiguration>().SetDeviceType(eDevice_D3D11);
         gpGlobal->GetConfiguration<GraphicsConfiguration>().SetMSAA(eMSAA_4);
 
-        auto& pWorld = gpGlobal->GetECSWorld();
+        auto pWorld = gpGlobal->GetECSWorld();
 
         // Camera
         TransformComponent cameraTransformComp;
@@ -26,7 +26,7 @@ public:
         cameraTransformComp.SetPosition(float3(3.0f, 0.0f, 3.0f));
         cameraTransformComp.SetRotate(float3(0.0f, 135.0f, 0.0f));
         cameraComp.SetBackground(float4(33.f / 255.f, 40.f / 255.f, 48.f / 255.f, 1.0f));
-        auto pCamera = pWorld->CreateEntity<TransformComponent, CameraComponent>(cameraTransformComp, cameraComp);
+        auto camera = pWorld->CreateEntity<TransformComponent, CameraComponent>(cameraTransformComp, cameraComp);
 
         // Directional Light
         TransformComponent lightTransformComp;
@@ -35,18 +35,18 @@ public:
         lightTransformComp.SetRotate(float3(0.0f, -135.0f, -45.0f));
         auto pDirectionalLight = std::make_shared<DirectionalLight>();
         lightComp.SetLight(pDirectionalLight);
-        auto pLight = pWorld->CreateEntity<TransformComponent, LightComponent, AnimationComponent>(lightTransformComp, lightComp, lightAnimationComp);
-        AnimationFunc func2 = [pLight](float elapsedTime) -> void
+        auto light = pWorld->CreateEntity<TransformComponent, LightComponent, AnimationComponent>(lightTransformComp, lightComp, lightAnimationComp);
+        AnimationFunc func2 = [pWorld, light](float elapsedTime) -> void
         {
             float second = elapsedTime / 1000;
 
-            auto pTrans = pLight->GetComponent<TransformComponent>();
+            auto pTrans = pWorld->GetComponent<TransformComponent>(light);
             auto rotate = pTrans->GetRotate();
             rotate.y -= second * 45.f;
             rotate.z = (std::abs(std::sinf(rotate.y*PI_F/180.f * 0.3f)) + 0.15f) * -60.0f;
             pTrans->SetRotate(rotate);
         };
-        pLight->GetComponent<AnimationComponent>()->SetAnimationFunc(func2);
+        pWorld->GetComponent<AnimationComponent>(light)->SetAnimationFunc(func2);
 
         GLTF2Loader loader;
         loader.Load("Asset/Scene/Test/DamagedHelmet/DamagedHelmet.gltf");
@@ -59,7 +59,7 @@ public:
         planeTransformComp.SetPosition(float3(0.0f, -0.5f, 0.0f));
         auto pPlaneMesh = std::make_shared<PlaneMesh>();
         planeMeshFilterComp.SetMesh(pPlaneMesh);
-        auto pPlane = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(planeTransformComp, planeMeshFilterComp, planeMeshRendererComp);
+        auto plane = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(planeTransformComp, planeMeshFilterComp, planeMeshRendererComp);
 
         // Entity 1
         TransformComponent cubeTransformComp1;
@@ -70,17 +70,17 @@ public:
         cubeTransformComp1.SetRotate(float3(0.0f, 0.0f, 30.0f));
         auto pMesh = std::make_shared<CubeMesh>();
         cubeMeshFilterComp1.SetMesh(pMesh);
-        auto pCube1 = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent, AnimationComponent>(cubeTransformComp1, cubeMeshFilterComp1, cubeMeshRendererComp1, cubeAnimationComp1);
-        AnimationFunc func = [pCube1](float elapsedTime) -> void
+        auto cube1 = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent, AnimationComponent>(cubeTransformComp1, cubeMeshFilterComp1, cubeMeshRendererComp1, cubeAnimationComp1);
+        AnimationFunc func = [pWorld, cube1](float elapsedTime) -> void
         {
             float second = elapsedTime / 1000;
 
-            auto pTrans = pCube1->GetComponent<TransformComponent>();
+            auto pTrans = pWorld->GetComponent<TransformComponent>(cube1);
             auto rotate = pTrans->GetRotate();
             rotate.y += second * 45.f;
             pTrans->SetRotate(rotate);
         };
-        pCube1->GetComponent<AnimationComponent>()->SetAnimationFunc(func);
+        pWorld->GetComponent<AnimationComponent>(cube1)->SetAnimationFunc(func);
 
         // Entity 2
         TransformComponent cubeTransformComp2;
@@ -92,7 +92,7 @@ public:
         cubeTransformComp2.SetScale(float3(2.0f, 4.0f, 2.0f));
         auto pCubeMesh2 = std::make_shared<CubeMesh>();
         cubeMeshFilterComp2.SetMesh(pCubeMesh2);
-        auto pCube2 = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(cubeTransformComp2, cubeMeshFilterComp2, cubeMeshRendererComp2);*/
+        auto cube2 = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent>(cubeTransformComp2, cubeMeshFilterComp2, cubeMeshRendererComp2);*/
     }
 };
 
@@ -0,0 +1,49 @@
+#define PREDEFINE_SETUP
+#define PREDEFINE_HEADLESS_APP
+
+#include "Setup.h"
+
+// A grid of spinning cubes, simulated for a fixed number of frames without a window.
+// The frame statistics printed on exit are the CPU cost of everything but drawing.
+class HeadlessSetup : public Setup
+{
+public:
+    HeadlessSetup()
+    {
+        gpGlobal->GetConfiguration<AppConfiguration>().SetAppName("Headless Test");
+        gpGlobal->GetConfiguration<HeadlessConfiguration>().SetFrameCount(1000);
+        gpGlobal->GetConfiguration<HeadlessConfiguration>().SetInputEventsPerFrame(16);
+
+        auto pWorld = gpGlobal->GetECSWorld();
+
+        const int gridSize = 32;
+        auto pMesh = std::make_shared<CubeMesh>();
+
+        for (int x = 0; x < gridSize; x++)
+        {
+            for (int z = 0; z < gridSize; z++)
+            {
+                TransformComponent transformComp;
+                MeshFilterComponent meshFilterComp;
+                MeshRendererComponent meshRendererComp;
+                AnimationComponent animationComp;
+                transformComp.SetPosition(float3((float)x * 2.0f, 0.0f, (float)z * 2.0f));
+                meshFilterComp.SetMesh(pMesh);
+
+                auto cube = pWorld->CreateEntity<TransformComponent, MeshFilterComponent, MeshRendererComponent, AnimationComponent>(transformComp, meshFilterComp, meshRendererComp, animationComp);
+                AnimationFunc func = [pWorld, cube](float elapsedTime) -> void
+                {
+                    float second = elapsedTime / 1000;
+
+                    auto pTrans = pWorld->GetComponent<TransformComponent>(cube);
+                    auto rotate = pTrans->GetRotate();
+                    rotate.y += second * 45.f;
+                    pTrans->SetRotate(rotate);
+                };
+                pWorld->GetComponent<AnimationComponent>(cube)->SetAnimationFunc(func);
+            }
+        }
+    }
+};
+
+static HeadlessSetup setup;
\ No newline at end of file
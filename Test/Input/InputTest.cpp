@@ -0,0 +1,143 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+#include "InputRecorder.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+static const char* RECORDING_PATH = "InputTest.rec";
+static const char* TRUNCATED_PATH = "InputTest.truncated.rec";
+
+static bool SameRecord(const InputRecord& a, const InputRecord& b)
+{
+    return a.event == b.event && a.msg.CtrID() == b.msg.CtrID() && a.msg.Param1() == b.msg.Param1() && a.msg.Param2() == b.msg.Param2();
+}
+
+static std::vector<char> ReadFile(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const char* path, const std::vector<char>& data, size_t size)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), size);
+}
+
+static void TestRoundTrip(const std::vector<float>& frameTimes, const std::vector<std::vector<InputRecord>>& frames)
+{
+    InputReplayer replayer;
+    bool bOpened = replayer.Open(RECORDING_PATH);
+    CHECK(bOpened);
+
+    float elapsedTime;
+    std::vector<InputRecord> records;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        bool bRead = replayer.ReadFrame(elapsedTime, records);
+        CHECK(bRead);
+        CHECK(elapsedTime == frameTimes[i]);
+        CHECK(records.size() == frames[i].size());
+        for (size_t j = 0; j < records.size(); j++)
+            CHECK(SameRecord(records[j], frames[i][j]));
+    }
+
+    bool bRead = replayer.ReadFrame(elapsedTime, records);
+    CHECK(!bRead && records.empty());
+    CHECK(replayer.GetFrameCount() == frames.size());
+}
+
+static void TestTruncated(const std::vector<std::vector<InputRecord>>& frames)
+{
+    const size_t headerSize = 2 * sizeof(uint32_t);
+    const size_t frameHeaderSize = sizeof(float) + sizeof(uint32_t);
+    const size_t lastFrameSize = frameHeaderSize + frames.back().size() * InputRecorder::RECORD_SIZE;
+
+    // The header and every frame, the cuts below must land inside the last one.
+    auto data = ReadFile(RECORDING_PATH);
+    CHECK(data.size() > headerSize + lastFrameSize);
+
+    // A partial header is not a recording.
+    InputReplayer replayer;
+    WriteFile(TRUNCATED_PATH, data, headerSize - 1);
+    bool bOpened = replayer.Open(TRUNCATED_PATH);
+    CHECK(!bOpened && !replayer.IsOpen());
+
+    auto badMagic = data;
+    badMagic[0] ^= 0xff;
+    WriteFile(TRUNCATED_PATH, badMagic, badMagic.size());
+    bOpened = replayer.Open(TRUNCATED_PATH);
+    CHECK(!bOpened);
+
+    // Cut inside the frame header and inside the records, either way the last frame is dropped.
+    for (size_t cut : { lastFrameSize - 1, lastFrameSize - frameHeaderSize - 1 })
+    {
+        WriteFile(TRUNCATED_PATH, data, data.size() - cut);
+        bOpened = replayer.Open(TRUNCATED_PATH);
+        CHECK(bOpened);
+
+        float elapsedTime;
+        std::vector<InputRecord> records;
+        while (replayer.ReadFrame(elapsedTime, records))
+            ;
+        CHECK(replayer.GetFrameCount() == frames.size() - 1 && records.empty());
+        replayer.Close();
+    }
+}
+
+static void TestWriteFailure()
+{
+#if defined(__linux__)
+    // Every write to /dev/full fails, the recorder must notice instead of dropping frames silently.
+    InputRecorder recorder;
+    bool bOpened = recorder.Open("/dev/full");
+    CHECK(!bOpened && !recorder.IsOpen());
+    bool bWritten = recorder.EndFrame(16.0f);
+    CHECK(!bWritten);
+    CHECK(recorder.GetFrameCount() == 0);
+#endif
+}
+
+int main()
+{
+    std::vector<float> frameTimes = { 16.5f, 0.0f, 33.25f, 8.0f };
+    std::vector<std::vector<InputRecord>> frames = {
+        { { eEv_Input_KeyDown, InputMsg(65, 1, 0) }, { eEv_Input_KeyUp, InputMsg(65, 0, 0) } },
+        {},
+        { { eEv_Input_ControlMove, InputMsg(7, -1234567890123LL, 9876543210LL) } },
+        { { eEv_Input_ControlWheel, InputMsg(0xffffffff, INT64_MIN, INT64_MAX) }, { eEv_Input_KeyChar, InputMsg(97) },
+          { eEv_Input_ControlHover, InputMsg(3, 40, 50) } },
+    };
+
+    InputRecorder recorder;
+    bool bOpened = recorder.Open(RECORDING_PATH);
+    CHECK(bOpened && recorder.IsOpen());
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        for (auto& record : frames[i])
+            recorder.RecordInput(record.event, record.msg);
+        bool bWritten = recorder.EndFrame(frameTimes[i]);
+        CHECK(bWritten);
+    }
+    CHECK(recorder.GetFrameCount() == frames.size());
+    recorder.Close();
+    bool bWritten = recorder.EndFrame(1.0f);
+    CHECK(!recorder.IsOpen() && !bWritten);
+
+    TestRoundTrip(frameTimes, frames);
+    TestTruncated(frames);
+    TestWriteFailure();
+
+    remove(RECORDING_PATH);
+    remove(TRUNCATED_PATH);
+
+    std::cout << "Recorded and replayed " << frames.size() << " frames" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "JobSystem.h"
+#include "TestCheck.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+struct NestedJob
+{
+    JobSystem* pJobSystem;
+    std::atomic<uint32_t> childCount;
+    uint32_t finishedChildCount;
+};
+
+double EmptyJobs(JobSystem& jobSystem, uint32_t count)
+{
+    auto begin = Clock::now();
+
+    JobCounter counter;
+    for (uint32_t i = 0; i < count; i++)
+        jobSystem.Run([](void*) {}, nullptr, &counter);
+    jobSystem.Wait(&counter);
+
+    return ms(Clock::now() - begin).count();
+}
+
+double FineGrainedFor(JobSystem& jobSystem, std::vector<float>& data)
+{
+    auto begin = Clock::now();
+
+    jobSystem.ParallelFor(0, (uint32_t)data.size(), [&](uint32_t i) {
+        data[i] = std::sqrt(data[i] * 0.5f + 1.0f);
+    }, 256);
+
+    return ms(Clock::now() - begin).count();
+}
+
+void TestCounter(JobSystem& jobSystem)
+{
+    JobCounter counter;
+    CHECK(counter.IsDone());
+    jobSystem.Wait(&counter);
+
+    // Wait returns only after the slowest job, whichever thread ran it.
+    std::atomic<uint32_t> runCount(0);
+    jobSystem.Run([](void* pData) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        static_cast<std::atomic<uint32_t>*>(pData)->fetch_add(1);
+    }, &runCount, &counter);
+    for (uint32_t i = 0; i < 1000; i++)
+        jobSystem.Run([](void* pData) { static_cast<std::atomic<uint32_t>*>(pData)->fetch_add(1); }, &runCount, &counter);
+    jobSystem.Wait(&counter);
+    CHECK(counter.IsDone());
+    CHECK(runCount.load() == 1001);
+
+    auto func = [&runCount] { runCount.fetch_add(1); };
+    jobSystem.Run(func, &counter);
+    jobSystem.Wait(&counter);
+    CHECK(runCount.load() == 1002);
+}
+
+void TestNestedRun(JobSystem& jobSystem)
+{
+    const uint32_t parentCount = 64;
+    const uint32_t childCount = 64;
+
+    // Each parent spawns its children from whichever worker runs it and waits for them there.
+    std::vector<NestedJob> parents(parentCount);
+    JobCounter counter;
+    for (auto& parent : parents)
+    {
+        parent.pJobSystem = &jobSystem;
+        parent.childCount = 0;
+        parent.finishedChildCount = 0;
+        jobSystem.Run([](void* pData) {
+            auto pParent = static_cast<NestedJob*>(pData);
+            JobCounter childCounter;
+            for (uint32_t i = 0; i < childCount; i++)
+                pParent->pJobSystem->Run([](void* pData) { static_cast<NestedJob*>(pData)->childCount.fetch_add(1); }, pParent, &childCounter);
+            pParent->pJobSystem->Wait(&childCounter);
+            pParent->finishedChildCount = pParent->childCount.load();
+        }, &parent, &counter);
+    }
+    jobSystem.Wait(&counter);
+
+    for (auto& parent : parents)
+        CHECK(parent.finishedChildCount == childCount);
+}
+
+void TestParallelFor(JobSystem& jobSystem)
+{
+    std::vector<uint32_t> hits(100000, 0);
+    jobSystem.ParallelFor(0, (uint32_t)hits.size(), [&](uint32_t i) { hits[i]++; });
+    for (auto hit : hits)
+        CHECK(hit == 1);
+
+    // Slow iterations leave the calling thread no chance to finish alone, the workers must take a share.
+    std::vector<uint32_t> threads(jobSystem.GetThreadCount() * 16, UINT32_MAX);
+    jobSystem.ParallelFor(0, (uint32_t)threads.size(), [&](uint32_t i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        threads[i] = jobSystem.GetThreadIndex();
+    });
+    for (auto thread : threads)
+        CHECK(thread < jobSystem.GetThreadCount());
+    if (jobSystem.GetThreadCount() > 1)
+        CHECK(std::any_of(threads.begin(), threads.end(), [](uint32_t thread) { return thread != 0; }));
+
+    uint32_t calls = 0;
+    jobSystem.ParallelFor(5, 5, [&](uint32_t) { calls++; });
+    CHECK(calls == 0);
+}
+
+int main()
+{
+    const uint32_t jobCount = 1 << 20;
+    const uint32_t elementCount = 1 << 24;
+    const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<float> data(elementCount, 1.0f);
+
+    std::cout << "threads, empty jobs (ms), jobs/ms, parallel for (ms), elements/ms" << std::endl;
+    for (uint32_t threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        JobSystem jobSystem;
+        jobSystem.Initialize(threads - 1);
+
+        auto emptyTime = EmptyJobs(jobSystem, jobCount);
+        auto forTime = FineGrainedFor(jobSystem, data);
+
+        std::cout << threads << ", "
+                  << emptyTime << ", " << jobCount / emptyTime << ", "
+                  << forTime << ", " << elementCount / forTime << std::endl;
+
+        if (threads == maxThreads)
+            break;
+    }
+
+    // Workers even on a single core machine, so stealing and nested waits are exercised.
+    JobSystem jobSystem;
+    jobSystem.Initialize(3);
+
+    TestCounter(jobSystem);
+    TestNestedRun(jobSystem);
+    TestParallelFor(jobSystem);
+
+    return 0;
+}
\ No newline at end of file
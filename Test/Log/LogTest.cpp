@@ -0,0 +1,114 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncLogger.h"
+#include "TestCheck.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::nano> ns;
+
+uint32_t CountLines(const std::string& text, const std::string& pattern)
+{
+    uint32_t count = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        count++;
+    return count;
+}
+
+int main()
+{
+    auto& logger = AsyncLogger::Get();
+
+    // Disabled levels never evaluate their arguments.
+    uint32_t evaluated = 0;
+    LOG_TRACE("never {}", evaluated++);
+    CHECK(evaluated == 0);
+
+    // Without the writer thread records wait in the ring, the overflow is counted.
+    std::ostringstream dropStream;
+    for (uint32_t i = 0; i < AsyncLogger::RING_CAPACITY + 10; i++)
+        LOG_INFO("fill {}", i);
+    CHECK(logger.GetStats().droppedCount == 10);
+
+    logger.Start(dropStream);
+    logger.Flush();
+    auto dropText = dropStream.str();
+    CHECK(CountLines(dropText, "] fill ") == AsyncLogger::RING_CAPACITY);
+    CHECK(dropText.find("[Log] 10 messages dropped") != std::string::npos);
+    CHECK(logger.GetStats().writtenCount == AsyncLogger::RING_CAPACITY);
+
+    std::ostringstream stream;
+    logger.Start(stream);
+
+    LOG_WARNING("mixed {} {} {} {} {}", -3, 7u, 0.5f, "text", std::string("string"));
+    LOG_ERROR("too few {} {}", 1);
+    LOG_INFO("{}", std::string(300, 'x'));
+
+    // Each producer keeps its own order, the writer thread picks the records up in batches.
+    const uint32_t threadCount = 4;
+    const uint32_t messageCount = 500;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([t, messageCount] {
+            for (uint32_t i = 0; i < messageCount; i++)
+            {
+                LOG_INFO("thread {} message {}", t, i);
+                if (i % 100 == 99)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    logger.Stop();
+
+    auto text = stream.str();
+    CHECK(text.find("[Warning] mixed -3 7 0.5 text string\n") != std::string::npos);
+    CHECK(text.find("[Error] too few 1 {}\n") != std::string::npos);
+    CHECK(text.find("] [Info] " + std::string(LogRecord::TEXT_SIZE, 'x') + "\n") != std::string::npos);
+
+    auto stats = logger.GetStats();
+    CHECK(CountLines(text, "] thread ") + stats.droppedCount - 10 == threadCount * messageCount);
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        size_t last = 0;
+        for (uint32_t i = 0; i < messageCount; i++)
+        {
+            auto pos = text.find("thread " + std::to_string(t) + " message " + std::to_string(i) + "\n");
+            if (pos == std::string::npos)
+                continue;
+            CHECK(pos > last);
+            last = pos;
+        }
+    }
+
+    // Cost on the calling thread only, formatting happens later.
+    std::ostringstream benchStream;
+    logger.Start(benchStream);
+
+    const uint32_t benchCount = AsyncLogger::RING_CAPACITY / 2;
+    auto begin = Clock::now();
+    for (uint32_t i = 0; i < benchCount; i++)
+        LOG_INFO("bench {} {}", i, 1.5f);
+    auto logTime = ns(Clock::now() - begin).count() / benchCount;
+
+    logger.Stop();
+
+    std::ostringstream syncStream;
+    begin = Clock::now();
+    for (uint32_t i = 0; i < benchCount; i++)
+        syncStream << "bench " << i << " " << 1.5f << std::endl;
+    auto syncTime = ns(Clock::now() - begin).count() / benchCount;
+
+    std::cout << "async log call (ns), formatted stream write (ns)" << std::endl;
+    std::cout << logTime << ", " << syncTime << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+static bool Near(double a, double b, double tolerance = 1e-4)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+static bool Near(const float4x4& mat, const double4x4& ref, double tolerance = 1e-4)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (!Near(mat[i][j], ref[i][j], tolerance))
+                return false;
+    return true;
+}
+
+static double4x4 ToDouble(const float4x4& mat)
+{
+    double4x4 ret;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            ret[i][j] = mat[i][j];
+    return ret;
+}
+
+// Scale, rotation and translation, the kind of matrix the transform hierarchy multiplies.
+static float4x4 RandomTransform(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+    const float3x3 rotate = Mat::EulerRotateLH(angle(random), angle(random), angle(random));
+    float s = scale(random);
+    return float4x4(rotate[0][0] * s, rotate[0][1] * s, rotate[0][2] * s, 0,
+                    rotate[1][0] * s, rotate[1][1] * s, rotate[1][2] * s, 0,
+                    rotate[2][0] * s, rotate[2][1] * s, rotate[2][2] * s, 0,
+                    position(random), position(random), position(random), 1);
+}
+
+static float4x4 RandomMatrix(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> value(-4.0f, 4.0f);
+    float4x4 ret;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            ret[i][j] = value(random);
+    // Keep it well conditioned.
+    for (int i = 0; i < 4; i++)
+        ret[i][i] += 10.0f;
+    return ret;
+}
+
+int main()
+{
+#if defined(MATH_SIMD)
+    static_assert(alignof(float4) == 16, "float4 must fill one register");
+    std::cout << "SIMD: on" << std::endl;
+#else
+    std::cout << "SIMD: off" << std::endl;
+#endif
+    static_assert(sizeof(float4) == 16, "float4 must stay packed");
+    static_assert(sizeof(float4x4) == 64, "float4x4 must stay packed");
+
+    float4 a(1.0f, 2.0f, 3.0f, 4.0f);
+    float4 b(-2.0f, 0.5f, 4.0f, 8.0f);
+    CHECK(a + b == float4(-1.0f, 2.5f, 7.0f, 12.0f));
+    CHECK(a - b == float4(3.0f, 1.5f, -1.0f, -4.0f));
+    CHECK(a * b == float4(-2.0f, 1.0f, 12.0f, 32.0f));
+    CHECK(a / 2.0f == float4(0.5f, 1.0f, 1.5f, 2.0f));
+    CHECK(2.0f - a == float4(1.0f, 0.0f, -1.0f, -2.0f));
+    CHECK(-a == float4(-1.0f, -2.0f, -3.0f, -4.0f));
+    CHECK(Vec::Dot(a, b) == 43.0f);
+    CHECK(Vec::Cross(float4(1, 0, 0, 5), float4(0, 1, 0, 7)) == float4(0, 0, 1, 0));
+    CHECK(Vec::Cross(a, b) == float4(6.5f, -10.0f, 4.5f, 0.0f));
+
+    float4 c = a;
+    c += 1;
+    CHECK(c == float4(2.0f, 3.0f, 4.0f, 5.0f));
+    c *= b;
+    c -= a;
+    c /= 2;
+    CHECK(c == float4(-2.5f, -0.25f, 6.5f, 18.0f));
+    CHECK(Near(Vec::Length(float4(2.0f, 2.0f, 2.0f, 2.0f)), 4.0));
+
+    double4 d(1.0, 2.0, 3.0, 4.0);
+    d += 1;
+    CHECK(d == double4(2.0, 3.0, 4.0, 5.0));
+
+    // Every float path against the generic templates in double.
+    std::mt19937 random(7);
+    for (int i = 0; i < 10000; i++)
+    {
+        float4x4 mat1 = i % 2 ? RandomTransform(random) : RandomMatrix(random);
+        float4x4 mat2 = RandomTransform(random);
+        double4x4 ref1 = ToDouble(mat1);
+        double4x4 ref2 = ToDouble(mat2);
+
+        CHECK(Near(Mat::Mul(mat1, mat2), Mat::Mul(ref1, ref2)));
+        CHECK(Near(Mat::Transpose(mat1), Mat::Transpose(ref1), 0.0));
+
+        float4x4 inverse = Mat::Inverse(mat1);
+        CHECK(Near(inverse, Mat::Inverse(ref1), 1e-3));
+        CHECK(Near(Mat::Mul(mat1, inverse), double4x4(), 1e-3));
+
+        float4 vec(mat2[3][0], mat2[3][1], mat2[3][2], 1.0f);
+        double4 refVec(vec.x, vec.y, vec.z, vec.w);
+        float4 ret = Mat::Mul(vec, mat1);
+        double4 refRet = Mat::Mul(refVec, ref1);
+        for (int j = 0; j < 4; j++)
+            CHECK(Near(ret[j], refRet[j]));
+
+        float3 point(vec.x, vec.y, vec.z);
+        float3 transformed = Mat::TransformPoint(point, mat1);
+        float3 direction = Mat::TransformVector(point, mat1);
+        for (int j = 0; j < 3; j++)
+        {
+            CHECK(Near(transformed[j], refRet[j]));
+            CHECK(Near(direction[j], refRet[j] - ref1[3][j], 1e-3));
+        }
+    }
+
+    // Chained multiplies, the shape of the world matrix update.
+    const int matrixCount = 100000;
+    const int passCount = 20;
+    std::vector<float4x4> locals(matrixCount);
+    std::vector<float4x4> worlds(matrixCount);
+    for (auto& local : locals)
+        local = RandomTransform(random);
+
+    auto beginTime = Clock::now();
+    for (int pass = 0; pass < passCount; pass++)
+    {
+        worlds[0] = locals[0];
+        for (int i = 1; i < matrixCount; i++)
+            worlds[i] = Mat::Mul(locals[i], worlds[i / 2]);
+    }
+    ms mulTime = Clock::now() - beginTime;
+
+    beginTime = Clock::now();
+    for (int pass = 0; pass < passCount; pass++)
+        for (int i = 0; i < matrixCount; i++)
+            worlds[i] = Mat::Inverse(locals[i]);
+    ms inverseTime = Clock::now() - beginTime;
+
+    float checksum = 0.0f;
+    for (auto& world : worlds)
+        checksum += world[3][3];
+
+    std::cout << "Mul: " << mulTime.count() / passCount << " ms per " << matrixCount << " matrices" << std::endl;
+    std::cout << "Inverse: " << inverseTime.count() / passCount << " ms per " << matrixCount << " matrices" << std::endl;
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "TestCheck.h"
+
+using namespace Engine;
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+static bool Near(float a, float b, float tolerance = 1e-4f)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0f, std::abs(b));
+}
+
+static bool Near(const float3& a, const float3& b)
+{
+    return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+}
+
+static bool Near(const float3x3& a, const float3x3& b)
+{
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            if (!Near(a[i][j], b[i][j]))
+                return false;
+    return true;
+}
+
+static bool Near(const float4x4& a, const float4x4& b)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (!Near(a[i][j], b[i][j]))
+                return false;
+    return true;
+}
+
+// q and -q are the same rotation.
+static bool SameRotation(const quat& a, const quat& b)
+{
+    return Near(std::abs(quat::Dot(a, b)), 1.0f);
+}
+
+static quat RandomRotation(std::mt19937& random)
+{
+    std::normal_distribution<float> value;
+    return quat::Normalize(quat(value(random), value(random), value(random), value(random)));
+}
+
+static float3x3 Mul(const float3x3& mat1, const float3x3& mat2)
+{
+    float3x3 ret;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            ret.mData[i][j] = mat1.mData[i][0] * mat2.mData[0][j] + mat1.mData[i][1] * mat2.mData[1][j] + mat1.mData[i][2] * mat2.mData[2][j];
+    return ret;
+}
+
+// The three multiplies TransformComponent used before ComposeTRS.
+static float4x4 ComposeTRS(const float3& translation, const quat& rotation, const float3& scale)
+{
+    const float3x3 rotate = rotation.ToMatrix();
+    float4x4 scaleMatrix(scale.x, 0, 0, 0,
+                         0, scale.y, 0, 0,
+                         0, 0, scale.z, 0,
+                         0, 0, 0, 1);
+    float4x4 rotateMatrix(rotate[0][0], rotate[0][1], rotate[0][2], 0,
+                          rotate[1][0], rotate[1][1], rotate[1][2], 0,
+                          rotate[2][0], rotate[2][1], rotate[2][2], 0,
+                          0, 0, 0, 1);
+    float4x4 translateMatrix(1, 0, 0, 0,
+                             0, 1, 0, 0,
+                             0, 0, 1, 0,
+                             translation.x, translation.y, translation.z, 1);
+    return Mat::Mul(scaleMatrix, Mat::Mul(rotateMatrix, translateMatrix));
+}
+
+static void TestConversions(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::normal_distribution<float> value;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        float p = angle(random), h = angle(random), b = angle(random);
+        quat euler = quat::EulerAngles(p, h, b);
+        CHECK(Near(quat::Length(euler), 1.0f));
+        CHECK(Near(euler.ToMatrix(), Mat::EulerRotateLH(p, h, b)));
+
+        quat q = RandomRotation(random);
+        CHECK(Near(q.ToMatrix(), Mat::QuatRotateLH(q.x, q.y, q.z, q.w)));
+        CHECK(SameRotation(quat::FromMatrix(q.ToMatrix()), q));
+
+        float4x4 mat = ComposeTRS(float3(0, 0, 0), q, float3(1, 1, 1));
+        CHECK(SameRotation(quat::FromMatrix(mat), q));
+
+        // Pitch stays within [-90, 90], away from straight up or down the angles come back as given.
+        float ep, eh, eb;
+        quat::EulerAngles(p / 2, h, b).ToEulerAngles(ep, eh, eb);
+        if (std::abs(p / 2) < 80.0f)
+            CHECK(Near(ep, p / 2, 1e-2f) && Near(eh, h, 1e-2f) && Near(eb, b, 1e-2f));
+        else
+            CHECK(SameRotation(quat::EulerAngles(ep, eh, eb), quat::EulerAngles(p / 2, h, b)));
+        q.ToEulerAngles(ep, eh, eb);
+        CHECK(SameRotation(quat::EulerAngles(ep, eh, eb), q));
+
+        float3 axis;
+        float degree;
+        q.ToAxisAngle(axis, degree);
+        CHECK(SameRotation(quat::AxisAngle(axis, degree), q));
+
+        float3 vec(value(random), value(random), value(random));
+        CHECK(Near(quat::Rotate(vec, q), Mat::TransformVector(vec, mat)));
+    }
+
+    // The trace branches of FromMatrix, a half turn about each axis.
+    CHECK(SameRotation(quat::FromMatrix(Mat::EulerRotateLH(180.0f, 0.0f, 0.0f)), quat(1, 0, 0, 0)));
+    CHECK(SameRotation(quat::FromMatrix(Mat::EulerRotateLH(0.0f, 180.0f, 0.0f)), quat(0, 1, 0, 0)));
+    CHECK(SameRotation(quat::FromMatrix(Mat::EulerRotateLH(0.0f, 0.0f, 180.0f)), quat(0, 0, 1, 0)));
+
+    // Straight down, heading and bank turn about the same axis.
+    float ep, eh, eb;
+    quat::EulerAngles(90.0f, 30.0f, 20.0f).ToEulerAngles(ep, eh, eb);
+    CHECK(Near(ep, 90.0f, 1e-3f) && eb == 0.0f);
+    CHECK(SameRotation(quat::EulerAngles(ep, eh, eb), quat::EulerAngles(90.0f, 30.0f, 20.0f)));
+
+    float3 axis;
+    float degree;
+    quat::Identity().ToAxisAngle(axis, degree);
+    CHECK(degree == 0.0f);
+    CHECK(quat::AxisAngle(float3(0, 1, 0), 90.0f).ToMatrix().x02 < -0.99f);
+}
+
+static void TestAlgebra(std::mt19937& random)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        quat q1 = RandomRotation(random);
+        quat q2 = RandomRotation(random);
+
+        // q1 first, like the row vector matrices.
+        CHECK(Near((q1 * q2).ToMatrix(), Mul(q1.ToMatrix(), q2.ToMatrix())));
+        CHECK(SameRotation(q1 * quat::Inverse(q1), quat::Identity()));
+        CHECK(SameRotation(quat::Conjugate(q1), quat::Inverse(q1)));
+
+        quat scaled(q1.x * 3, q1.y * 3, q1.z * 3, q1.w * 3);
+        CHECK(SameRotation(scaled * quat::Inverse(scaled), quat::Identity()));
+        CHECK(Near(quat::Length(quat::Normalize(scaled)), 1.0f));
+    }
+}
+
+static void TestInterpolation(std::mt19937& random)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        quat q1 = RandomRotation(random);
+        quat q2 = RandomRotation(random);
+
+        CHECK(SameRotation(quat::Slerp(q1, q2, 0.0f), q1));
+        CHECK(SameRotation(quat::Slerp(q1, q2, 1.0f), q2));
+        CHECK(SameRotation(quat::Nlerp(q1, q2, 0.0f), q1));
+        CHECK(SameRotation(quat::Nlerp(q1, q2, 1.0f), q2));
+
+        // Equal steps along the shorter arc.
+        quat first = quat::Slerp(q1, q2, 0.25f);
+        quat second = quat::Slerp(q1, q2, 0.5f);
+        CHECK(Near(quat::Length(second), 1.0f));
+        CHECK(Near(std::abs(quat::Dot(q1, first)), std::abs(quat::Dot(first, second)), 1e-3f));
+        CHECK(quat::Dot(quat::Slerp(q1, q2, 0.5f), q1) >= -1e-4f);
+
+        quat blended = quat::Nlerp(q1, q2, 0.5f);
+        CHECK(Near(quat::Length(blended), 1.0f));
+        CHECK(SameRotation(blended, second));
+    }
+
+    // Nearly parallel inputs fall back to Nlerp instead of dividing by sin(0).
+    quat q = RandomRotation(random);
+    quat slerp = quat::Slerp(q, q, 0.5f);
+    CHECK(SameRotation(slerp, q) && !std::isnan(slerp.w));
+}
+
+static void TestComposeTRS(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        float3 t(position(random), position(random), position(random));
+        float3 s(scale(random), scale(random), scale(random));
+        quat q = RandomRotation(random);
+        CHECK(Near(Mat::ComposeTRS(t, q, s), ComposeTRS(t, q, s)));
+    }
+}
+
+template<typename Func>
+static double Time(int passCount, Func func)
+{
+    auto beginTime = Clock::now();
+    for (int pass = 0; pass < passCount; pass++)
+        func();
+    ms elapsedTime = Clock::now() - beginTime;
+    return elapsedTime.count() / passCount;
+}
+
+int main()
+{
+    std::mt19937 random(5);
+    TestConversions(random);
+    TestAlgebra(random);
+    TestInterpolation(random);
+    TestComposeTRS(random);
+
+    const size_t count = 100000;
+    const int passCount = 20;
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::vector<float3> translations(count), scales(count);
+    std::vector<quat> rotations(count);
+    std::vector<float4x4> matrices(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        translations[i] = float3(position(random), position(random), position(random));
+        scales[i] = float3(1, 2, 3);
+        rotations[i] = RandomRotation(random);
+    }
+
+    float checksum = 0.0f;
+    double multiplyTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            matrices[i] = ComposeTRS(translations[i], rotations[i], scales[i]);
+    });
+    checksum += matrices[count - 1][0][0];
+    double composeTime = Time(passCount, [&] {
+        for (size_t i = 0; i < count; i++)
+            matrices[i] = Mat::ComposeTRS(translations[i], rotations[i], scales[i]);
+    });
+    checksum += matrices[count - 1][0][0];
+    double slerpTime = Time(passCount, [&] {
+        for (size_t i = 0; i + 1 < count; i++)
+            rotations[i] = quat::Slerp(rotations[i], rotations[i + 1], 0.5f);
+    });
+    checksum += rotations[0].w;
+    double nlerpTime = Time(passCount, [&] {
+        for (size_t i = 0; i + 1 < count; i++)
+            rotations[i] = quat::Nlerp(rotations[i], rotations[i + 1], 0.5f);
+    });
+    checksum += rotations[0].w;
+
+    std::cout << count << " elements, ms per pass" << std::endl;
+    std::cout << "ComposeTRS: three multiplies " << multiplyTime << ", fused " << composeTime << std::endl;
+    std::cout << "Slerp " << slerpTime << ", Nlerp " << nlerpTime << std::endl;
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "TripleBuffer.h"
+#include "TestCheck.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> ms;
+
+struct Frame
+{
+    uint64_t index = 0;
+    std::vector<uint64_t> values;
+};
+
+int main()
+{
+    TripleBuffer<Frame> buffer;
+
+    // Nothing to read before the first publish.
+    CHECK(!buffer.HasPublished());
+    CHECK(!buffer.Acquire());
+
+    buffer.GetBack().index = 1;
+    CHECK(buffer.Publish());
+    CHECK(buffer.HasPublished());
+
+    // A second publish before the reader looks replaces the first.
+    buffer.GetBack().index = 2;
+    CHECK(!buffer.Publish());
+
+    CHECK(buffer.Acquire());
+    CHECK(buffer.GetFront().index == 2);
+    CHECK(!buffer.HasPublished());
+    CHECK(!buffer.Acquire());
+    CHECK(buffer.GetFront().index == 2);
+
+    // The writer never gets the buffer the reader holds.
+    for (uint64_t i = 3; i < 10; i++)
+    {
+        CHECK(&buffer.GetBack() != &buffer.GetFront());
+        buffer.GetBack().index = i;
+        buffer.Publish();
+        if (i % 2 == 0)
+        {
+            buffer.Acquire();
+            CHECK(buffer.GetFront().index == i);
+        }
+    }
+
+    // A writer and a reader running flat out, every value read whole and never older
+    // than the one before it.
+    const uint64_t frameCount = 200000;
+    const uint32_t valueCount = 64;
+
+    TripleBuffer<Frame> frames;
+    std::atomic<bool> bDone(false);
+    uint64_t droppedCount = 0;
+    uint64_t readCount = 0;
+
+    auto beginTime = Clock::now();
+
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= frameCount; i++)
+        {
+            auto& frame = frames.GetBack();
+            frame.index = i;
+            frame.values.assign(valueCount, i);
+            if (!frames.Publish())
+                droppedCount++;
+        }
+        bDone = true;
+    });
+
+    std::thread reader([&] {
+        uint64_t lastIndex = 0;
+        while (!bDone || frames.HasPublished())
+        {
+            if (!frames.Acquire())
+                continue;
+
+            auto& frame = frames.GetFront();
+            CHECK(frame.index > lastIndex);
+            CHECK(frame.values.size() == valueCount);
+            for (auto value : frame.values)
+                CHECK(value == frame.index);
+
+            lastIndex = frame.index;
+            readCount++;
+        }
+        CHECK(lastIndex == frameCount);
+    });
+
+    writer.join();
+    reader.join();
+
+    ms elapsedTime = Clock::now() - beginTime;
+
+    // Each value is either read or replaced, the first publish has nothing to replace.
+    CHECK(readCount + droppedCount == frameCount);
+
+    std::cout << "Published: " << frameCount << " read: " << readCount << " replaced: " << droppedCount << std::endl;
+    std::cout << "Time: " << elapsedTime.count() << " ms" << std::endl;
+
+    return 0;
+}
\ No newline at end of file